@@ -0,0 +1,101 @@
+<#
+.Synopsis
+Run Unreal Engine automation tests in several editor processes at the same time.
+Tests are split into groups by the first two parts of their name, e.g. UXTools.NearPointer,
+found in the test sources. Each group runs in its own editor process, up to -Jobs processes at once.
+Groups that measure timing, listed in -SerialGroups, run one at a time after all other groups have
+finished, so their results are not skewed by other editor processes.
+Every group writes its report and log to its own folder under -OutputDir, and the report is
+converted to JUnit XML with ConvertTestOutputToXML.ps1.
+#>
+param(
+    [Parameter(Mandatory = $true)]
+    [string]$Editor,
+    [Parameter(Mandatory = $true)]
+    [string]$Project,
+    [Parameter(Mandatory = $true)]
+    [string]$TestSourceDir,
+    [Parameter(Mandatory = $true)]
+    [string]$OutputDir,
+    [string]$Prefix = "UXTools",
+    # Each editor process uses several cores, default to half the cores and at most 4 processes
+    [int]$Jobs = [Math]::Min(4, [Math]::Max(1, [Math]::Floor([Environment]::ProcessorCount / 2))),
+    [string[]]$SerialGroups = @("$Prefix.Benchmark", "$Prefix.LoadAllMaps")
+)
+
+# Collect test groups from spec and automation test declarations
+$groups = Get-ChildItem -Path $TestSourceDir -Recurse -Include *.cpp |
+    Select-String -Pattern "(BEGIN_DEFINE_SPEC|IMPLEMENT_\w+_AUTOMATION_TEST)\s*\(\s*\w+\s*,\s*`"($Prefix\.[^.`"]+)" |
+    ForEach-Object { $_.Matches[0].Groups[2].Value } |
+    Sort-Object -Unique
+
+if ($groups.Count -eq 0)
+{
+    Write-Host "No tests found in $TestSourceDir"
+    exit 1
+}
+
+$parallelGroups = @($groups | Where-Object { $SerialGroups -notcontains $_ })
+$serialGroups = @($groups | Where-Object { $SerialGroups -contains $_ })
+
+Write-Host "Running $($parallelGroups.Count) test groups in up to $Jobs processes, then $($serialGroups.Count) timing groups one at a time"
+
+function Start-TestGroup([string]$group)
+{
+    $groupDir = Join-Path $OutputDir $group
+    New-Item -ItemType Directory -Force -Path $groupDir | Out-Null
+
+    $arguments = @(
+        "`"$Project`"",
+        "-NoSound",
+        "-Unattended",
+        "-ExecCmds=`"Automation RunTests $group`"",
+        "-TestExit=`"Automation Test Queue Empty`"",
+        "-ReportOutputPath=`"$groupDir`"",
+        "-abslog=`"$(Join-Path $groupDir 'Editor.log')`""
+    )
+    Write-Host "Starting $group"
+    $process = Start-Process -FilePath $Editor -ArgumentList $arguments -PassThru -NoNewWindow
+    return @{ Group = $group; Process = $process; Dir = $groupDir }
+}
+
+$running = @()
+foreach ($group in $parallelGroups)
+{
+    while (($running | Where-Object { -not $_.Process.HasExited }).Count -ge $Jobs)
+    {
+        Start-Sleep -Seconds 1
+    }
+
+    $running += Start-TestGroup $group
+}
+
+$running | ForEach-Object { $_.Process.WaitForExit() }
+
+foreach ($group in $serialGroups)
+{
+    $run = Start-TestGroup $group
+    $run.Process.WaitForExit()
+    $running += $run
+}
+
+$failed = $false
+foreach ($run in $running)
+{
+    $report = Join-Path $run.Dir "index.json"
+    if (-not (Test-Path $report))
+    {
+        Write-Host "$($run.Group): no test report, exit code $($run.Process.ExitCode)"
+        $failed = $true
+        continue
+    }
+
+    & (Join-Path $PSScriptRoot "ConvertTestOutputToXML.ps1") -Path $report -Output (Join-Path $run.Dir "results.xml")
+    $json = ((Get-Content $report -Encoding UTF8) | ConvertFrom-JSON)
+    Write-Host "$($run.Group): $($json.succeeded) succeeded, $($json.failed) failed, $($json.totalDuration) s"
+}
+
+if ($failed)
+{
+    exit 1
+}
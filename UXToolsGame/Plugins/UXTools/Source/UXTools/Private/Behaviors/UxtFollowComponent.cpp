@@ -2,207 +2,13 @@
 // Licensed under the MIT License.
 
 #include "Behaviors/UxtFollowComponent.h"
+#include "Behaviors/UxtFollowSubsystem.h"
+#include "Utils/UxtMathKernels.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
-#include "Utils/UxtFunctionLibrary.h"
 
 namespace
 {
-	float SimplifyAngle(float Angle)
-	{
-		while (Angle > PI)
-		{
-			Angle -= 2 * PI;
-		}
-
-		while (Angle < -PI)
-		{
-			Angle += 2 * PI;
-		}
-
-		return Angle;
-	}
-
-	float AngleBetweenOnPlane(FVector From, FVector To, FVector Normal)
-	{
-		From.Normalize();
-		To.Normalize();
-		Normal.Normalize();
-
-		FVector Right = FVector::CrossProduct(Normal, From);
-		FVector Forward = FVector::CrossProduct(Right, Normal);
-
-		float Angle = FMath::Atan2(FVector::DotProduct(To, Right), FVector::DotProduct(To, Forward));
-
-		return SimplifyAngle(Angle);
-	}
-
-	float AngleBetweenVectorAndPlane(FVector Vec, FVector Normal)
-	{
-		Vec.Normalize();
-		Normal.Normalize();
-		return (PI / 2) - FMath::Acos(FVector::DotProduct(Vec, Normal));
-	}
-
-	bool AngularClamp(
-		FVector RefPosition,
-		FQuat RefRotation,
-		FVector CurrentPosition,
-		bool bIgnoreVertical,
-		float MaxHorizontalDegrees,
-		float MaxVerticalDegrees,
-		FVector& RefForward)
-	{
-		FVector ToTarget = CurrentPosition - RefPosition;
-		float CurrentDistance = ToTarget.Size();
-		if (CurrentDistance <= 0)
-		{
-			// No need to clamp
-			return false;
-		}
-
-		ToTarget.Normalize();
-
-		// Start off with a rotation towards the target. If it's within leashing bounds, we can leave it alone.
-		FQuat Rotation = ToTarget.ToOrientationQuat();
-
-		// This is the meat of the leashing algorithm. The goal is to ensure that the reference's forward
-		// vector remains within the bounds set by the leashing parameters. To do this, determine the angles
-		// between toTarget and the leashing bounds about the global Z axis and the reference's X axis.
-		// If toTarget falls within the leashing bounds, then we don't have to modify it.
-		// Otherwise, we apply a correction rotation to bring it within bounds.
-
-		FVector CurrentRefForward = RefRotation * FVector::ForwardVector;
-		FVector RefRight = RefRotation * FVector::RightVector;
-
-		bool bAngularClamped = false;
-
-		// X-axis leashing
-		// Leashing around the reference's X axis only makes sense if the reference isn't gravity aligned.
-		if (bIgnoreVertical)
-		{
-			float Angle = AngleBetweenOnPlane(ToTarget, CurrentRefForward, RefRight);
-			Rotation = FQuat(RefRight, Angle) * Rotation;
-		}
-		else
-		{
-			// These are negated because Unreal is left-handed
-			float Angle = -AngleBetweenOnPlane(ToTarget, CurrentRefForward, RefRight);
-			float MinMaxAngle = FMath::DegreesToRadians(MaxVerticalDegrees) * 0.5f;
-
-			if (Angle < -MinMaxAngle)
-			{
-				Rotation = FQuat(RefRight, -MinMaxAngle - Angle) * Rotation;
-				bAngularClamped = true;
-			}
-			else if (Angle > MinMaxAngle)
-			{
-				Rotation = FQuat(RefRight, MinMaxAngle - Angle) * Rotation;
-				bAngularClamped = true;
-			}
-		}
-
-		// Z-axis leashing
-		{
-			float Angle = AngleBetweenVectorAndPlane(ToTarget, RefRight);
-			float MinMaxAngle = FMath::DegreesToRadians(MaxHorizontalDegrees) * 0.5f;
-
-			if (Angle < -MinMaxAngle)
-			{
-				Rotation = FQuat(FVector::UpVector, -MinMaxAngle - Angle) * Rotation;
-				bAngularClamped = true;
-			}
-			else if (Angle > MinMaxAngle)
-			{
-				Rotation = FQuat(FVector::UpVector, MinMaxAngle - Angle) * Rotation;
-				bAngularClamped = true;
-			}
-		}
-
-		RefForward = Rotation * FVector::ForwardVector;
-
-		return bAngularClamped;
-	}
-
-	bool DistanceClamp(
-		float DeltaTime,
-		float MinDistance,
-		float DefaultDistanceIn,
-		float MaxDistance,
-		bool bMaintainPitch,
-		FVector CurrentPosition,
-		FVector RefPosition,
-		FVector RefForward,
-		bool bInterpolateToDefaultDistance,
-		float MoveToDefaultDistanceLerpTime,
-		FVector& ClampedPosition)
-	{
-		float ClampedDistance;
-		float CurrentDistance = FVector::Distance(CurrentPosition, RefPosition);
-		FVector Direction = RefForward;
-
-		if (bMaintainPitch)
-		{
-			// If we don't account for pitch offset, the casted object will float up/down as the reference
-			// gets closer to it because we will still be casting in the direction of the pitched offset.
-			// To fix this, only modify the XZ position of the object.
-
-			FVector DirectionYX = RefForward;
-			DirectionYX.Z = 0;
-			DirectionYX.Normalize();
-
-			FVector RefToElementYX = CurrentPosition - RefPosition;
-			RefToElementYX.Z = 0;
-			float DesiredDistanceYX = RefToElementYX.Size();
-
-			FVector MinDistanceYXVector = RefForward * MinDistance;
-			MinDistanceYXVector.Z = 0;
-			float MinDistanceYX = MinDistanceYXVector.Size();
-
-			FVector MaxDistanceYXVector = RefForward * MaxDistance;
-			MaxDistanceYXVector.Z = 0;
-			float MaxDistanceYX = MaxDistanceYXVector.Size();
-
-			DesiredDistanceYX = FMath::Clamp(DesiredDistanceYX, MinDistanceYX, MaxDistanceYX);
-
-			if (bInterpolateToDefaultDistance)
-			{
-				FVector DefaultDistanceYXVector = Direction * DefaultDistanceIn;
-				DefaultDistanceYXVector.Z = 0;
-				float DefaulltDistanceYX = DefaultDistanceYXVector.Size();
-
-				float interpolationRate = FMath::Min(MoveToDefaultDistanceLerpTime * DeltaTime, 1.0f);
-				DesiredDistanceYX = DesiredDistanceYX + (interpolationRate * (DefaulltDistanceYX - DesiredDistanceYX));
-			}
-
-			FVector DesiredPosition = RefPosition + DirectionYX * DesiredDistanceYX;
-			float DesiredHeight = RefPosition.Z + RefForward.Z * MaxDistance;
-			DesiredPosition.Z = DesiredHeight;
-
-			Direction = DesiredPosition - RefPosition;
-			ClampedDistance = Direction.Size();
-			Direction /= ClampedDistance;
-
-			ClampedDistance = FMath::Max(MinDistance, ClampedDistance);
-		}
-		else
-		{
-			ClampedDistance = CurrentDistance;
-
-			if (bInterpolateToDefaultDistance)
-			{
-				float InterpolationRate = FMath::Min(MoveToDefaultDistanceLerpTime * DeltaTime, 1.0f);
-				ClampedDistance = ClampedDistance + (InterpolationRate * (DefaultDistanceIn - ClampedDistance));
-			}
-
-			ClampedDistance = FMath::Clamp(ClampedDistance, MinDistance, MaxDistance);
-		}
-
-		ClampedPosition = RefPosition + Direction * ClampedDistance;
-
-		return !ClampedPosition.Equals(CurrentPosition, 1.0f);
-	}
-
 	void ComputeOrientation(
 		EUxtFollowOrientBehavior DefaultOrientationType,
 		FVector FollowPosition,
@@ -289,7 +95,7 @@ namespace
 			FVector NodeToCamera = GoalLocation - FollowPosition;
 			NodeToCamera.Normalize();
 
-			float Angle = FMath::Abs(AngleBetweenOnPlane(CamForward, NodeToCamera, FVector::UpVector));
+			float Angle = FMath::Abs(FUxtMathKernels::AngleBetweenOnPlane(CamForward, NodeToCamera, FVector::UpVector));
 
 			if (FMath::RadiansToDegrees(Angle) > OrientToCameraDeadzoneDegrees)
 			{
@@ -303,6 +109,8 @@ namespace
 
 UUxtFollowComponent::UUxtFollowComponent()
 {
+	// Follow components are updated in batches by the follow subsystem. The tick function is never registered,
+	// it only keeps the tick enabled state so that the subsystem skips components with tick disabled.
 	PrimaryComponentTick.bCanEverTick = true;
 }
 
@@ -311,6 +119,11 @@ void UUxtFollowComponent::Recenter()
 	bRecenterNextUpdate = true;
 }
 
+bool UUxtFollowComponent::IsAtRest() const
+{
+	return bAtRest;
+}
+
 void UUxtFollowComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -319,26 +132,42 @@ void UUxtFollowComponent::BeginPlay()
 
 	WorkingPosition = GetOwner()->GetTransform().GetLocation();
 	WorkingRotation = GetOwner()->GetTransform().GetRotation();
+	GoalPosition = WorkingPosition;
+	GoalRotation = WorkingRotation;
+	PreviousRotation = WorkingRotation;
 	PreviousReferencePosition = FVector::ZeroVector;
 
 	bSkipInterpolation = true;
+
+	FollowSubsystem = GetWorld()->GetSubsystem<UUxtFollowSubsystem>();
+	if (FollowSubsystem)
+	{
+		FollowSubsystem->RegisterFollowComponent(this);
+	}
 }
 
-void UUxtFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UUxtFollowComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	FTransform FollowTransform;
-
-	if (ActorToFollow)
+	if (FollowSubsystem)
 	{
-		FollowTransform = ActorToFollow->GetTransform();
+		FollowSubsystem->UnregisterFollowComponent(this);
+		FollowSubsystem = nullptr;
 	}
-	else
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UUxtFollowComponent::RegisterComponentTickFunctions(bool bRegister)
+{
+	// Apply the initial tick state as registering would, without adding the tick function to the level.
+	if (bRegister && !IsTemplate())
 	{
-		FollowTransform = UUxtFunctionLibrary::GetHeadPose(GetWorld());
+		PrimaryComponentTick.SetTickFunctionEnable(PrimaryComponentTick.bStartWithTickEnabled || PrimaryComponentTick.IsTickFunctionEnabled());
 	}
+}
 
+bool UUxtFollowComponent::UpdateGoal(float DeltaTime, const FTransform& FollowTransform)
+{
 	FVector FollowPosition = FollowTransform.GetLocation();
 	FQuat FollowRotation = FollowTransform.GetRotation();
 
@@ -349,8 +178,19 @@ void UUxtFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 		if (FollowPosition.IsZero())
 		{
 			// On the first frame, the camera position is 0, 0, 0, so skip that frame.
-			return;
+			return false;
+		}
+	}
+
+	if (bAtRest)
+	{
+		if (!ShouldWake(FollowTransform))
+		{
+			return false;
 		}
+
+		// The owner is exactly at the goal, so solving from here continues without a jump.
+		bAtRest = false;
 	}
 
 	FVector CurrentReferencePosition = FVector::ZeroVector;
@@ -379,7 +219,7 @@ void UUxtFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 	// Angularly clamp to determine goal direction to place the element
 	else if (!bIgnoreAngleClamp)
 	{
-		bAngularClamped = AngularClamp(
+		bAngularClamped = FUxtMathKernels::AngularClamp(
 			CurrentReferencePosition,
 			CurrentReferenceRotation,
 			CurrentPosition,
@@ -394,7 +234,7 @@ void UUxtFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 	bool bDistanceClamped = false;
 	if (!bIgnoreDistanceClamp)
 	{
-		bDistanceClamped = DistanceClamp(
+		bDistanceClamped = FUxtMathKernels::DistanceClamp(
 			DeltaTime,
 			MinimumDistance,
 			DefaultDistance,
@@ -427,9 +267,13 @@ void UUxtFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 		OrientationBehavior,
 		FollowPosition,
 		NewGoalPosition,
-		PreviousRotation,
+		GoalRotation,
 		NewGoalRotation);
 
+	const bool bGoalSettled =
+		NewGoalPosition.Equals(GoalPosition, RestPositionTolerance) &&
+		NewGoalRotation.AngularDistance(GoalRotation) <= FMath::DegreesToRadians(RestAngleToleranceDegrees);
+
 	PreviousRotation = GoalRotation;
 	GoalPosition = NewGoalPosition;
 	GoalRotation = NewGoalRotation;
@@ -440,6 +284,46 @@ void UUxtFollowComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 
 	UpdateTransformToGoal(DeltaTime);
 	bSkipInterpolation = !bInterpolatePose;
+
+	// Interpolation never reaches the goal exactly, snap to it once close enough and sleep.
+	if (bSleepAtRest && bGoalSettled &&
+		WorkingPosition.Equals(GoalPosition, RestPositionTolerance) &&
+		WorkingRotation.AngularDistance(GoalRotation) <= FMath::DegreesToRadians(RestAngleToleranceDegrees))
+	{
+		WorkingPosition = GoalPosition;
+		WorkingRotation = GoalRotation;
+		RestReferenceTransform = FollowTransform;
+		bAtRest = true;
+	}
+
+	return true;
+}
+
+bool UUxtFollowComponent::ShouldWake(const FTransform& FollowTransform) const
+{
+	if (!bSleepAtRest || bRecenterNextUpdate)
+	{
+		return true;
+	}
+
+	const float AngleTolerance = FMath::DegreesToRadians(RestAngleToleranceDegrees);
+
+	// Reference has moved
+	if (!FollowTransform.GetLocation().Equals(RestReferenceTransform.GetLocation(), RestPositionTolerance) ||
+		FollowTransform.GetRotation().AngularDistance(RestReferenceTransform.GetRotation()) > AngleTolerance)
+	{
+		return true;
+	}
+
+	// Owner has been moved by something else
+	const FTransform& OwnerTransform = GetOwner()->GetTransform();
+	return !OwnerTransform.GetLocation().Equals(WorkingPosition, RestPositionTolerance) ||
+		OwnerTransform.GetRotation().AngularDistance(WorkingRotation) > AngleTolerance;
+}
+
+void UUxtFollowComponent::ApplyWorkingTransform()
+{
+	GetOwner()->SetActorLocationAndRotation(WorkingPosition, WorkingRotation, false);
 }
 
 void UUxtFollowComponent::UpdateTransformToGoal(float DeltaTime)
@@ -456,6 +340,4 @@ void UUxtFollowComponent::UpdateTransformToGoal(float DeltaTime)
 		WorkingPosition = SmoothTo(CurrentPosition, GoalPosition, DeltaTime, .5f);
 		WorkingRotation = SmoothTo(CurrentRotation, GoalRotation, DeltaTime, .5f);
 	}
-
-	GetOwner()->SetActorLocationAndRotation(WorkingPosition, WorkingRotation, false);
 }
\ No newline at end of file
@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Behaviors/UxtFollowSubsystem.h"
+#include "Behaviors/UxtFollowComponent.h"
+#include "Utils/UxtFunctionLibrary.h"
+#include "Utils/UxtStats.h"
+
+#include <Async/ParallelFor.h>
+#include <Engine/Level.h>
+#include <Engine/World.h>
+#include <GameFramework/Actor.h>
+
+namespace
+{
+	/** Below this number of components the solver runs on the game thread, task overhead would outweigh the gain. */
+	const int32 MinParallelFollowComponents = 16;
+}
+
+void FUxtFollowTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && !Target->IsPendingKill())
+	{
+		Target->UpdateFollowComponents(DeltaTime);
+	}
+}
+
+FString FUxtFollowTickFunction::DiagnosticMessage()
+{
+	return TEXT("UUxtFollowSubsystem::UpdateFollowComponents");
+}
+
+void UUxtFollowSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	FollowComponents.Empty();
+	References.Empty();
+
+	Super::Deinitialize();
+}
+
+void UUxtFollowSubsystem::RegisterFollowComponent(UUxtFollowComponent* Follow)
+{
+	check(Follow);
+
+	// Follow components tick in the same group they used to tick in individually.
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Target = this;
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = false;
+		TickFunction.TickGroup = ETickingGroup::TG_DuringPhysics;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	FollowComponents.AddUnique(Follow);
+	UpdateTickEnabled();
+}
+
+void UUxtFollowSubsystem::UnregisterFollowComponent(UUxtFollowComponent* Follow)
+{
+	FollowComponents.RemoveSingleSwap(Follow);
+	UpdateTickEnabled();
+}
+
+void UUxtFollowSubsystem::UpdateFollowComponents(float DeltaTime)
+{
+	UXT_SCOPE_CYCLE_COUNTER(FollowSolve);
+
+	const int32 NumFollowComponents = FollowComponents.Num();
+
+	// Gather reference transforms once per followed actor. Components with tick disabled are skipped as if they ticked on their own.
+	References.Reset();
+	ReferenceIndices.SetNumUninitialized(NumFollowComponents, false);
+	for (int32 Index = 0; Index < NumFollowComponents; ++Index)
+	{
+		const UUxtFollowComponent* Follow = FollowComponents[Index];
+		ReferenceIndices[Index] = (Follow->IsActive() && Follow->IsComponentTickEnabled()) ? FindOrAddReference(Follow->ActorToFollow) : INDEX_NONE;
+	}
+
+	// Solve all components, this only touches the state of each component.
+	Moved.SetNumZeroed(NumFollowComponents, false);
+	ParallelFor(NumFollowComponents, [this, DeltaTime](int32 Index)
+		{
+			const int32 ReferenceIndex = ReferenceIndices[Index];
+			Moved[Index] = ReferenceIndex != INDEX_NONE && FollowComponents[Index]->UpdateGoal(DeltaTime, References[ReferenceIndex].Transform);
+		},
+		NumFollowComponents < MinParallelFollowComponents);
+
+	// Move owners on the game thread.
+	for (int32 Index = 0; Index < NumFollowComponents; ++Index)
+	{
+		if (Moved[Index])
+		{
+			FollowComponents[Index]->ApplyWorkingTransform();
+		}
+	}
+}
+
+int32 UUxtFollowSubsystem::FindOrAddReference(const AActor* Actor)
+{
+	for (int32 Index = 0; Index < References.Num(); ++Index)
+	{
+		if (References[Index].Actor == Actor)
+		{
+			return Index;
+		}
+	}
+
+	const FTransform Transform = Actor ? Actor->GetTransform() : UUxtFunctionLibrary::GetHeadPose(GetWorld());
+	return References.Add({ Actor, Transform });
+}
+
+void UUxtFollowSubsystem::UpdateTickEnabled()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.SetTickFunctionEnable(FollowComponents.Num() > 0);
+	}
+}
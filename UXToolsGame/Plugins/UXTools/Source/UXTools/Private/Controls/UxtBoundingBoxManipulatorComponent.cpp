@@ -2,11 +2,18 @@
 // Licensed under the MIT License.
 
 #include "Controls/UxtBoundingBoxManipulatorComponent.h"
+#include "Controls/UxtBoundsCache.h"
 #include "Components/PrimitiveComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/World.h"
 #include "GameFramework/Actor.h"
 #include "DrawDebugHelpers.h"
+#include "Utils/UxtMathKernels.h"
 #include "Utils/UxtMathUtilsFunctionLibrary.h"
+#include "Utils/UxtDefaultAssets.h"
+#include "Utils/UxtStats.h"
+#include "Interactions/UxtInteractionUtils.h"
 
 
 static FBox CalculateNestedActorBoundsInGivenSpace(const AActor* Actor, const FTransform& WorldToCalcSpace, bool bNonColliding)
@@ -47,12 +54,17 @@ static FBox CalculateNestedActorBoundsInGivenSpace(const AActor* Actor, const FT
 	return Box;
 }
 
+static bool IsSameGrabPointer(const FUxtGrabPointerData& A, const FUxtGrabPointerData& B)
+{
+	return A.NearPointer == B.NearPointer && A.FarPointer == B.FarPointer;
+}
+
 static FBox CalculateNestedActorBoundsInLocalSpace(const AActor* Actor, bool bNonColliding)
 {
 	const FTransform& ActorToWorld = Actor->GetTransform();
 	const FTransform WorldToActor = ActorToWorld.Inverse();
 
-	return CalculateNestedActorBoundsInGivenSpace(Actor, WorldToActor, true);
+	return CalculateNestedActorBoundsInGivenSpace(Actor, WorldToActor, bNonColliding);
 }
 
 FTransform FUxtBoundingBoxAffordanceInfo::GetWorldTransform(const FBox &Bounds, const FTransform &RootTransform) const
@@ -69,8 +81,15 @@ UUxtBoundingBoxManipulatorComponent::UUxtBoundingBoxManipulatorComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
 	PrimaryComponentTick.TickGroup = ETickingGroup::TG_PostPhysics;
+
+	// Default affordance meshes are loaded asynchronously and applied on register, see FUxtDefaultAssets
+
+	BoundsCache = MakeUnique<FUxtBoundsCache>();
 }
 
+// Defined here where FUxtBoundsCache is complete.
+UUxtBoundingBoxManipulatorComponent::~UUxtBoundingBoxManipulatorComponent() = default;
+
 const TArray<FUxtBoundingBoxAffordanceInfo>& UUxtBoundingBoxManipulatorComponent::GetCustomAffordances() const
 {
 	return CustomAffordances;
@@ -101,6 +120,16 @@ bool UUxtBoundingBoxManipulatorComponent::UseCustomAffordances() const
 	return bUseCustomAffordances;
 }
 
+EUxtBoundingBoxAffordanceMode UUxtBoundingBoxManipulatorComponent::GetAffordanceMode() const
+{
+	return AffordanceMode;
+}
+
+void UUxtBoundingBoxManipulatorComponent::SetAffordanceMode(EUxtBoundingBoxAffordanceMode Mode)
+{
+	AffordanceMode = Mode;
+}
+
 EUxtBoundingBoxManipulatorPreset UUxtBoundingBoxManipulatorComponent::GetPreset() const
 {
 	return Preset;
@@ -136,41 +165,125 @@ TSubclassOf<class AActor> UUxtBoundingBoxManipulatorComponent::GetAffordanceKind
 	return nullptr;
 }
 
+UStaticMesh* UUxtBoundingBoxManipulatorComponent::GetAffordanceKindMesh(EUxtBoundingBoxAffordanceKind Kind) const
+{
+	switch (Kind)
+	{
+	case EUxtBoundingBoxAffordanceKind::Center:	return CenterAffordanceMesh;
+	case EUxtBoundingBoxAffordanceKind::Face:		return FaceAffordanceMesh;
+	case EUxtBoundingBoxAffordanceKind::Edge:		return EdgeAffordanceMesh;
+	case EUxtBoundingBoxAffordanceKind::Corner:	return CornerAffordanceMesh;
+	}
+
+	return nullptr;
+}
+
+const TArray<UInstancedStaticMeshComponent*>& UUxtBoundingBoxManipulatorComponent::GetAffordanceInstancers() const
+{
+	return AffordanceInstancers;
+}
+
+const FUxtBoundingBoxAffordanceInfo* UUxtBoundingBoxManipulatorComponent::FindInstancedAffordance(const FVector& Location) const
+{
+	int32 closestInstancer = INDEX_NONE;
+	int32 closestInstance = INDEX_NONE;
+	float closestDistanceSqr = -1.f;
+	for (int32 instancerIndex = 0; instancerIndex < AffordanceInstancers.Num(); ++instancerIndex)
+	{
+		FVector pointOnSurface;
+		float distanceSqr;
+		int32 instanceIndex = FUxtInteractionUtils::GetClosestInstance(AffordanceInstancers[instancerIndex], Location, pointOnSurface, distanceSqr);
+		if (instanceIndex != INDEX_NONE && (closestInstance == INDEX_NONE || distanceSqr < closestDistanceSqr))
+		{
+			closestInstancer = instancerIndex;
+			closestInstance = instanceIndex;
+			closestDistanceSqr = distanceSqr;
+		}
+	}
+
+	for (const FAffordanceInstance& instance : AffordanceInstances)
+	{
+		if (instance.InstancerIndex == closestInstancer && instance.InstanceIndex == closestInstance)
+		{
+			return instance.Affordance;
+		}
+	}
+	return nullptr;
+}
+
 const FBox& UUxtBoundingBoxManipulatorComponent::GetBounds() const
 {
 	return Bounds;
 }
 
-void UUxtBoundingBoxManipulatorComponent::ComputeBoundsFromComponents()
+bool UUxtBoundingBoxManipulatorComponent::GetKeepBoundsFitted() const
 {
-	Bounds = CalculateNestedActorBoundsInLocalSpace(GetOwner(), true);
+	return bKeepBoundsFitted;
+}
 
-	UpdateAffordanceTransforms();
+void UUxtBoundingBoxManipulatorComponent::SetKeepBoundsFitted(bool bEnable)
+{
+	bKeepBoundsFitted = bEnable;
+
+	if (HasBegunPlay())
+	{
+		if (bKeepBoundsFitted)
+		{
+			ComputeBoundsFromComponents();
+		}
+		else
+		{
+			BoundsCache->Reset();
+		}
+
+		UpdateComponentTickEnabled();
+	}
 }
 
-void UUxtBoundingBoxManipulatorComponent::UpdateAffordanceTransforms()
+void UUxtBoundingBoxManipulatorComponent::ComputeBoundsFromComponents()
 {
-	for (const auto &item : ActorAffordanceMap)
+	if (bKeepBoundsFitted)
 	{
-		FTransform affordanceTransform = item.Value->GetWorldTransform(Bounds, GetOwner()->GetActorTransform());
-		item.Key->SetActorTransform(affordanceTransform);
+		// Rebuilding the cache recomputes all component bounds.
+		BoundsCache->Rebuild(GetOwner(), true);
+		Bounds = BoundsCache->GetBounds();
 	}
+	else
+	{
+		Bounds = CalculateNestedActorBoundsInLocalSpace(GetOwner(), true);
+	}
+
+	UpdateAffordanceTransforms();
 }
 
-void UUxtBoundingBoxManipulatorComponent::BeginPlay()
+void UUxtBoundingBoxManipulatorComponent::UpdateAffordanceTransforms()
 {
-	Super::BeginPlay();
+	const FTransform& actorTransform = GetOwner()->GetActorTransform();
 
-	if (bInitBoundsFromActor)
+	for (const auto &item : ActorAffordanceMap)
 	{
-		ComputeBoundsFromComponents();
+		FTransform affordanceTransform = item.Value->GetWorldTransform(Bounds, actorTransform);
+		item.Key->SetActorTransform(affordanceTransform);
 	}
-	else
+
+	if (AffordanceInstances.Num() > 0)
 	{
-		Bounds = FBox(EForceInit::ForceInitToZero);
+		for (const FAffordanceInstance& instance : AffordanceInstances)
+		{
+			FTransform affordanceTransform = GetAffordanceInstanceTransform(*instance.Affordance, actorTransform);
+			AffordanceInstancers[instance.InstancerIndex]->UpdateInstanceTransform(instance.InstanceIndex, affordanceTransform, true, false, true);
+		}
+
+		// Send instance data to the renderer once per instancer instead of once per affordance.
+		for (UInstancedStaticMeshComponent* instancer : AffordanceInstancers)
+		{
+			instancer->MarkRenderStateDirty();
+		}
 	}
+}
 
-	// Create affordances
+void UUxtBoundingBoxManipulatorComponent::CreateAffordanceActors()
+{
 	const auto &usedAffordances = GetUsedAffordances();
 	for (const FUxtBoundingBoxAffordanceInfo &affordance : usedAffordances)
 	{
@@ -193,8 +306,181 @@ void UUxtBoundingBoxManipulatorComponent::BeginPlay()
 			}
 		}
 	}
+}
+
+void UUxtBoundingBoxManipulatorComponent::CreateInstancedAffordances()
+{
+	InstancedAffordanceActor = GetWorld()->SpawnActor<AActor>();
+	if (InstancedAffordanceActor == nullptr)
+	{
+		return;
+	}
+
+	// The root follows the bounding box actor but keeps unit scale, like affordance actors do.
+	USceneComponent* root = NewObject<USceneComponent>(InstancedAffordanceActor, TEXT("Root"));
+	root->SetUsingAbsoluteScale(true);
+	InstancedAffordanceActor->SetRootComponent(root);
+	root->RegisterComponent();
+	InstancedAffordanceActor->AttachToActor(GetOwner(), FAttachmentTransformRules::SnapToTargetNotIncludingScale);
+
+	InstancedAffordanceGrabTarget = NewObject<UUxtGrabTargetComponent>(InstancedAffordanceActor, TEXT("GrabTarget"));
+	InstancedAffordanceGrabTarget->SetupAttachment(root);
+	InstancedAffordanceGrabTarget->RegisterComponent();
+	InstancedAffordanceGrabTarget->OnBeginGrab.AddDynamic(this, &UUxtBoundingBoxManipulatorComponent::OnPointerBeginGrab);
+	InstancedAffordanceGrabTarget->OnUpdateGrab.AddDynamic(this, &UUxtBoundingBoxManipulatorComponent::OnPointerUpdateGrab);
+	InstancedAffordanceGrabTarget->OnEndGrab.AddDynamic(this, &UUxtBoundingBoxManipulatorComponent::OnPointerEndGrab);
+
+	CreateAffordanceInstances();
+}
+
+void UUxtBoundingBoxManipulatorComponent::CreateAffordanceInstances()
+{
+	for (UInstancedStaticMeshComponent* instancer : AffordanceInstancers)
+	{
+		instancer->DestroyComponent();
+	}
+	AffordanceInstancers.Empty();
+	AffordanceInstances.Empty();
+
+	USceneComponent* root = InstancedAffordanceActor->GetRootComponent();
+	const FTransform& actorTransform = GetOwner()->GetActorTransform();
+	const auto &usedAffordances = GetUsedAffordances();
+	for (const FUxtBoundingBoxAffordanceInfo &affordance : usedAffordances)
+	{
+		UStaticMesh* mesh = GetAffordanceKindMesh(affordance.Kind);
+		if (mesh == nullptr)
+		{
+			continue;
+		}
+
+		// Affordances sharing a mesh share an instancer.
+		int32 instancerIndex = AffordanceInstancers.IndexOfByPredicate([mesh](const UInstancedStaticMeshComponent* instancer)
+			{
+				return instancer->GetStaticMesh() == mesh;
+			});
+		if (instancerIndex == INDEX_NONE)
+		{
+			UInstancedStaticMeshComponent* instancer = NewObject<UInstancedStaticMeshComponent>(InstancedAffordanceActor);
+			instancer->SetStaticMesh(mesh);
+			instancer->SetCollisionProfileName(TEXT("UI"));
+			instancer->SetupAttachment(root);
+			instancer->RegisterComponent();
+			instancerIndex = AffordanceInstancers.Add(instancer);
+		}
+
+		FAffordanceInstance instance;
+		instance.Affordance = &affordance;
+		instance.InstancerIndex = instancerIndex;
+		instance.InstanceIndex = AffordanceInstancers[instancerIndex]->AddInstanceWorldSpace(GetAffordanceInstanceTransform(affordance, actorTransform));
+		AffordanceInstances.Add(instance);
+	}
+}
+
+const FUxtBoundingBoxAffordanceInfo* UUxtBoundingBoxManipulatorComponent::FindGrabbedAffordance(UUxtGrabTargetComponent* Grabbable, const FUxtGrabPointerData& GrabPointer) const
+{
+	if (Grabbable != InstancedAffordanceGrabTarget)
+	{
+		const FUxtBoundingBoxAffordanceInfo* const* pAffordance = ActorAffordanceMap.Find(Grabbable->GetOwner());
+		check(pAffordance != nullptr);
+		return *pAffordance;
+	}
+
+	// Pointers keep their affordance while grabbing, even when moving closer to another instance.
+	for (const auto& item : ActiveAffordanceGrabPointers)
+	{
+		if (IsSameGrabPointer(item.Value, GrabPointer))
+		{
+			return item.Key;
+		}
+	}
+
+	// The instance closest to the grab point is the one being grabbed.
+	return FindInstancedAffordance(GrabPointer.GrabPointTransform.GetLocation());
+}
+
+FTransform UUxtBoundingBoxManipulatorComponent::GetAffordanceInstanceTransform(const FUxtBoundingBoxAffordanceInfo& Affordance, const FTransform& ActorTransform) const
+{
+	FTransform transform = Affordance.GetWorldTransform(Bounds, ActorTransform);
+	transform.SetScale3D(FVector(AffordanceMeshScale));
+	return transform;
+}
+
+void UUxtBoundingBoxManipulatorComponent::UpdateComponentTickEnabled()
+{
+	// Affordances follow the actor without ticking, so only manipulation and refitting need updates.
+	PrimaryComponentTick.SetTickFunctionEnable(ActiveAffordanceGrabPointers.Num() > 0 || bKeepBoundsFitted);
+}
+
+void UUxtBoundingBoxManipulatorComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	FUxtDefaultAssets& DefaultAssets = FUxtDefaultAssets::Get();
+	if (DefaultAssets.IsLoaded())
+	{
+		ApplyDefaultAffordanceMeshes();
+	}
+	else
+	{
+		// Instances are only created for affordances with a mesh, add the missing ones once the defaults are loaded
+		DefaultAssets.CallWhenLoaded(this, [this]
+			{
+				if (ApplyDefaultAffordanceMeshes() && HasBegunPlay() && InstancedAffordanceActor != nullptr)
+				{
+					CreateAffordanceInstances();
+				}
+			});
+	}
+}
+
+bool UUxtBoundingBoxManipulatorComponent::ApplyDefaultAffordanceMeshes()
+{
+	const FUxtDefaultAssets& DefaultAssets = FUxtDefaultAssets::Get();
+	bool bChanged = false;
+
+	auto ApplyDefault = [&bChanged](UStaticMesh*& Mesh, UStaticMesh* DefaultMesh)
+	{
+		if (!Mesh && DefaultMesh)
+		{
+			Mesh = DefaultMesh;
+			bChanged = true;
+		}
+	};
+	ApplyDefault(CenterAffordanceMesh, DefaultAssets.GetAffordanceSphereMesh());
+	ApplyDefault(FaceAffordanceMesh, DefaultAssets.GetAffordanceCubeMesh());
+	ApplyDefault(EdgeAffordanceMesh, DefaultAssets.GetAffordanceCubeMesh());
+	ApplyDefault(CornerAffordanceMesh, DefaultAssets.GetAffordanceSphereMesh());
+
+	return bChanged;
+}
+
+void UUxtBoundingBoxManipulatorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UXT_SCOPE_BEGIN_PLAY_COST(BoundingBoxBeginPlay);
+
+	if (bInitBoundsFromActor)
+	{
+		ComputeBoundsFromComponents();
+	}
+	else
+	{
+		Bounds = FBox(EForceInit::ForceInitToZero);
+	}
+
+	// Create affordances
+	if (AffordanceMode == EUxtBoundingBoxAffordanceMode::Instanced)
+	{
+		CreateInstancedAffordances();
+	}
+	else
+	{
+		CreateAffordanceActors();
+	}
 
 	UpdateAffordanceTransforms();
+	UpdateComponentTickEnabled();
 }
 
 void UUxtBoundingBoxManipulatorComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
@@ -209,7 +495,7 @@ void UUxtBoundingBoxManipulatorComponent::EndPlay(const EEndPlayReason::Type End
 		const FUxtGrabPointerData& grabPointer = ActiveAffordanceGrabPointers[0].Value;
 
 		// Find the grab target in use by this pointer
-		UUxtGrabTargetComponent* grabbable = nullptr;
+		UUxtGrabTargetComponent* grabbable = InstancedAffordanceGrabTarget;
 		for (auto item : ActorAffordanceMap)
 		{
 			if (item.Value == affordanceInfo)
@@ -234,11 +520,24 @@ void UUxtBoundingBoxManipulatorComponent::EndPlay(const EEndPlayReason::Type End
 	}
 	ActorAffordanceMap.Empty();
 
+	if (InstancedAffordanceActor != nullptr)
+	{
+		GetWorld()->DestroyActor(InstancedAffordanceActor);
+		InstancedAffordanceActor = nullptr;
+	}
+	InstancedAffordanceGrabTarget = nullptr;
+	AffordanceInstancers.Empty();
+	AffordanceInstances.Empty();
+
+	BoundsCache->Reset();
+
 	Super::EndPlay(EndPlayReason);
 }
 
 void UUxtBoundingBoxManipulatorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	UXT_SCOPE_CYCLE_COUNTER(BoundingBoxUpdate);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (ActiveAffordanceGrabPointers.Num() > 0)
@@ -267,115 +566,63 @@ void UUxtBoundingBoxManipulatorComponent::TickComponent(float DeltaTime, ELevelT
 
 		UpdateAffordanceTransforms();
 	}
+	else if (bKeepBoundsFitted)
+	{
+		// Bounds must remain fixed during manipulation, so only refit while idle.
+		if (!BoundsCache->IsValid())
+		{
+			ComputeBoundsFromComponents();
+		}
+		else if (BoundsCache->Update())
+		{
+			Bounds = BoundsCache->GetBounds();
+			UpdateAffordanceTransforms();
+		}
+	}
 }
 
 void UUxtBoundingBoxManipulatorComponent::ComputeModifiedBounds(const FUxtBoundingBoxAffordanceInfo &Affordance, const FUxtGrabPointerData &GrabPointer, FBox &OutBounds, FQuat &OutDeltaRotation) const
 {
-	//
-	// Look up settings for the affordance
-
-	const FVector affordanceLoc = Affordance.BoundsLocation;
-	const FMatrix affordanceConstraint = Affordance.ConstraintMatrix;
-
-	//
-	// Compute grab pointer movement
-
 	const FVector localGrabPoint = GrabPointer.LocalGrabPoint.GetTranslation();
-	const FVector grabPoint = InitialTransform.TransformPosition(localGrabPoint);
-
 	const FVector target = UUxtGrabPointerDataFunctionLibrary::GetTargetLocation(GrabPointer);
-	const FVector localTarget = InitialTransform.InverseTransformPosition(target);
-
-	//
-	// Compute modified bounding box
-
-	OutBounds = InitialBounds;
-	OutDeltaRotation = FQuat::Identity;
-
-	switch (Affordance.Action)
-	{
-	case EUxtBoundingBoxAffordanceAction::Resize:
-	{
-
-		FVector localDelta = localTarget - localGrabPoint;
-		FVector constrainedDelta = affordanceConstraint.TransformVector(localDelta);
-
-		// Influence factors based on location: only move the side the affordance is on
-		FVector minFactor = (-affordanceLoc).ComponentMax(FVector::ZeroVector);
-		FVector maxFactor = affordanceLoc.ComponentMax(FVector::ZeroVector);
-		OutBounds.Min += constrainedDelta * minFactor;
-		OutBounds.Max += constrainedDelta * maxFactor;
-		break;
-	}
-
-	case EUxtBoundingBoxAffordanceAction::Translate:
-	{
-		FVector localDelta = localTarget - localGrabPoint;
-		FVector constrainedDelta = affordanceConstraint.TransformVector(localDelta);
-
-		// All sides moving together
-		OutBounds.Min += constrainedDelta;
-		OutBounds.Max += constrainedDelta;
-		break;
-	}
-
-	case EUxtBoundingBoxAffordanceAction::Scale:
-	{
-		FVector localDelta = localTarget - localGrabPoint;
-		FVector constrainedDelta = affordanceConstraint.TransformVector(localDelta);
 
-		// Influence factors based on location: move opposing sides in opposite directions
-		FVector minFactor = -affordanceLoc;
-		FVector maxFactor = affordanceLoc;
-		OutBounds.Min += constrainedDelta * minFactor;
-		OutBounds.Max += constrainedDelta * maxFactor;
-		break;
-	}
-
-	case EUxtBoundingBoxAffordanceAction::Rotate:
-	{
-		FVector localCenter = InitialBounds.GetCenter();
-		// Apply constraints to the grab and target vectors.
-		FVector constrainedGrab = affordanceConstraint.TransformVector(localGrabPoint - localCenter);
-		FVector constrainedTarget = affordanceConstraint.TransformVector(localTarget - localCenter);
-		FQuat baseRotation = FQuat::FindBetweenVectors(constrainedGrab, constrainedTarget);
-		FQuat initRot = InitialTransform.GetRotation();
-		OutDeltaRotation = initRot * baseRotation * initRot.Inverse();
-		break;
-	}
-	}
+	FUxtMathKernels::ComputeModifiedBounds(Affordance.Action, Affordance.BoundsLocation, Affordance.ConstraintMatrix, InitialTransform, InitialBounds,
+		localGrabPoint, target, OutBounds, OutDeltaRotation);
 }
 
 void UUxtBoundingBoxManipulatorComponent::OnPointerBeginGrab(UUxtGrabTargetComponent *Grabbable, FUxtGrabPointerData GrabPointer)
 {
-	const FUxtBoundingBoxAffordanceInfo **pAffordance = ActorAffordanceMap.Find(Grabbable->GetOwner());
-	check(pAffordance != nullptr);
+	const FUxtBoundingBoxAffordanceInfo* affordance = FindGrabbedAffordance(Grabbable, GrabPointer);
+	if (affordance == nullptr)
+	{
+		return;
+	}
 
 	FUxtGrabPointerData bboxGrabPointer;
 	bboxGrabPointer.NearPointer = GrabPointer.NearPointer;
+	bboxGrabPointer.FarPointer = GrabPointer.FarPointer;
 	bboxGrabPointer.GrabPointTransform = GrabPointer.GrabPointTransform;
 	bboxGrabPointer.StartTime = GrabPointer.StartTime;
 	// Transform into the bbox actor space
 	FTransform relTransform = Grabbable->GetComponentTransform().GetRelativeTransform(GetOwner()->GetActorTransform());
 	bboxGrabPointer.LocalGrabPoint = UUxtGrabPointerDataFunctionLibrary::GetGrabTransform(relTransform, GrabPointer);
 
-	if (TryActivateGrabPointer(**pAffordance, bboxGrabPointer))
+	if (TryActivateGrabPointer(*affordance, bboxGrabPointer))
 	{
-		OnManipulationStarted.Broadcast(this, **pAffordance, Grabbable);
+		OnManipulationStarted.Broadcast(this, *affordance, Grabbable);
 	}
 }
 
 void UUxtBoundingBoxManipulatorComponent::OnPointerUpdateGrab(UUxtGrabTargetComponent* Grabbable, FUxtGrabPointerData GrabPointer)
 {
-	const FUxtBoundingBoxAffordanceInfo** pAffordance = ActorAffordanceMap.Find(Grabbable->GetOwner());
-	check(pAffordance != nullptr);
-
-	FUxtGrabPointerData* pBBoxGrabPointer = FindGrabPointer(**pAffordance);
+	const FUxtBoundingBoxAffordanceInfo* affordance = FindGrabbedAffordance(Grabbable, GrabPointer);
+	FUxtGrabPointerData* pBBoxGrabPointer = affordance ? FindGrabPointer(*affordance) : nullptr;
 	// Only the first grabbing pointer is supported by bounding box at this point.
 	// Other pointers may still be grabbing, but will not have a grab pointer entry.
-	if (pBBoxGrabPointer)
+	if (pBBoxGrabPointer && IsSameGrabPointer(*pBBoxGrabPointer, GrabPointer))
 	{
 		pBBoxGrabPointer->NearPointer = GrabPointer.NearPointer;
+		pBBoxGrabPointer->FarPointer = GrabPointer.FarPointer;
 		pBBoxGrabPointer->GrabPointTransform = GrabPointer.GrabPointTransform;
 		pBBoxGrabPointer->StartTime = GrabPointer.StartTime;
 		// Transform into the bbox actor space
@@ -386,12 +633,11 @@ void UUxtBoundingBoxManipulatorComponent::OnPointerUpdateGrab(UUxtGrabTargetComp
 
 void UUxtBoundingBoxManipulatorComponent::OnPointerEndGrab(UUxtGrabTargetComponent *Grabbable, FUxtGrabPointerData GrabPointer)
 {
-	const FUxtBoundingBoxAffordanceInfo **pAffordance = ActorAffordanceMap.Find(Grabbable->GetOwner());
-	check(pAffordance != nullptr);
-
-	if (TryReleaseGrabPointer(**pAffordance))
+	const FUxtBoundingBoxAffordanceInfo* affordance = FindGrabbedAffordance(Grabbable, GrabPointer);
+	const FUxtGrabPointerData* pBBoxGrabPointer = affordance ? FindGrabPointer(*affordance) : nullptr;
+	if (pBBoxGrabPointer && IsSameGrabPointer(*pBBoxGrabPointer, GrabPointer) && TryReleaseGrabPointer(*affordance))
 	{
-		OnManipulationEnded.Broadcast(this, **pAffordance, Grabbable);
+		OnManipulationEnded.Broadcast(this, *affordance, Grabbable);
 	}
 }
 
@@ -402,6 +648,7 @@ bool UUxtBoundingBoxManipulatorComponent::TryActivateGrabPointer(const FUxtBound
 		ActiveAffordanceGrabPointers.Emplace(&Affordance, GrabPointer);
 		InitialBounds = Bounds;
 		InitialTransform = GetOwner()->GetActorTransform();
+		UpdateComponentTickEnabled();
 		return true;
 	}
 	return false;
@@ -414,6 +661,7 @@ bool UUxtBoundingBoxManipulatorComponent::TryReleaseGrabPointer(const FUxtBoundi
 		{
 			return item.Key == &Affordance;
 		});
+	UpdateComponentTickEnabled();
 	return numRemoved > 0;
 }
 
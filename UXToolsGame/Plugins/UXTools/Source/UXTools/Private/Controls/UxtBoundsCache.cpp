@@ -0,0 +1,221 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Controls/UxtBoundsCache.h"
+#include "Components/ChildActorComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Actor.h"
+
+FUxtBoundsCache::~FUxtBoundsCache()
+{
+	Reset();
+}
+
+void FUxtBoundsCache::Rebuild(const AActor* Actor, bool bNonColliding)
+{
+	Reset();
+
+	if (Actor == nullptr)
+	{
+		return;
+	}
+
+	RootActor = Actor;
+	bIncludeNonColliding = bNonColliding;
+
+	AddActor(Actor);
+
+	const FTransform WorldToActor = Actor->GetTransform().Inverse();
+	for (FPrimitiveEntry& Entry : PrimitiveEntries)
+	{
+		UpdateEntry(Entry, WorldToActor);
+	}
+
+	CombineBounds();
+}
+
+void FUxtBoundsCache::Reset()
+{
+	for (FPrimitiveEntry& Entry : PrimitiveEntries)
+	{
+		if (UPrimitiveComponent* Primitive = Entry.Primitive.Get())
+		{
+			Primitive->TransformUpdated.Remove(Entry.TransformUpdatedHandle);
+		}
+	}
+
+	PrimitiveEntries.Empty();
+	ActorEntries.Empty();
+	ChildActorEntries.Empty();
+	RootActor = nullptr;
+	bAnyDirty = false;
+	Bounds = FBox(ForceInit);
+}
+
+bool FUxtBoundsCache::Update()
+{
+	const AActor* Actor = RootActor.Get();
+	if (Actor == nullptr)
+	{
+		return false;
+	}
+
+	if (HasHierarchyChanged())
+	{
+		Rebuild(Actor, bIncludeNonColliding);
+		return true;
+	}
+
+	bool bChanged = false;
+
+	// Registration and collision changes do not raise transform events, so check each primitive.
+	for (FPrimitiveEntry& Entry : PrimitiveEntries)
+	{
+		if (Entry.bIncluded != ShouldInclude(Entry.Primitive.Get()))
+		{
+			Entry.bDirty = true;
+			bAnyDirty = true;
+		}
+	}
+
+	if (bAnyDirty)
+	{
+		bAnyDirty = false;
+
+		const FTransform WorldToActor = Actor->GetTransform().Inverse();
+		for (FPrimitiveEntry& Entry : PrimitiveEntries)
+		{
+			if (Entry.bDirty)
+			{
+				bChanged |= UpdateEntry(Entry, WorldToActor);
+			}
+		}
+	}
+
+	if (bChanged)
+	{
+		CombineBounds();
+	}
+
+	return bChanged;
+}
+
+bool FUxtBoundsCache::IsValid() const
+{
+	return RootActor.IsValid();
+}
+
+const FBox& FUxtBoundsCache::GetBounds() const
+{
+	return Bounds;
+}
+
+void FUxtBoundsCache::AddActor(const AActor* Actor)
+{
+	FActorEntry& ActorEntry = ActorEntries.AddDefaulted_GetRef();
+	ActorEntry.Actor = Actor;
+	ActorEntry.NumComponents = Actor->GetComponents().Num();
+
+	for (UActorComponent* ActorComponent : Actor->GetComponents())
+	{
+		if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(ActorComponent))
+		{
+			const int32 EntryIndex = PrimitiveEntries.Num();
+			FPrimitiveEntry& Entry = PrimitiveEntries.AddDefaulted_GetRef();
+			Entry.Primitive = Primitive;
+			Entry.TransformUpdatedHandle = Primitive->TransformUpdated.AddRaw(this, &FUxtBoundsCache::OnTransformUpdated, EntryIndex);
+		}
+
+		if (const UChildActorComponent* ChildActor = Cast<const UChildActorComponent>(ActorComponent))
+		{
+			FChildActorEntry& ChildActorEntry = ChildActorEntries.AddDefaulted_GetRef();
+			ChildActorEntry.Component = ChildActor;
+			ChildActorEntry.ChildActor = ChildActor->GetChildActor();
+
+			if (const AActor* NestedActor = ChildActor->GetChildActor())
+			{
+				AddActor(NestedActor);
+			}
+		}
+	}
+}
+
+bool FUxtBoundsCache::HasHierarchyChanged() const
+{
+	for (const FActorEntry& ActorEntry : ActorEntries)
+	{
+		const AActor* Actor = ActorEntry.Actor.Get();
+		if (Actor == nullptr || Actor->GetComponents().Num() != ActorEntry.NumComponents)
+		{
+			return true;
+		}
+	}
+
+	for (const FChildActorEntry& ChildActorEntry : ChildActorEntries)
+	{
+		const UChildActorComponent* Component = ChildActorEntry.Component.Get();
+		if (Component == nullptr || Component->GetChildActor() != ChildActorEntry.ChildActor)
+		{
+			return true;
+		}
+	}
+
+	for (const FPrimitiveEntry& Entry : PrimitiveEntries)
+	{
+		if (!Entry.Primitive.IsValid())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FUxtBoundsCache::ShouldInclude(const UPrimitiveComponent* Primitive) const
+{
+	// Only use collidable components to find collision bounding box, unless non-colliding components are included.
+	return Primitive != nullptr && Primitive->IsRegistered() && (bIncludeNonColliding || Primitive->IsCollisionEnabled());
+}
+
+bool FUxtBoundsCache::UpdateEntry(FPrimitiveEntry& Entry, const FTransform& WorldToActor)
+{
+	Entry.bDirty = false;
+
+	const UPrimitiveComponent* Primitive = Entry.Primitive.Get();
+	const bool bWasIncluded = Entry.bIncluded;
+	Entry.bIncluded = ShouldInclude(Primitive);
+
+	if (!Entry.bIncluded)
+	{
+		return bWasIncluded;
+	}
+
+	// Moving the whole actor updates all primitive transforms, but does not change their bounds in actor space.
+	const FTransform ComponentToActor = Primitive->GetComponentTransform() * WorldToActor;
+	if (bWasIncluded && ComponentToActor.Equals(Entry.ComponentToActor, KINDA_SMALL_NUMBER))
+	{
+		return false;
+	}
+
+	Entry.ComponentToActor = ComponentToActor;
+	Entry.LocalBounds = Primitive->CalcBounds(ComponentToActor).GetBox();
+	return true;
+}
+
+void FUxtBoundsCache::CombineBounds()
+{
+	Bounds = FBox(ForceInit);
+	for (const FPrimitiveEntry& Entry : PrimitiveEntries)
+	{
+		if (Entry.bIncluded)
+		{
+			Bounds += Entry.LocalBounds;
+		}
+	}
+}
+
+void FUxtBoundsCache::OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 EntryIndex)
+{
+	PrimitiveEntries[EntryIndex].bDirty = true;
+	bAnyDirty = true;
+}
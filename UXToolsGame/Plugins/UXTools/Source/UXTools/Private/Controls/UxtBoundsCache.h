@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SceneComponent.h"
+
+class AActor;
+class UChildActorComponent;
+class UPrimitiveComponent;
+
+/**
+ * Caches the bounds of all primitives in an actor and its child actors, in the local space of the actor.
+ *
+ * Primitive transform changes are tracked through transform update events, so only moved primitives have
+ * their bounds recomputed. Added, removed, registered or unregistered components are detected by cheap
+ * checks on every update and cause the affected entries to be refreshed.
+ *
+ * Changes to a primitive's shape that do not affect its transform (e.g. replacing a static mesh)
+ * are not detected and require a call to Rebuild.
+ *
+ * Usage:
+ * Call Rebuild to start tracking an actor, then call Update whenever up-to-date bounds are needed.
+ */
+class FUxtBoundsCache
+{
+public:
+
+	~FUxtBoundsCache();
+
+	/** Recompute all bounds from scratch and start tracking the actor hierarchy. */
+	void Rebuild(const AActor* Actor, bool bNonColliding);
+
+	/** Stop tracking the actor. */
+	void Reset();
+
+	/**
+	 * Recompute bounds of primitives that have changed since the last update.
+	 * Returns true if the combined bounds have changed.
+	 */
+	bool Update();
+
+	/** Returns true if an actor is being tracked. */
+	bool IsValid() const;
+
+	/** Combined bounds in the local space of the actor. */
+	const FBox& GetBounds() const;
+
+private:
+
+	struct FPrimitiveEntry
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Primitive;
+		FDelegateHandle TransformUpdatedHandle;
+
+		/** Transform of the primitive relative to the tracked actor when its bounds were computed. */
+		FTransform ComponentToActor;
+
+		/** Bounds of the primitive in the space of the tracked actor. */
+		FBox LocalBounds;
+
+		/** True if the primitive contributes to the combined bounds. */
+		bool bIncluded = false;
+
+		/** True if the primitive transform has been updated since the last update. */
+		bool bDirty = false;
+	};
+
+	struct FActorEntry
+	{
+		TWeakObjectPtr<const AActor> Actor;
+
+		/** Number of components when the entry was created, used to detect added or removed components. */
+		int32 NumComponents = 0;
+	};
+
+	struct FChildActorEntry
+	{
+		TWeakObjectPtr<const UChildActorComponent> Component;
+
+		/** Child actor when the entry was created, used to detect recreated child actors. */
+		const AActor* ChildActor = nullptr;
+	};
+
+	/** Add entries for all components of the actor and its child actors. */
+	void AddActor(const AActor* Actor);
+
+	/** Returns true if components have been added, removed or child actors replaced since the last rebuild. */
+	bool HasHierarchyChanged() const;
+
+	/** Returns true if the primitive should contribute to the bounds. */
+	bool ShouldInclude(const UPrimitiveComponent* Primitive) const;
+
+	/** Recompute primitive bounds in actor space, returns true if they have changed. */
+	bool UpdateEntry(FPrimitiveEntry& Entry, const FTransform& WorldToActor);
+
+	/** Combine bounds of all included primitives. */
+	void CombineBounds();
+
+	void OnTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport, int32 EntryIndex);
+
+	TWeakObjectPtr<const AActor> RootActor;
+	bool bIncludeNonColliding = true;
+
+	TArray<FPrimitiveEntry> PrimitiveEntries;
+	TArray<FActorEntry> ActorEntries;
+	TArray<FChildActorEntry> ChildActorEntries;
+
+	/** True if any primitive entry is dirty. */
+	bool bAnyDirty = false;
+
+	FBox Bounds = FBox(ForceInit);
+};
@@ -3,13 +3,18 @@
 
 #include "Controls/UxtFarBeamComponent.h"
 #include "Input/UxtFarPointerComponent.h"
-#include "UObject/ConstructorHelpers.h"
 #include "Engine/StaticMesh.h"
 #include "Materials/MaterialInstanceDynamic.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/Actor.h"
+#include "Utils/UxtDefaultAssets.h"
 #include "UXTools.h"
 
+namespace
+{
+	// Change of the curve offset below which custom primitive data is not written, each write marks the render state dirty
+	const float CurveOffsetTolerance = 0.1f;
+}
 
 UUxtFarBeamComponent::UUxtFarBeamComponent()
 {
@@ -18,13 +23,7 @@ UUxtFarBeamComponent::UUxtFarBeamComponent()
 	// Will enable tick on far pointer activation
 	PrimaryComponentTick.bStartWithTickEnabled = false;
 
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> MeshFinder(TEXT("/UXTools/Pointers/SM_Beam"));
-	check(MeshFinder.Object);
-	SetStaticMesh(MeshFinder.Object);
-
-	static ConstructorHelpers::FObjectFinder<UMaterialInterface> MaterialFinder(TEXT("/UXTools/Pointers/M_Beam"));
-	check(MaterialFinder.Object);
-	SetMaterial(0, MaterialFinder.Object);
+	// Default mesh and material are loaded asynchronously and applied on register, see FUxtDefaultAssets
 
 	SetCastShadow(false);
 	SetCollisionEnabled(ECollisionEnabled::NoCollision);
@@ -34,6 +33,26 @@ UUxtFarBeamComponent::UUxtFarBeamComponent()
 	SetRelativeScale3D(FVector(1.0f, 0.1f, 0.1f));
 }
 
+void UUxtFarBeamComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	FUxtDefaultAssets::Get().CallWhenLoaded(this, [this]
+		{
+			FUxtDefaultAssets& DefaultAssets = FUxtDefaultAssets::Get();
+
+			// Keep mesh and material if they have been set
+			if (!GetStaticMesh())
+			{
+				SetStaticMesh(DefaultAssets.GetBeamMesh());
+			}
+			if (OverrideMaterials.Num() == 0 || !OverrideMaterials[0])
+			{
+				SetMaterial(0, DefaultAssets.GetBeamMaterial());
+			}
+		});
+}
+
 void UUxtFarBeamComponent::BeginPlay()
 {
 	Super::BeginPlay();
@@ -107,6 +126,41 @@ void UUxtFarBeamComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
 		FQuat PointerOrientation = FarPointer->GetPointerOrientation();
 		FQuat Rotation = FQuat::FindBetweenNormals(PointerOrientation.GetForwardVector(), Dir) * PointerOrientation;
 
-		SetWorldTransform(FTransform(Rotation, Start, Scale));
+		// Place the control point along the pointer ray, half way to the hit point. Only locked hit points leave the
+		// pointer ray, the unlocked beam ends at the hover distance over the surface and is kept straight.
+		FVector NewCurveOffset = FVector::ZeroVector;
+		if (bCurved && FarPointer->GetFocusLocked())
+		{
+			const FVector ControlPoint = Start + PointerOrientation.GetForwardVector() * (0.5f * Length);
+			NewCurveOffset = ControlPoint - 0.5f * (Start + End);
+		}
+
+		// Set before the transform so that it is included in the new bounds
+		const bool bCurveChanged = NewCurveOffset.IsZero() ? !CurveOffset.IsZero() : !NewCurveOffset.Equals(CurveOffset, CurveOffsetTolerance);
+		if (bCurveChanged)
+		{
+			CurveOffset = NewCurveOffset;
+			SetCustomPrimitiveDataVector3(0, CurveOffset);
+		}
+
+		const FTransform NewTransform(Rotation, Start, Scale);
+		if (bCurveChanged && NewTransform.Equals(GetComponentTransform()))
+		{
+			UpdateBounds();
+			MarkRenderTransformDirty();
+		}
+		SetWorldTransform(NewTransform);
 	}
 }
+
+FBoxSphereBounds UUxtFarBeamComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	const FBoxSphereBounds StraightBounds = Super::CalcBounds(LocalToWorld);
+	if (CurveOffset.IsZero())
+	{
+		return StraightBounds;
+	}
+
+	// The curve deviates at most half the control point offset from the straight beam.
+	return FBoxSphereBounds(StraightBounds.GetBox().ExpandBy(0.5f * CurveOffset.GetAbs()));
+}
@@ -6,6 +6,7 @@
 #include "GameFramework/Actor.h"
 #include "Utils/UxtFunctionLibrary.h"
 #include "UXTools.h"
+#include "Utils/UxtStats.h"
 
 
 UUxtFarCursorComponent::UUxtFarCursorComponent()
@@ -76,6 +77,8 @@ void UUxtFarCursorComponent::OnFarPointerDisabled(UUxtFarPointerComponent* FarPo
 
 void UUxtFarCursorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	UXT_SCOPE_CYCLE_COUNTER(CursorUpdate);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (UUxtFarPointerComponent* FarPointer = FarPointerWeak.Get())
@@ -6,6 +6,7 @@
 #include "Input/UxtNearPointerComponent.h"
 #include "GameFramework/Actor.h"
 #include "HandTracking/UxtHandTrackingFunctionLibrary.h"
+#include "Utils/UxtStats.h"
 
 namespace
 {
@@ -106,6 +107,8 @@ void UUxtFingerCursorComponent::BeginPlay()
 
 void UUxtFingerCursorComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	UXT_SCOPE_CYCLE_COUNTER(CursorUpdate);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	if (UUxtNearPointerComponent* HandPointer = HandPointerWeak.Get())
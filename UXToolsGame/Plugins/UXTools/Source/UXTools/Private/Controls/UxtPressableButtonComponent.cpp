@@ -2,27 +2,50 @@
 // Licensed under the MIT License.
 
 #include "Controls/UxtPressableButtonComponent.h"
+#include "Controls/UxtPressableButtonSubsystem.h"
 #include "Input/UxtNearPointerComponent.h"
 #include "Input/UxtFarPointerComponent.h"
 #include "UXTools.h"
 #include "Interactions/UxtInteractionUtils.h"
+#include "Utils/UxtFlightRecorder.h"
+#include "Utils/UxtStats.h"
 
+#include <Misc/App.h>
+
+#include <Engine/World.h>
 #include <GameFramework/Actor.h>
 #include <DrawDebugHelpers.h>
 #include <Components/BoxComponent.h>
 #include <Components/ShapeComponent.h>
 #include <Components/StaticMeshComponent.h>
 
+namespace
+{
+	/** Time of the latest sample of a near pointer, or the frame time for other pointers. */
+	double GetPointerSampleTime(UObject* Pointer)
+	{
+		if (const UUxtNearPointerComponent* NearPointer = Cast<UUxtNearPointerComponent>(Pointer))
+		{
+			return NearPointer->GetPokePointerSampleTime();
+		}
+		return FApp::GetCurrentTime();
+	}
+}
+
 // Sets default values for this component's properties
 UUxtPressableButtonComponent::UUxtPressableButtonComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.TickGroup = ETickingGroup::TG_PostPhysics;
+	// Buttons are updated in batches by the button subsystem.
+	PrimaryComponentTick.bCanEverTick = false;
 
 	MaxPushDistance = 10;
 	PressedFraction = 0.5f;
 	ReleasedFraction = 0.2f;
 	RecoverySpeed = 50;
+
+	// The collider is created with the button and saved with its extents, so no components are created at runtime.
+	BoxComponent = CreateDefaultSubobject<UBoxComponent>(TEXT("Collider"));
+	BoxComponent->SetupAttachment(this);
 }
 
 USceneComponent* UUxtPressableButtonComponent::GetVisuals() const 
@@ -36,16 +59,58 @@ void UUxtPressableButtonComponent::SetVisuals(USceneComponent* Visuals)
 
 	if (Visuals)
 	{
-		if (UStaticMeshComponent* Touchable = Cast<UStaticMeshComponent>(GetVisuals()))
+		UStaticMeshComponent* Touchable = Cast<UStaticMeshComponent>(GetVisuals());
+		if (Touchable)
 		{
 			Touchable->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		}
 
-			ConfigureBoxComponent(Touchable);
+		UpdateColliderData();
+
+		if (Touchable)
+		{
+			ConfigureBoxComponent();
 		}
+	}
+}
+
+void UUxtPressableButtonComponent::UpdateColliderData()
+{
+	bHasColliderData = false;
 
-		const FVector VisualsOffset = Visuals->GetComponentLocation() - GetRestPosition();
-		VisualsOffsetLocal = GetComponentTransform().InverseTransformVector(VisualsOffset);
+	USceneComponent* Visuals = GetVisuals();
+	if (!Visuals)
+	{
+		return;
 	}
+
+	const FTransform& ComponentTransform = GetComponentTransform();
+
+	ColliderDataMesh = nullptr;
+	if (const UStaticMeshComponent* Mesh = Cast<UStaticMeshComponent>(Visuals))
+	{
+		FVector Min, Max;
+		Mesh->GetLocalBounds(Min, Max);
+
+		ColliderExtent = (Max - Min) * 0.5f;
+
+		const FTransform BoxTransform = FTransform((Max + Min) / 2) * Mesh->GetComponentTransform();
+		ColliderTransformLocal = BoxTransform.GetRelativeTransform(ComponentTransform);
+
+		const FVector RestPosition = BoxTransform.GetLocation() - BoxTransform.GetUnitAxis(EAxis::X) * ColliderExtent.X * BoxTransform.GetScale3D().X;
+		RestPositionLocal = ComponentTransform.InverseTransformPosition(RestPosition);
+
+		const FVector ColliderOffset = BoxTransform.GetLocation() - RestPosition;
+		ColliderOffsetLocal = ComponentTransform.InverseTransformVector(ColliderOffset);
+
+		ColliderDataMesh = Mesh->GetStaticMesh();
+	}
+
+	const FVector VisualsOffset = Visuals->GetComponentLocation() - GetRestPosition();
+	VisualsOffsetLocal = ComponentTransform.InverseTransformVector(VisualsOffset);
+
+	ColliderDataVisualsTransform = Visuals->GetComponentTransform().GetRelativeTransform(ComponentTransform);
+	bHasColliderData = true;
 }
 
 
@@ -60,7 +125,7 @@ void UUxtPressableButtonComponent::SetCollisionProfile(FName Profile)
 
 bool UUxtPressableButtonComponent::IsPressed() const
 {
-	return bIsPressed;
+	return ButtonSet && ButtonSet->IsPressed(this);
 }
 
 float UUxtPressableButtonComponent::GetScaleAdjustedMaxPushDistance() const
@@ -68,122 +133,204 @@ float UUxtPressableButtonComponent::GetScaleAdjustedMaxPushDistance() const
 	return MaxPushDistance * GetComponentTransform().GetScale3D().X;
 }
 
+double UUxtPressableButtonComponent::GetLastPressedTime() const
+{
+	return LastPressedTime;
+}
+
+double UUxtPressableButtonComponent::GetLastReleasedTime() const
+{
+	return LastReleasedTime;
+}
+
 // Called when the game starts
 void UUxtPressableButtonComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	BoxComponent = NewObject<UBoxComponent>(this);
-
-	BoxComponent->SetupAttachment(this);
-	BoxComponent->RegisterComponent();
+	UXT_SCOPE_BEGIN_PLAY_COST(ButtonBeginPlay);
 
+	USceneComponent* Visuals = GetVisuals();
+	UStaticMeshComponent* Pokable = Cast<UStaticMeshComponent>(Visuals);
+	if (Pokable)
+	{
+		Pokable->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
 
-	if (USceneComponent* Visuals = GetVisuals())
+	// Collider data is normally computed in the editor and the collider saved with it, only buttons
+	// with visuals moved since then need to query the visuals mesh and resize the collider here.
+	if (!HasValidColliderData(Visuals))
 	{
-		if (UStaticMeshComponent* Pokable = Cast<UStaticMeshComponent>(Visuals))
+		UpdateColliderData();
+		if (Pokable)
 		{
-			Pokable->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-			ConfigureBoxComponent(Pokable);
+			ConfigureBoxComponent();
 		}
+	}
 
-		const FVector VisualsOffset = Visuals->GetComponentLocation() - GetRestPosition();
-		VisualsOffsetLocal = GetComponentTransform().InverseTransformVector(VisualsOffset);
+	ButtonSet = GetWorld()->GetSubsystem<UUxtPressableButtonSubsystem>();
+	if (ButtonSet)
+	{
+		ButtonSet->RegisterButton(this);
 	}
 }
 
-// Called every frame
-void UUxtPressableButtonComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UUxtPressableButtonComponent::OnRegister()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	Super::OnRegister();
 
-	// Update poke if we're not currently pressed via a far pointer
-	if (!FarPointerWeak.IsValid())
+	// Keep collider data up to date in the editor so that it is serialized with the component.
+	UWorld* World = GetWorld();
+	if (World && !World->IsGameWorld())
 	{
-		// Update button logic with all known pointers
-		UUxtNearPointerComponent* NewPokingPointer = nullptr;
-		float TargetDistance = 0;
-
-		for (UUxtNearPointerComponent* Pointer : PokePointers)
+		UpdateColliderData();
+		if (Cast<UStaticMeshComponent>(GetVisuals()))
 		{
-			float PushDistance = CalculatePushDistance(Pointer);
-			if (PushDistance > TargetDistance)
-			{
-				NewPokingPointer = Pointer;
-				TargetDistance = PushDistance;
-			}
+			ConfigureBoxComponent();
 		}
+	}
+
+	// The actor only registers the collider along with its other components, not when the button is added at runtime.
+	if (World && !BoxComponent->IsRegistered())
+	{
+		BoxComponent->RegisterComponentWithWorld(World);
+	}
+}
 
-		check(TargetDistance >= 0 && TargetDistance <= GetScaleAdjustedMaxPushDistance());
+void UUxtPressableButtonComponent::PreSave(const ITargetPlatform* TargetPlatform)
+{
+	Super::PreSave(TargetPlatform);
 
-		const float PreviousPushDistance = CurrentPushDistance;
+	const UWorld* World = GetWorld();
+	if (World && !World->IsGameWorld())
+	{
+		UpdateColliderData();
+	}
+}
 
-		// Update push distance and raise events
-		if (TargetDistance > CurrentPushDistance)
-		{
-			CurrentPushDistance = TargetDistance;
-			float PressedDistance = GetPressedDistance();
+void UUxtPressableButtonComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (ButtonSet)
+	{
+		ButtonSet->UnregisterButton(this);
+		ButtonSet = nullptr;
+	}
 
-			if (!bIsPressed && CurrentPushDistance >= PressedDistance && PreviousPushDistance < PressedDistance)
-			{
-				bIsPressed = true;
-				OnButtonPressed.Broadcast(this);
-			}
-		}
-		else
-		{
-			CurrentPushDistance = FMath::Max(TargetDistance, CurrentPushDistance - DeltaTime * RecoverySpeed);
-			float ReleasedDistance = GetReleasedDistance();
+	Super::EndPlay(EndPlayReason);
+}
 
-			// Raise button released if we're pressed and crossed the released distance
-			if (bIsPressed && (CurrentPushDistance <= ReleasedDistance && PreviousPushDistance > ReleasedDistance))
-			{
-				bIsPressed = false;
-				OnButtonReleased.Broadcast(this);
-			}
+float UUxtPressableButtonComponent::GetTargetPushDistance(UUxtNearPointerComponent*& OutPointer) const
+{
+	OutPointer = nullptr;
+	float TargetDistance = 0;
+	for (UUxtNearPointerComponent* Pointer : PokePointers)
+	{
+		const float PushDistance = CalculatePushDistance(Pointer);
+		if (PushDistance > TargetDistance)
+		{
+			OutPointer = Pointer;
+			TargetDistance = PushDistance;
 		}
 	}
+	return TargetDistance;
+}
 
-	// Update visuals position
-	if (USceneComponent* Visuals = GetVisuals())
+void UUxtPressableButtonComponent::RecordPokeCrossings(const UUxtNearPointerComponent* Pointer)
+{
+	const double Time = Pointer->GetPokePointerSampleTime();
+	const double PreviousTime = Pointer->GetPreviousPokePointerSampleTime();
+	if (PreviousTime <= 0 || PreviousTime >= Time)
 	{
-		const FVector VisualsOffset = GetComponentTransform().TransformVector(VisualsOffsetLocal);
-		FVector NewVisualsLocation = VisualsOffset + GetCurrentButtonLocation();
-		Visuals->SetWorldLocation(NewVisualsLocation);
+		return;
+	}
 
-		const FVector ColliderOffset = GetComponentTransform().TransformVector(ColliderOffsetLocal);
-		FVector NewColliderLocation = ColliderOffset + GetCurrentButtonLocation();
-		BoxComponent->SetWorldLocation(NewColliderLocation);
+	// Unclamped distances keep the interpolation linear when the previous sample is in front of the button.
+	const float Distance = GetUnclampedPushDistanceAt(Pointer->GetPokePointerTransform().GetLocation());
+	const float PreviousDistance = GetUnclampedPushDistanceAt(Pointer->GetPreviousPokePointerSampleLocation());
+
+	const float PressedDistance = GetPressedDistance();
+	if (PreviousDistance < PressedDistance && Distance >= PressedDistance)
+	{
+		const double Alpha = (PressedDistance - PreviousDistance) / (Distance - PreviousDistance);
+		PokePressedTime = FMath::Lerp(PreviousTime, Time, Alpha);
+	}
+
+	const float ReleasedDistance = GetReleasedDistance();
+	if (PreviousDistance > ReleasedDistance && Distance <= ReleasedDistance)
+	{
+		const double Alpha = (ReleasedDistance - PreviousDistance) / (Distance - PreviousDistance);
+		PokeReleasedTime = FMath::Lerp(PreviousTime, Time, Alpha);
+	}
+}
+
+void UUxtPressableButtonComponent::BroadcastPressed(double Time)
+{
+	LastPressedTime = Time;
+	FUxtFlightRecorder::Get().Record(EUxtFlightEventType::ButtonPressed, EUxtFlightInteraction::None, nullptr, this, GetComponentLocation());
+	OnButtonPressed.Broadcast(this);
+}
+
+void UUxtPressableButtonComponent::BroadcastReleased(double Time)
+{
+	LastReleasedTime = Time;
+	FUxtFlightRecorder::Get().Record(EUxtFlightEventType::ButtonReleased, EUxtFlightInteraction::None, nullptr, this, GetComponentLocation());
+	OnButtonReleased.Broadcast(this);
+}
+
+void UUxtPressableButtonComponent::UpdateVisuals()
+{
+	USceneComponent* Visuals = GetVisuals();
+	if (!Visuals)
+	{
+		return;
 	}
 
-#if 0
-	// Debug display
+	if (PushVisualsMode == EUxtPushVisualsMode::CustomPrimitiveData)
 	{
-		// Button face
+		// The material animates the push, so there are no transform or render state updates.
+		const float PushDistance = ButtonSet ? ButtonSet->GetPushDistance(this) : 0;
+		if (PushDistance != VisualsPushDistance)
 		{
-			FVector Position = GetCurrentButtonLocation();
-			FPlane Plane(Position, -GetComponentTransform().GetUnitAxis(EAxis::X));
-			FVector2D HalfExtents = GetButtonExtents();
-			DrawDebugSolidPlane(GetWorld(), Plane, Position, HalfExtents, FColor::Blue);
+			if (UPrimitiveComponent* VisualsPrimitive = Cast<UPrimitiveComponent>(Visuals))
+			{
+				VisualsPrimitive->SetCustomPrimitiveDataFloat(PushCustomDataIndex, PushDistance);
+			}
+			VisualsPushDistance = PushDistance;
 		}
 
-		// Pointers
-		for (const auto& Pointer : GetPokePointers())
-		{
-			auto Position = Pointer.Key->GetPokePointerTransform().GetLocation();
+		// The collider front face only matters to poking pointers, it can stay at rest while recovering.
+		SetColliderPushDistance(PokePointers.Num() > 0 ? PushDistance : 0);
+	}
+	else
+	{
+		const FVector ButtonLocation = GetCurrentButtonLocation();
 
-			// Shift it up a bit so it is not hidden by the pointer visuals.
-			Position.Z += 2;
+		const FVector VisualsOffset = GetComponentTransform().TransformVector(VisualsOffsetLocal);
+		Visuals->SetWorldLocation(VisualsOffset + ButtonLocation);
 
-			DrawDebugPoint(GetWorld(), Position, 10, FColor::Yellow);
-		}
+		const FVector ColliderOffset = GetComponentTransform().TransformVector(ColliderOffsetLocal);
+		BoxComponent->SetWorldLocation(ColliderOffset + ButtonLocation);
+	}
+}
+
+void UUxtPressableButtonComponent::SetColliderPushDistance(float PushDistance)
+{
+	if (PushDistance != ColliderPushDistance)
+	{
+		const FVector ColliderOffset = GetComponentTransform().TransformVector(ColliderOffsetLocal);
+		const FVector ColliderLocation = GetRestPosition() + GetComponentTransform().GetUnitAxis(EAxis::X) * PushDistance;
+		BoxComponent->SetWorldLocation(ColliderOffset + ColliderLocation);
+		ColliderPushDistance = PushDistance;
 	}
-#endif
 }
 
 void UUxtPressableButtonComponent::OnEnterFocus(UObject* Pointer)
 {
+	if (ButtonSet)
+	{
+		ButtonSet->WakeButton(this);
+	}
+
 	const bool bWasFocused = ++NumPointersFocusing > 1;
 	OnBeginFocus.Broadcast(this, Pointer, bWasFocused);
 }
@@ -194,10 +341,10 @@ void UUxtPressableButtonComponent::OnExitFocus(UObject* Pointer)
 
 	if (!bIsFocused)
 	{
-		if (bIsPressed)
+		if (IsPressed())
 		{
-			bIsPressed = false;
-			OnButtonReleased.Broadcast(this);
+			ButtonSet->SetPressed(this, false);
+			BroadcastReleased(GetPointerSampleTime(Pointer));
 		}
 	}
 
@@ -230,20 +377,42 @@ void UUxtPressableButtonComponent::OnBeginPoke_Implementation(UUxtNearPointerCom
 	Pointer->SetFocusLocked(true);
 
 	PokePointers.Add(Pointer);
+	RecordPokeCrossings(Pointer);
+	if (ButtonSet)
+	{
+		ButtonSet->WakeButton(this);
+	}
 	OnBeginPoke.Broadcast(this, Pointer);
 }
 
 void UUxtPressableButtonComponent::OnUpdatePoke_Implementation(UUxtNearPointerComponent* Pointer)
 {
+	RecordPokeCrossings(Pointer);
 	OnUpdatePoke.Broadcast(this, Pointer);
 }
 
 void UUxtPressableButtonComponent::OnEndPoke_Implementation(UUxtNearPointerComponent* Pointer)
 {
-	if (bIsPressed && NumPointersFocusing == 0)
+	// Pointers and buttons update in the same tick group, so a short tap can begin and end
+	// before the button set has seen it. Press at the sample that reached the pressed distance,
+	// the button set releases it while recovering.
+	if (ButtonSet && !IsPressed() && ButtonSet->GetPushDistance(this) < GetPressedDistance())
+	{
+		const float PreviousDistance = CalculatePushDistanceAt(Pointer->GetPreviousPokePointerSampleLocation());
+		if (PreviousDistance >= GetPressedDistance())
+		{
+			ButtonSet->WakeButton(this);
+			ButtonSet->SetPushDistance(this, PreviousDistance);
+			ButtonSet->SetPressed(this, true);
+			BroadcastPressed(PokePressedTime >= 0 ? PokePressedTime : Pointer->GetPreviousPokePointerSampleTime());
+			PokePressedTime = -1;
+		}
+	}
+
+	if (IsPressed() && NumPointersFocusing == 0)
 	{
-		bIsPressed = false;
-		OnButtonReleased.Broadcast(this);
+		ButtonSet->SetPressed(this, false);
+		BroadcastReleased(Pointer->GetPokePointerSampleTime());
 	}
 
 	// Unlock the pointer focus so that another target can be selected.
@@ -260,16 +429,26 @@ EUxtPokeBehaviour UUxtPressableButtonComponent::GetPokeBehaviour_Implementation(
 
 float UUxtPressableButtonComponent::CalculatePushDistance(const UUxtNearPointerComponent* pointer) const
 {
-	const FVector PointerPos = pointer->GetPokePointerTransform().GetLocation();
-	const FVector PointerLocal = GetComponentTransform().InverseTransformPositionNoScale(PointerPos);
-	const float EndDistance = PointerLocal.X - RestPositionLocal.X;
+	return CalculatePushDistanceAt(pointer->GetPokePointerTransform().GetLocation());
+}
+
+float UUxtPressableButtonComponent::CalculatePushDistanceAt(const FVector& PointerPos) const
+{
+	const float EndDistance = GetUnclampedPushDistanceAt(PointerPos);
 
 	return EndDistance > 0 ? FMath::Min(EndDistance, GetScaleAdjustedMaxPushDistance()) : 0;
 }
 
+float UUxtPressableButtonComponent::GetUnclampedPushDistanceAt(const FVector& PointerPos) const
+{
+	const FVector PointerLocal = GetComponentTransform().InverseTransformPositionNoScale(PointerPos);
+	return PointerLocal.X - RestPositionLocal.X;
+}
+
 FVector UUxtPressableButtonComponent::GetCurrentButtonLocation() const
 {
-	return GetRestPosition() + (GetComponentTransform().GetUnitAxis(EAxis::X) * CurrentPushDistance);
+	const float PushDistance = ButtonSet ? ButtonSet->GetPushDistance(this) : 0;
+	return GetRestPosition() + (GetComponentTransform().GetUnitAxis(EAxis::X) * PushDistance);
 }
 
 
@@ -305,29 +484,27 @@ float UUxtPressableButtonComponent::GetReleasedDistance() const
 	return GetScaleAdjustedMaxPushDistance() * ReleasedFraction;
 }
 
-void UUxtPressableButtonComponent::ConfigureBoxComponent(const UStaticMeshComponent* Mesh)
+bool UUxtPressableButtonComponent::HasValidColliderData(const USceneComponent* Visuals) const
 {
-	if (!BoxComponent)
+	if (!bHasColliderData || !Visuals)
 	{
-		UE_LOG(UXTools, Error, TEXT("Attempting to configure the box component for '%s' before it is initialised, the button will not work properly."), *GetOwner()->GetName());
-		return;
+		return false;
 	}
 
-	FVector Min, Max;
-	Mesh->GetLocalBounds(Min, Max);
+	const UStaticMeshComponent* Mesh = Cast<UStaticMeshComponent>(Visuals);
+	if (ColliderDataMesh != (Mesh ? Mesh->GetStaticMesh() : nullptr))
+	{
+		return false;
+	}
 
-	BoxComponent->SetBoxExtent((Max - Min) * 0.5f);
-	
-	FTransform BoxTransform = FTransform((Max + Min) / 2) * Mesh->GetComponentTransform();
-	BoxComponent->SetWorldTransform(BoxTransform);
+	return Visuals->GetComponentTransform().GetRelativeTransform(GetComponentTransform()).Equals(ColliderDataVisualsTransform);
+}
 
+void UUxtPressableButtonComponent::ConfigureBoxComponent()
+{
+	BoxComponent->SetBoxExtent(ColliderExtent, false);
+	BoxComponent->SetRelativeTransform(ColliderTransformLocal);
 	BoxComponent->SetCollisionProfileName(CollisionProfile);
-
-	FVector RestPosition = BoxTransform.GetLocation() - BoxTransform.GetUnitAxis(EAxis::X) * BoxComponent->GetScaledBoxExtent().X;
-	RestPositionLocal = GetComponentTransform().InverseTransformPosition(RestPosition);
-
-	const FVector ColliderOffset = BoxComponent->GetComponentLocation() - RestPosition;
-	ColliderOffsetLocal = GetComponentTransform().InverseTransformVector(ColliderOffset);
 }
 
 void UUxtPressableButtonComponent::OnExitFarFocus_Implementation(UUxtFarPointerComponent* Pointer)
@@ -339,10 +516,15 @@ void UUxtPressableButtonComponent::OnFarPressed_Implementation(UUxtFarPointerCom
 {
 	if (!FarPointerWeak.IsValid())
 	{
-		CurrentPushDistance = GetPressedDistance();
+		if (ButtonSet)
+		{
+			ButtonSet->WakeButton(this);
+			ButtonSet->SetFarPressed(this, true);
+			ButtonSet->SetPushDistance(this, GetPressedDistance());
+		}
 		FarPointerWeak = Pointer;
 		Pointer->SetFocusLocked(true);
-		OnButtonPressed.Broadcast(this);
+		BroadcastPressed(FApp::GetCurrentTime());
 	}
 }
 
@@ -351,9 +533,15 @@ void UUxtPressableButtonComponent::OnFarReleased_Implementation(UUxtFarPointerCo
 	UUxtFarPointerComponent* FarPointer = FarPointerWeak.Get();
 	if (Pointer == FarPointer)
 	{
-		CurrentPushDistance = 0;
+		if (ButtonSet)
+		{
+			// Stay awake for one more update to move the visuals back to rest.
+			ButtonSet->WakeButton(this);
+			ButtonSet->SetFarPressed(this, false);
+			ButtonSet->SetPushDistance(this, 0);
+		}
 		FarPointerWeak = nullptr;
 		Pointer->SetFocusLocked(false);
-		OnButtonReleased.Broadcast(this);
+		BroadcastReleased(FApp::GetCurrentTime());
 	}
 }
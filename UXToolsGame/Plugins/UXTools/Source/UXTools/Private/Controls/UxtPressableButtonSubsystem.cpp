@@ -0,0 +1,317 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Controls/UxtPressableButtonSubsystem.h"
+#include "Controls/UxtPressableButtonComponent.h"
+#include "Input/UxtNearPointerComponent.h"
+#include "Utils/UxtStats.h"
+
+#include <Engine/Level.h>
+#include <Engine/World.h>
+#include <Misc/App.h>
+
+void FUxtPressableButtonTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && !Target->IsPendingKill())
+	{
+		Target->UpdateButtons(DeltaTime);
+	}
+}
+
+FString FUxtPressableButtonTickFunction::DiagnosticMessage()
+{
+	return TEXT("UUxtPressableButtonSubsystem::UpdateButtons");
+}
+
+void UUxtPressableButtonSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	for (UUxtPressableButtonComponent* Button : Buttons)
+	{
+		Button->ButtonSetIndex = INDEX_NONE;
+	}
+	Buttons.Empty();
+	PushDistances.Empty();
+	PressedDistances.Empty();
+	ReleasedDistances.Empty();
+	RecoverySpeeds.Empty();
+	Flags.Empty();
+	UpdateTimes.Empty();
+	AwakeIndices.Empty();
+
+	Super::Deinitialize();
+}
+
+void UUxtPressableButtonSubsystem::RegisterButton(UUxtPressableButtonComponent* Button)
+{
+	check(Button && Button->ButtonSetIndex == INDEX_NONE);
+
+	// Buttons tick in the same group the button components used to tick in.
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Target = this;
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = false;
+		TickFunction.TickGroup = ETickingGroup::TG_PostPhysics;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	Button->ButtonSetIndex = Buttons.Add(Button);
+	PushDistances.Add(0);
+	PressedDistances.Add(Button->GetPressedDistance());
+	ReleasedDistances.Add(Button->GetReleasedDistance());
+	RecoverySpeeds.Add(Button->RecoverySpeed);
+	Flags.Add(0);
+	UpdateTimes.Add(0);
+}
+
+void UUxtPressableButtonSubsystem::UnregisterButton(UUxtPressableButtonComponent* Button)
+{
+	const int32 Index = GetIndex(Button);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	AwakeIndices.RemoveSwap(Index);
+
+	// Move the last button into the free slot to keep the arrays contiguous.
+	const int32 LastIndex = Buttons.Num() - 1;
+	if (Index != LastIndex)
+	{
+		Buttons[LastIndex]->ButtonSetIndex = Index;
+
+		const int32 AwakeLastIndex = AwakeIndices.Find(LastIndex);
+		if (AwakeLastIndex != INDEX_NONE)
+		{
+			AwakeIndices[AwakeLastIndex] = Index;
+		}
+	}
+
+	Buttons.RemoveAtSwap(Index);
+	PushDistances.RemoveAtSwap(Index);
+	PressedDistances.RemoveAtSwap(Index);
+	ReleasedDistances.RemoveAtSwap(Index);
+	RecoverySpeeds.RemoveAtSwap(Index);
+	Flags.RemoveAtSwap(Index);
+	UpdateTimes.RemoveAtSwap(Index);
+
+	Button->ButtonSetIndex = INDEX_NONE;
+
+	UpdateTickEnabled();
+}
+
+void UUxtPressableButtonSubsystem::WakeButton(UUxtPressableButtonComponent* Button)
+{
+	const int32 Index = GetIndex(Button);
+	if (Index == INDEX_NONE)
+	{
+		return;
+	}
+
+	// Settings may have been changed since the button was last awake.
+	PressedDistances[Index] = Button->GetPressedDistance();
+	ReleasedDistances[Index] = Button->GetReleasedDistance();
+	RecoverySpeeds[Index] = Button->RecoverySpeed;
+
+	if (!(Flags[Index] & Awake))
+	{
+		Flags[Index] |= Awake;
+		// Hand trackers report sample times on the FApp::GetCurrentTime clock, see IUxtHandTracker::GetSampleTime.
+		UpdateTimes[Index] = FApp::GetCurrentTime();
+		AwakeIndices.Add(Index);
+		UpdateTickEnabled();
+	}
+}
+
+float UUxtPressableButtonSubsystem::GetPushDistance(const UUxtPressableButtonComponent* Button) const
+{
+	const int32 Index = GetIndex(Button);
+	return Index != INDEX_NONE ? PushDistances[Index] : 0;
+}
+
+void UUxtPressableButtonSubsystem::SetPushDistance(const UUxtPressableButtonComponent* Button, float PushDistance)
+{
+	const int32 Index = GetIndex(Button);
+	if (Index != INDEX_NONE)
+	{
+		PushDistances[Index] = PushDistance;
+	}
+}
+
+bool UUxtPressableButtonSubsystem::IsPressed(const UUxtPressableButtonComponent* Button) const
+{
+	const int32 Index = GetIndex(Button);
+	return Index != INDEX_NONE && (Flags[Index] & Pressed) != 0;
+}
+
+void UUxtPressableButtonSubsystem::SetPressed(const UUxtPressableButtonComponent* Button, bool bPressed)
+{
+	const int32 Index = GetIndex(Button);
+	if (Index != INDEX_NONE)
+	{
+		if (bPressed)
+		{
+			Flags[Index] |= Pressed;
+		}
+		else
+		{
+			Flags[Index] &= ~Pressed;
+		}
+	}
+}
+
+void UUxtPressableButtonSubsystem::SetFarPressed(const UUxtPressableButtonComponent* Button, bool bFarPressed)
+{
+	const int32 Index = GetIndex(Button);
+	if (Index != INDEX_NONE)
+	{
+		if (bFarPressed)
+		{
+			Flags[Index] |= FarPressed;
+		}
+		else
+		{
+			Flags[Index] &= ~FarPressed;
+		}
+	}
+}
+
+void UUxtPressableButtonSubsystem::UpdateButtons(float DeltaTime)
+{
+	UXT_SCOPE_CYCLE_COUNTER(ButtonUpdate);
+
+	const int32 NumAwake = AwakeIndices.Num();
+
+	// Gather target distances from poking pointers.
+	TargetDistances.SetNumUninitialized(NumAwake, false);
+	TargetPointers.SetNumUninitialized(NumAwake, false);
+	for (int32 i = 0; i < NumAwake; ++i)
+	{
+		const int32 Index = AwakeIndices[i];
+		TargetPointers[i] = nullptr;
+		TargetDistances[i] = (Flags[Index] & FarPressed) ? 0 : Buttons[Index]->GetTargetPushDistance(TargetPointers[i]);
+	}
+
+	// Advance push distances and detect pressed/released transitions.
+	for (int32 i = 0; i < NumAwake; ++i)
+	{
+		const int32 Index = AwakeIndices[i];
+
+		// Far pointers press the button directly, keep it as is until released.
+		if (Flags[Index] & FarPressed)
+		{
+			continue;
+		}
+
+		const float TargetDistance = TargetDistances[i];
+		const UUxtNearPointerComponent* TargetPointer = TargetPointers[i];
+		const float PreviousPushDistance = PushDistances[Index];
+		check(TargetDistance >= 0);
+
+		// Times are on the hand sample clock. They come from the pointer's hand sample when a pointer drives the button,
+		// otherwise the button's time advances from its last update by the frame time, so both paths use the same clock.
+		const double PreviousTime = UpdateTimes[Index];
+		const double Time = TargetPointer ? TargetPointer->GetPokePointerSampleTime() : PreviousTime + DeltaTime;
+		UpdateTimes[Index] = Time;
+
+		if (TargetDistance > PreviousPushDistance)
+		{
+			PushDistances[Index] = TargetDistance;
+			const float PressedDistance = PressedDistances[Index];
+
+			if (!(Flags[Index] & Pressed) && TargetDistance >= PressedDistance && PreviousPushDistance < PressedDistance)
+			{
+				Flags[Index] |= Pressed;
+				const double PressTime = Buttons[Index]->PokePressedTime >= 0 ? Buttons[Index]->PokePressedTime : Time;
+				PendingEvents.Add({ Buttons[Index], true, PressTime });
+			}
+		}
+		else
+		{
+			const float PushDistance = FMath::Max(TargetDistance, PreviousPushDistance - DeltaTime * RecoverySpeeds[Index]);
+			PushDistances[Index] = PushDistance;
+			const float ReleasedDistance = ReleasedDistances[Index];
+
+			// Raise button released if we're pressed and crossed the released distance
+			if ((Flags[Index] & Pressed) && PushDistance <= ReleasedDistance && PreviousPushDistance > ReleasedDistance)
+			{
+				Flags[Index] &= ~Pressed;
+
+				// Either the pointer pulled the button back or it recovered on its own.
+				double ReleaseTime = Time;
+				if (TargetPointer && PushDistance == TargetDistance && Buttons[Index]->PokeReleasedTime >= 0)
+				{
+					ReleaseTime = Buttons[Index]->PokeReleasedTime;
+				}
+				else if (RecoverySpeeds[Index] > 0)
+				{
+					ReleaseTime = FMath::Min(Time, PreviousTime + (PreviousPushDistance - ReleasedDistance) / RecoverySpeeds[Index]);
+				}
+				PendingEvents.Add({ Buttons[Index], false, ReleaseTime });
+			}
+		}
+	}
+
+	// Crossings recorded by pointers have been used.
+	for (int32 i = 0; i < NumAwake; ++i)
+	{
+		UUxtPressableButtonComponent* Button = Buttons[AwakeIndices[i]];
+		Button->PokePressedTime = -1;
+		Button->PokeReleasedTime = -1;
+	}
+
+	// Move visuals of awake buttons.
+	for (int32 i = 0; i < NumAwake; ++i)
+	{
+		Buttons[AwakeIndices[i]]->UpdateVisuals();
+	}
+
+	// Put buttons to sleep once they are at rest and no pointer interacts with them.
+	for (int32 i = NumAwake - 1; i >= 0; --i)
+	{
+		const int32 Index = AwakeIndices[i];
+		const UUxtPressableButtonComponent* Button = Buttons[Index];
+		if (PushDistances[Index] == 0 && !(Flags[Index] & FarPressed) && Button->NumPointersFocusing == 0 && Button->PokePointers.Num() == 0)
+		{
+			Flags[Index] &= ~Awake;
+			AwakeIndices.RemoveAtSwap(i, 1, false);
+		}
+	}
+	UpdateTickEnabled();
+
+	// Raise events last, handlers may add or remove buttons.
+	TArray<FPendingEvent> Events = MoveTemp(PendingEvents);
+	for (const FPendingEvent& Event : Events)
+	{
+		if (UUxtPressableButtonComponent* Button = Event.Button.Get())
+		{
+			if (Event.bPressed)
+			{
+				Button->BroadcastPressed(Event.Time);
+			}
+			else
+			{
+				Button->BroadcastReleased(Event.Time);
+			}
+		}
+	}
+}
+
+int32 UUxtPressableButtonSubsystem::GetIndex(const UUxtPressableButtonComponent* Button) const
+{
+	const int32 Index = Button->ButtonSetIndex;
+	return (Buttons.IsValidIndex(Index) && Buttons[Index] == Button) ? Index : INDEX_NONE;
+}
+
+void UUxtPressableButtonSubsystem::UpdateTickEnabled()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.SetTickFunctionEnable(AwakeIndices.Num() > 0);
+	}
+}
@@ -5,9 +5,29 @@
 #include "Engine/StaticMesh.h"
 #include "Components/StaticMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "Engine/World.h"
 #include "GameFramework/Actor.h"
-#include "UObject/ConstructorHelpers.h"
+#include "Input/UxtPointerDataSubsystem.h"
+#include "Utils/UxtDefaultAssets.h"
 
+namespace
+{
+	const FName InvRadiusParameter = "InvRadius";
+	const FName InnerRadiusParameter = "InnerRadius";
+	const FName BorderThicknessParameter = "BorderThickness";
+	const FName RingColorParameter = "RingColor";
+	const FName BorderColorParameter = "BorderColor";
+
+	// Custom primitive data layout, see UUxtRingCursorComponent::bUseCustomPrimitiveData
+	const int32 InvRadiusDataIndex = 0;
+	const int32 InnerRadiusDataIndex = 1;
+	const int32 BorderThicknessDataIndex = 2;
+	const int32 RingColorDataIndex = 3;
+	const int32 BorderColorDataIndex = 7;
+
+	// Relative change below which scalar parameters are not written, each write marks the render state dirty
+	const float ScalarParameterTolerance = 1.0e-3f;
+}
 
 UUxtRingCursorComponent::UUxtRingCursorComponent()
 {
@@ -17,20 +37,71 @@ UUxtRingCursorComponent::UUxtRingCursorComponent()
 	// Used to update material parameters in response to scale changes
 	bWantsOnUpdateTransform = true;
 
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> MeshFinder(TEXT("/UXTools/Pointers/SM_UnitQuad"));
-	check(MeshFinder.Object);
-	SetStaticMesh(MeshFinder.Object);
-
-	static ConstructorHelpers::FObjectFinder<UMaterialInterface> MaterialFinder(TEXT("/UXTools/Pointers/M_RingCursor"));
-	check(MaterialFinder.Object);
-	SetMaterial(0, MaterialFinder.Object);
+	// Default mesh and material are loaded asynchronously and applied on register, see FUxtDefaultAssets
 }
 
 void UUxtRingCursorComponent::OnRegister()
 {
 	Super::OnRegister();
 
-	MaterialInstance = CreateDynamicMaterialInstance(0, GetMaterial(0));
+	FUxtDefaultAssets& DefaultAssets = FUxtDefaultAssets::Get();
+	if (DefaultAssets.IsLoaded())
+	{
+		ApplyDefaultAssets();
+	}
+	else
+	{
+		// Parameters have to be written again for the new material
+		DefaultAssets.CallWhenLoaded(this, [this]
+			{
+				if (ApplyDefaultAssets() && IsRegistered())
+				{
+					InitializeMaterialParameters();
+				}
+			});
+	}
+
+	InitializeMaterialParameters();
+}
+
+bool UUxtRingCursorComponent::ApplyDefaultAssets()
+{
+	bool bChanged = false;
+
+	if (!GetStaticMesh())
+	{
+		bChanged |= SetStaticMesh(FUxtDefaultAssets::Get().GetRingCursorMesh());
+	}
+
+	if (OverrideMaterials.Num() == 0 || !OverrideMaterials[0])
+	{
+		if (UMaterialInterface* Material = FUxtDefaultAssets::Get().GetRingCursorMaterial())
+		{
+			SetMaterial(0, Material);
+			bChanged = true;
+		}
+	}
+
+	return bChanged;
+}
+
+void UUxtRingCursorComponent::InitializeMaterialParameters()
+{
+	if (!bUseCustomPrimitiveData)
+	{
+		MaterialInstance = CreateDynamicMaterialInstance(0, GetMaterial(0));
+
+		// Lets ring materials highlight the pointers around the cursor
+		if (UUxtPointerDataSubsystem* PointerData = GetWorld() ? GetWorld()->GetSubsystem<UUxtPointerDataSubsystem>() : nullptr)
+		{
+			PointerData->BindMaterial(MaterialInstance);
+		}
+	}
+
+	// Force all parameters to be written
+	InvRadiusValue = MAX_flt;
+	InnerRadiusValue = MAX_flt;
+	BorderThicknessValue = MAX_flt;
 
 	// Intialize radius from current scale
 	OnUpdateTransform(EUpdateTransformFlags::None);
@@ -58,34 +129,14 @@ void UUxtRingCursorComponent::OnUpdateTransform(EUpdateTransformFlags UpdateTran
 
 void UUxtRingCursorComponent::SetRingThickness(float NewRingThickness)
 {
-	static FName InnerRadiusParameter = "InnerRadius";
-
-	if (bUseAbsoluteThickness)
-	{
-		MaterialInstance->SetScalarParameterValue(InnerRadiusParameter, 1.0f - (NewRingThickness / Radius));
-	}
-	else
-	{
-		MaterialInstance->SetScalarParameterValue(InnerRadiusParameter, 1.0f - NewRingThickness);
-	}
-	
 	RingThickness = NewRingThickness;
+	UpdateThicknessParameters();
 }
 
 void UUxtRingCursorComponent::SetBorderThickness(float NewBorderThickness)
 {
-	static FName BorderThicknessParameter = "BorderThickness";
-
-	if (bUseAbsoluteThickness)
-	{
-		MaterialInstance->SetScalarParameterValue(BorderThicknessParameter, NewBorderThickness / Radius);
-	}
-	else
-	{
-		MaterialInstance->SetScalarParameterValue(BorderThicknessParameter, NewBorderThickness);
-	}
-
 	BorderThickness = NewBorderThickness;
+	UpdateThicknessParameters();
 }
 
 void UUxtRingCursorComponent::SetUseAbsoluteThickness(bool bNewUsingAboluteThickness)
@@ -93,22 +144,19 @@ void UUxtRingCursorComponent::SetUseAbsoluteThickness(bool bNewUsingAboluteThick
 	if (bNewUsingAboluteThickness != bUseAbsoluteThickness)
 	{
 		bUseAbsoluteThickness = bNewUsingAboluteThickness;
-		SetRingThickness(RingThickness);
-		SetBorderThickness(BorderThickness);
+		UpdateThicknessParameters();
 	}
 }
 
 void UUxtRingCursorComponent::SetRingColor(FColor NewRingColor)
 {
-	static FName RingColorParameter = "RingColor";
-	MaterialInstance->SetVectorParameterValue(RingColorParameter, NewRingColor);
+	SetColorParameter(RingColorDataIndex, RingColorParameter, NewRingColor);
 	RingColor = NewRingColor;
 }
 
 void UUxtRingCursorComponent::SetBorderColor(FColor NewBorderColor)
 {
-	static FName BorderColorParameter = "BorderColor";
-	MaterialInstance->SetVectorParameterValue(BorderColorParameter, NewBorderColor);
+	SetColorParameter(BorderColorDataIndex, BorderColorParameter, NewBorderColor);
 	BorderColor = NewBorderColor;
 }
 
@@ -128,12 +176,56 @@ void UUxtRingCursorComponent::SetRadius(float NewRadius, bool bUpdateScale)
 		bSettingRadius = false;
 	}
 
-	static FName RadiusParameter = "InvRadius";
-	MaterialInstance->SetScalarParameterValue(RadiusParameter, 1.0f / Radius);
+	SetScalarParameter(InvRadiusDataIndex, InvRadiusParameter, 1.0f / Radius, InvRadiusValue);
 
 	if (bUseAbsoluteThickness)
 	{
-		SetRingThickness(RingThickness);
-		SetBorderThickness(BorderThickness);
+		UpdateThicknessParameters();
+	}
+}
+
+void UUxtRingCursorComponent::UpdateThicknessParameters()
+{
+	if (bUseAbsoluteThickness)
+	{
+		SetScalarParameter(InnerRadiusDataIndex, InnerRadiusParameter, 1.0f - (RingThickness / Radius), InnerRadiusValue);
+		SetScalarParameter(BorderThicknessDataIndex, BorderThicknessParameter, BorderThickness / Radius, BorderThicknessValue);
+	}
+	else
+	{
+		SetScalarParameter(InnerRadiusDataIndex, InnerRadiusParameter, 1.0f - RingThickness, InnerRadiusValue);
+		SetScalarParameter(BorderThicknessDataIndex, BorderThicknessParameter, BorderThickness, BorderThicknessValue);
 	}
-}
\ No newline at end of file
+}
+
+void UUxtRingCursorComponent::SetScalarParameter(int32 DataIndex, FName ParameterName, float Value, float& CurrentValue)
+{
+	if (FMath::Abs(Value - CurrentValue) <= ScalarParameterTolerance * FMath::Abs(CurrentValue))
+	{
+		return;
+	}
+
+	if (bUseCustomPrimitiveData)
+	{
+		SetCustomPrimitiveDataFloat(DataIndex, Value);
+		CurrentValue = Value;
+	}
+	else if (MaterialInstance)
+	{
+		MaterialInstance->SetScalarParameterValue(ParameterName, Value);
+		CurrentValue = Value;
+	}
+}
+
+void UUxtRingCursorComponent::SetColorParameter(int32 DataIndex, FName ParameterName, FColor Color)
+{
+	if (bUseCustomPrimitiveData)
+	{
+		const FLinearColor LinearColor(Color);
+		SetCustomPrimitiveDataVector4(DataIndex, FVector4(LinearColor.R, LinearColor.G, LinearColor.B, LinearColor.A));
+	}
+	else if (MaterialInstance)
+	{
+		MaterialInstance->SetVectorParameterValue(ParameterName, Color);
+	}
+}
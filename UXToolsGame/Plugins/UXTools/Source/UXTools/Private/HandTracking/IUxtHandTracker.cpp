@@ -4,6 +4,14 @@
 #include "HandTracking/IUxtHandTracker.h"
 #include "Features/IModularFeatures.h"
 
+#if WITH_DEV_AUTOMATION_TESTS
+namespace
+{
+	/** Hand tracker of the innermost FUxtHandTrackerScope on this thread. */
+	thread_local IUxtHandTracker* ScopedHandTracker = nullptr;
+}
+#endif
+
 FName IUxtHandTracker::GetModularFeatureName()
 {
 	static FName FeatureName = FName(TEXT("UxtHandTracker"));
@@ -12,6 +20,13 @@ FName IUxtHandTracker::GetModularFeatureName()
 
 IUxtHandTracker* IUxtHandTracker::GetHandTracker()
 {
+#if WITH_DEV_AUTOMATION_TESTS
+	if (ScopedHandTracker)
+	{
+		return ScopedHandTracker;
+	}
+#endif
+
 	IModularFeatures& Features = IModularFeatures::Get();
 	FName FeatureName = GetModularFeatureName();
 
@@ -21,4 +36,19 @@ IUxtHandTracker* IUxtHandTracker::GetHandTracker()
 	}
 
 	return nullptr;
-}
\ No newline at end of file
+}
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+FUxtHandTrackerScope::FUxtHandTrackerScope(IUxtHandTracker* HandTracker)
+	: PreviousHandTracker(ScopedHandTracker)
+{
+	ScopedHandTracker = HandTracker;
+}
+
+FUxtHandTrackerScope::~FUxtHandTrackerScope()
+{
+	ScopedHandTracker = PreviousHandTracker;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -3,6 +3,7 @@
 
 #include "HandTracking/UxtHandTrackingFunctionLibrary.h"
 #include "Features/IModularFeatures.h"
+#include "Misc/App.h"
 
 
 bool UUxtHandTrackingFunctionLibrary::GetHandJointState(EControllerHand Hand, EUxtHandJoint Joint, FQuat& OutOrientation, FVector& OutPosition, float& OutRadius)
@@ -49,4 +50,18 @@ bool UUxtHandTrackingFunctionLibrary::IsHandTracked(EControllerHand Hand)
 {
 	bool NotUsed = false;
 	return GetIsHandGrabbing(Hand, NotUsed);
-}
\ No newline at end of file
+}
+
+double UUxtHandTrackingFunctionLibrary::GetHandSampleTime(EControllerHand Hand)
+{
+	double Time;
+	if (IUxtHandTracker* HandTracker = IUxtHandTracker::GetHandTracker())
+	{
+		if (HandTracker->GetSampleTime(Hand, Time))
+		{
+			return Time;
+		}
+	}
+
+	return FApp::GetCurrentTime();
+}
@@ -8,7 +8,9 @@
 #include "Interactions/UxtFarTarget.h"
 #include "Components/PrimitiveComponent.h"
 #include "HandTracking/UxtHandTrackingFunctionLibrary.h"
+#include "Utils/UxtFlightRecorder.h"
 #include "Utils/UxtFunctionLibrary.h"
+#include "Utils/UxtStats.h"
 
 
 UUxtFarPointerComponent::UUxtFarPointerComponent()
@@ -31,6 +33,8 @@ void UUxtFarPointerComponent::SetActive(bool bNewActive, bool bReset)
 
 void UUxtFarPointerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	UXT_SCOPE_CYCLE_COUNTER(FarPointerTick);
+
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
 	// Obtain new pointer origin and orientation
@@ -57,11 +61,17 @@ static UObject* FindFarTarget(UPrimitiveComponent* Primitive)
 {
 	if (Primitive)
 	{
+		UXT_SCOPE_CYCLE_COUNTER(FocusResolution);
+
 		for (UActorComponent* Component : Primitive->GetOwner()->GetComponents())
 		{
-			if (Component->Implements<UUxtFarTarget>() && IUxtFarTarget::Execute_IsFarFocusable(Component, Primitive))
+			if (Component->Implements<UUxtFarTarget>())
 			{
-				return Component;
+				UXT_INC_COUNTER(TargetsEvaluated, 1);
+				if (IUxtFarTarget::Execute_IsFarFocusable(Component, Primitive))
+				{
+					return Component;
+				}
 			}
 		}
 	}
@@ -74,6 +84,8 @@ void UUxtFarPointerComponent::OnPointerPoseUpdated(const FQuat& NewOrientation,
 	PointerOrientation = NewOrientation;
 	PointerOrigin = NewOrigin;
 
+	FUxtFlightRecorder::Get().Record(EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Far, this, nullptr, PointerOrigin);
+
 	UPrimitiveComponent* OldPrimitive = GetHitPrimitive();
 	UPrimitiveComponent* NewPrimitive;
 
@@ -102,7 +114,11 @@ void UUxtFarPointerComponent::OnPointerPoseUpdated(const FQuat& NewOrientation,
 		const auto Forward = PointerOrientation.GetForwardVector();
 		FVector Start = PointerOrigin + Forward * RayStartOffset;
 		FVector End = Start + Forward * RayLength;
-		GetWorld()->LineTraceSingleByChannel(Hit, Start, End, TraceChannel);
+		{
+			UXT_SCOPE_CYCLE_COUNTER(FarPointerQuery);
+			UXT_INC_COUNTER(SceneQueries, 1);
+			GetWorld()->LineTraceSingleByChannel(Hit, Start, End, TraceChannel);
+		}
 
 		NewPrimitive = Hit.GetComponent();
 
@@ -113,6 +129,9 @@ void UUxtFarPointerComponent::OnPointerPoseUpdated(const FQuat& NewOrientation,
 			{
 				if (UObject* FarTarget = GetFarTarget())
 				{
+					FUxtFlightRecorder::Get().Record(EUxtFlightEventType::FocusExit, EUxtFlightInteraction::Far, this, FarTarget, HitPoint);
+
+					UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
 					IUxtFarTarget::Execute_OnExitFarFocus(FarTarget, this);
 				}
 			}
@@ -140,6 +159,8 @@ void UUxtFarPointerComponent::OnPointerPoseUpdated(const FQuat& NewOrientation,
 	{
 		if (UObject* FarTarget = GetFarTarget())
 		{
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+
 			// Focus events
 			if (NewPrimitive == OldPrimitive)
 			{
@@ -147,6 +168,7 @@ void UUxtFarPointerComponent::OnPointerPoseUpdated(const FQuat& NewOrientation,
 			}
 			else
 			{
+				FUxtFlightRecorder::Get().Record(EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Far, this, FarTarget, HitPoint);
 				IUxtFarTarget::Execute_OnEnterFarFocus(FarTarget, this);
 			}
 
@@ -165,8 +187,13 @@ void UUxtFarPointerComponent::SetPressed(bool bNewPressed)
 	{
 		bPressed = bNewPressed;
 
+		FUxtFlightRecorder::Get().Record(
+			bPressed ? EUxtFlightEventType::FarPressed : EUxtFlightEventType::FarReleased, EUxtFlightInteraction::Far, this, GetFarTarget(), HitPoint);
+
 		if (UObject* FarTarget = GetFarTarget())
 		{
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+
 			if (bPressed)
 			{
 				IUxtFarTarget::Execute_OnFarPressed(FarTarget, this);
@@ -197,6 +224,7 @@ void UUxtFarPointerComponent::SetEnabled(bool bNewEnabled)
 			// Raise focus exit on the current target
 			if (UObject* FarTarget = GetFarTarget())
 			{
+				FUxtFlightRecorder::Get().Record(EUxtFlightEventType::FocusExit, EUxtFlightInteraction::Far, this, FarTarget, HitPoint);
 				IUxtFarTarget::Execute_OnExitFarFocus(FarTarget, this);
 			}
 
@@ -5,16 +5,15 @@
 #include "Input/UxtHandInteractionActor.h"
 #include "Input/UxtNearPointerComponent.h"
 #include "Input/UxtFarPointerComponent.h"
+#include "Input/UxtPointerDataSubsystem.h"
 #include "Controls/UxtFingerCursorComponent.h"
 #include "Controls/UxtFarCursorComponent.h"
 #include "Controls/UxtFarBeamComponent.h"
 #include "HandTracking/IUxtHandTracker.h"
 #include "Interactions/UxtGrabTarget.h"
 #include "Interactions/UxtPokeTarget.h"
-#include "UObject/ConstructorHelpers.h"
-#include "Materials/MaterialParameterCollection.h"
-#include "Materials/MaterialParameterCollectionInstance.h"
 #include "UXTools.h"
+#include "Utils/UxtStats.h"
 
 
 AUxtHandInteractionActor::AUxtHandInteractionActor(const FObjectInitializer& ObjectInitializer)
@@ -31,10 +30,6 @@ AUxtHandInteractionActor::AUxtHandInteractionActor(const FObjectInitializer& Obj
 	FarPointer = CreateDefaultSubobject<UUxtFarPointerComponent>(TEXT("FarPointer"));
 	FarPointer->PrimaryComponentTick.bStartWithTickEnabled = false;
 	FarPointer->AddTickPrerequisiteActor(this);
-
-	static ConstructorHelpers::FObjectFinder<UMaterialParameterCollection> Finder(TEXT("/UXTools/Pointers/PointerPositions"));
-	check(Finder.Object);
-	ParameterCollection = Finder.Object;
 }
 
 // Called when the game starts or when spawned
@@ -42,6 +37,8 @@ void AUxtHandInteractionActor::BeginPlay()
 {
 	Super::BeginPlay();
 
+	UXT_SCOPE_BEGIN_PLAY_COST(HandInteractionBeginPlay);
+
 	// Apply actor settings to pointers
 	NearPointer->Hand = Hand;
 	NearPointer->TraceChannel = TraceChannel;
@@ -71,6 +68,24 @@ void AUxtHandInteractionActor::BeginPlay()
 		FarBeam->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
 		FarBeam->RegisterComponent();
 	}
+
+	PointerData = GetWorld()->GetSubsystem<UUxtPointerDataSubsystem>();
+	if (PointerData)
+	{
+		PointerDataSlot = PointerData->AddPointer();
+	}
+}
+
+void AUxtHandInteractionActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (PointerData)
+	{
+		PointerData->RemovePointer(PointerDataSlot);
+		PointerData = nullptr;
+		PointerDataSlot = INDEX_NONE;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 // Returns true if the given primitive is part of a near target
@@ -101,19 +116,6 @@ void AUxtHandInteractionActor::Tick(float DeltaTime)
 
 		if (bIsTracked)
 		{
-			// Update finger tip position in material parameter collection
-			if (ParameterCollection)
-			{
-				UMaterialParameterCollectionInstance* ParameterCollectionInstance = GetWorld()->GetParameterCollectionInstance(ParameterCollection);
-				static FName ParameterNames[] = { "LeftPointerPosition", "RightPointerPosition" };
-				FName ParameterName = Hand == EControllerHand::Left ? ParameterNames[0] : ParameterNames[1];
-				const bool bFoundParameter = ParameterCollectionInstance->SetVectorParameterValue(ParameterName, FingerTipPosition);
-				if (!bFoundParameter)
-				{
-					UE_LOG(UXTools, Warning, TEXT("Unable to find %s parameter in material parameter collection %s."), *ParameterName.ToString(), *ParameterCollection->GetPathName());
-				}
-			}
-
 			const FVector Forward = FingerTipOrientation.GetForwardVector();
 			const FVector FingerTipPositionOnSkin = FingerTipPosition + Forward * JointRadius;
 
@@ -128,7 +130,11 @@ void AUxtHandInteractionActor::Tick(float DeltaTime)
 				// Disable complex collision to enable overlap from inside primitives
 				FCollisionQueryParams QueryParams(NAME_None, false);
 				FCollisionShape QuerySphere = FCollisionShape::MakeSphere(SphereRadius);
-				GetWorld()->SweepMultiByChannel(Overlaps, PrevQueryPosition, QueryPosition, FQuat::Identity, TraceChannel, QuerySphere, QueryParams);
+				{
+					UXT_SCOPE_CYCLE_COUNTER(HandProximityQuery);
+					UXT_INC_COUNTER(SceneQueries, 1);
+					GetWorld()->SweepMultiByChannel(Overlaps, PrevQueryPosition, QueryPosition, FQuat::Identity, TraceChannel, QuerySphere, QueryParams);
+				}
 
 				// Look for a near target in the overlaps
 				bool bHasNearTarget = false;
@@ -155,6 +161,21 @@ void AUxtHandInteractionActor::Tick(float DeltaTime)
 
 			bHadTracking = true;
 			PrevQueryPosition = QueryPosition;
+
+			// Publish the finger tip, the buffer is written once per frame for all pointers.
+			if (PointerData)
+			{
+				EUxtPointerDataFlags Flags = EUxtPointerDataFlags::Tracked;
+				if (NearPointer->IsActive())
+				{
+					Flags |= EUxtPointerDataFlags::Near;
+				}
+				if (FarPointer->IsActive())
+				{
+					Flags |= EUxtPointerDataFlags::Far;
+				}
+				PointerData->UpdatePointer(PointerDataSlot, Hand, FingerTipPosition, JointRadius, Flags);
+			}
 		}
 		else
 		{
@@ -169,6 +190,12 @@ void AUxtHandInteractionActor::Tick(float DeltaTime)
 			{
 				FarPointer->SetActive(false);
 			}
+
+			// Keep the last position so that highlights do not jump.
+			if (PointerData)
+			{
+				PointerData->SetPointerFlags(PointerDataSlot, EUxtPointerDataFlags::None);
+			}
 		}
 	}
 }
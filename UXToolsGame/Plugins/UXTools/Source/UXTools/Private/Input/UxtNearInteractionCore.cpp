@@ -0,0 +1,124 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Input/UxtNearInteractionCore.h"
+
+void FUxtFocusCore::SetFocus(FUxtTargetId NewTarget, FUxtTargetId NewPrimitive, const FVector& NewClosestPoint, IUxtFocusListener& Listener)
+{
+	// If focused target is unchanged, then update only the closest-point-on-target
+	if (NewTarget == Target && NewPrimitive == Primitive)
+	{
+		ClosestPoint = NewClosestPoint;
+		return;
+	}
+
+	if (Target)
+	{
+		Listener.OnExitFocus(Target);
+	}
+
+	Target = NewTarget;
+	Primitive = NewPrimitive;
+	ClosestPoint = NewClosestPoint;
+	Listener.OnFocusChanged(Target, Primitive);
+
+	if (Target)
+	{
+		Listener.OnEnterFocus(Target);
+	}
+}
+
+void FUxtFocusCore::ClearFocus(IUxtFocusListener& Listener)
+{
+	// Nothing to clear, avoid notifying listeners every frame
+	if (!Target && !Primitive)
+	{
+		return;
+	}
+
+	if (Target)
+	{
+		Listener.OnExitFocus(Target);
+	}
+
+	Target = 0;
+	Primitive = 0;
+	ClosestPoint = FVector::ZeroVector;
+	Listener.OnFocusChanged(0, 0);
+}
+
+void FUxtFocusCore::BeginGrab(IUxtFocusListener& Listener)
+{
+	if (Target)
+	{
+		Listener.OnBeginGrab(Target);
+	}
+
+	bIsGrabbing = true;
+}
+
+void FUxtFocusCore::EndGrab(IUxtFocusListener& Listener)
+{
+	bIsGrabbing = false;
+
+	if (Target)
+	{
+		Listener.OnEndGrab(Target);
+	}
+}
+
+void FUxtPokeCore::Update(const FInput& Input, const IUxtPokeGeometry& Geometry, IUxtPokeListener& Listener)
+{
+	if (bIsPoking)
+	{
+		if (Input.Primitive && Input.Target)
+		{
+			const bool bEndedPoking = Geometry.IsFrontFacePokable(Input.Target) ?
+				Geometry.IsFrontFacePokeEnded(Input.Primitive, Input.Location, Input.Radius, Input.Depth) :
+				!Geometry.IsOverlapping(Input.Primitive, Input.Location, Input.Radius);
+
+			if (bEndedPoking)
+			{
+				bIsPoking = false;
+				Listener.OnEndPoke(Input.Target);
+
+				bWasBehindFrontFace = Geometry.IsBehindFrontFace(Input.Primitive, Input.Location, Input.Radius);
+			}
+			else
+			{
+				Listener.OnUpdatePoke(Input.Target);
+			}
+		}
+		else
+		{
+			// Target or primitive has been removed while poking
+			bIsPoking = false;
+			Listener.OnPokeTargetLost(Input.Target);
+
+			bWasBehindFrontFace = false;
+		}
+	}
+	else if (Input.Target)
+	{
+		bool bIsBehind = bWasBehindFrontFace;
+		if (Input.Primitive)
+		{
+			bIsBehind = Geometry.IsBehindFrontFace(Input.Primitive, Input.Location, Input.Radius);
+		}
+
+		if (Geometry.Sweep(PreviousLocation, Input.Location, Input.Radius) == Input.Primitive)
+		{
+			const bool bStartedPoking = Geometry.IsFrontFacePokable(Input.Target) ? (!bWasBehindFrontFace && bIsBehind) : true;
+
+			if (bStartedPoking)
+			{
+				bIsPoking = true;
+				Listener.OnBeginPoke(Input.Target);
+			}
+		}
+
+		bWasBehindFrontFace = bIsBehind;
+	}
+
+	PreviousLocation = Input.Location;
+}
@@ -6,6 +6,9 @@
 #include "Interactions/UxtGrabTarget.h"
 #include "Interactions/UxtPokeTarget.h"
 #include "HandTracking/UxtHandTrackingFunctionLibrary.h"
+#include "Utils/UxtFlightRecorder.h"
+#include "Utils/UxtMathKernels.h"
+#include "Utils/UxtStats.h"
 
 #include "Engine/World.h"
 #include "Components/PrimitiveComponent.h"
@@ -13,69 +16,109 @@
 
 namespace
 {
-	/**
-	 * Used for checking on which side of a front face pokable's front face the pointer
-	 * sphere is. This is important as BeginPoke can only be called if the pointer sphere
-	 * was not behind in the previous tick and is now behind in this tick.
-	 * 
-	 * This function assumes that the given primitive has a box collider.
-	 */
-	bool IsBehindFrontFace(UPrimitiveComponent* Primitive, FVector PointerPosition, float Radius)
+	/** Resolves poke core queries and transitions to the focused poke target of a near pointer. */
+	struct FPokeAdapter : public IUxtPokeGeometry, public IUxtPokeListener
 	{
-		check(Primitive != nullptr);
+		FPokeAdapter(UUxtNearPointerComponent* InPointer, ECollisionChannel InTraceChannel, UActorComponent* InTarget, UPrimitiveComponent* InPrimitive, const FVector& InLocation)
+			: Pointer(InPointer), TraceChannel(InTraceChannel), Target(InTarget), Primitive(InPrimitive), Location(InLocation)
+		{
+		}
 
-		// Front face pokables should have use a box collider
-		check(Primitive->GetCollisionShape().IsBox());
+		virtual bool IsFrontFacePokable(FUxtTargetId TargetId) const override
+		{
+			return IUxtPokeTarget::Execute_GetPokeBehaviour(Target) == EUxtPokeBehaviour::FrontFace;
+		}
 
-		auto ComponentTransform = Primitive->GetComponentTransform().ToMatrixNoScale();
-		
-		FVector LocalPosition = ComponentTransform.InverseTransformPosition(PointerPosition);
+		/**
+		 * Used for checking on which side of a front face pokable's front face the pointer
+		 * sphere is. This is important as BeginPoke can only be called if the pointer sphere
+		 * was not behind in the previous tick and is now behind in this tick.
+		 *
+		 * This function assumes that the given primitive has a box collider.
+		 */
+		virtual bool IsBehindFrontFace(FUxtTargetId PrimitiveId, const FVector& PointerPosition, float Radius) const override
+		{
+			check(Primitive != nullptr);
 
-		FVector Extents = Primitive->GetCollisionShape().GetExtent();
+			// Front face pokables should have use a box collider
+			check(Primitive->GetCollisionShape().IsBox());
 
-		if (LocalPosition.X + Radius > -Extents.X)
-		{
-			return true;
+			return FUxtMathKernels::IsBehindFrontFace(Primitive->GetComponentTransform(), Primitive->GetCollisionShape().GetExtent(), PointerPosition, Radius);
 		}
 
-		return false;
-	}
+		/**
+		 * Used to determine whether if poke has ended with a front face pokable. A poke
+		 * ends if:
+		 * - The pointer sphere moves back in front of the front face of the pokable
+		 * - The pointer spher moves left/right/up/down beyond the pokable primitive
+		 *   extents
+		 * - The perpendicular distance from the pointer sphere to the front face exceeds the
+		 *   given depth.
+		 *
+		 * This function assumes that the given primitive has a box collider.
+		 */
+		virtual bool IsFrontFacePokeEnded(FUxtTargetId PrimitiveId, const FVector& PointerPosition, float Radius, float Depth) const override
+		{
+			check(Primitive != nullptr);
 
-	/** 
-	 * Used to determine whether if poke has ended with a front face pokable. A poke
-	 * ends if:
-	 * - The pointer sphere moves back in front of the front face of the pokable
-	 * - The pointer spher moves left/right/up/down beyond the pokable primitive
-	 *   extents
-	 * - The perpendicular distance from the pointer sphere to the front face exceeds the
-	 *   given depth.
-	 *
-	 * This function assumes that the given primitive has a box collider.
-	 */
-	bool IsFrontFacePokeEnded(UPrimitiveComponent* Primitive, FVector PointerPosition, float Radius, float Depth)
-	{
-		check(Primitive != nullptr);
+			// Front face pokables should have use a box collider
+			check(Primitive->GetCollisionShape().IsBox());
 
-		// Front face pokables should have use a box collider
-		check(Primitive->GetCollisionShape().IsBox());
+			return FUxtMathKernels::IsFrontFacePokeEnded(Primitive->GetComponentTransform(), Primitive->GetCollisionShape().GetExtent(), PointerPosition, Radius, Depth);
+		}
 
-		auto ComponentTransform = Primitive->GetComponentTransform().ToMatrixNoScale();
+		virtual bool IsOverlapping(FUxtTargetId PrimitiveId, const FVector& PointerPosition, float Radius) const override
+		{
+			return Primitive->OverlapComponent(PointerPosition, FQuat::Identity, FCollisionShape::MakeSphere(Radius));
+		}
+
+		virtual FUxtTargetId Sweep(const FVector& Start, const FVector& End, float Radius) const override
+		{
+			FHitResult HitResult;
+			{
+				UXT_SCOPE_CYCLE_COUNTER(NearPointerQuery);
+				UXT_INC_COUNTER(SceneQueries, 1);
+				Pointer->GetWorld()->SweepSingleByChannel(HitResult, Start, End, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(Radius));
+			}
+			return FUxtPointerFocus::GetTargetId(HitResult.GetComponent());
+		}
+
+		virtual void OnBeginPoke(FUxtTargetId TargetId) override
+		{
+			FUxtFlightRecorder::Get().Record(EUxtFlightEventType::PokeBegin, EUxtFlightInteraction::Poke, Pointer, Target, Location);
 
-		FVector LocalPosition = ComponentTransform.InverseTransformPosition(PointerPosition);
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+			IUxtPokeTarget::Execute_OnBeginPoke(Target, Pointer);
+		}
 
-		FVector Extents = Primitive->GetCollisionShape().GetExtent();
+		virtual void OnUpdatePoke(FUxtTargetId TargetId) override
+		{
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+			IUxtPokeTarget::Execute_OnUpdatePoke(Target, Pointer);
+		}
 
-		FVector Min = -Extents;
+		virtual void OnEndPoke(FUxtTargetId TargetId) override
+		{
+			FUxtFlightRecorder::Get().Record(EUxtFlightEventType::PokeEnd, EUxtFlightInteraction::Poke, Pointer, Target, Location);
 
-		FVector Max = Extents;
-		Max.X = -Max.X + Depth; // depth is measured from the front face
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+			IUxtPokeTarget::Execute_OnEndPoke(Target, Pointer);
+		}
 
-		FBox PokableVolume(Min, Max);
-		FSphere PokeSphere(LocalPosition, Radius);
+		virtual void OnPokeTargetLost(FUxtTargetId TargetId) override
+		{
+			Pointer->SetFocusLocked(false);
+			FUxtFlightRecorder::Get().Record(EUxtFlightEventType::PokeEnd, EUxtFlightInteraction::Poke, Pointer, Target, Location);
+		}
 
-		return !FMath::SphereAABBIntersection(PokeSphere, PokableVolume);
-	}
+		UUxtNearPointerComponent* Pointer;
+		ECollisionChannel TraceChannel;
+		UActorComponent* Target;
+		UPrimitiveComponent* Primitive;
+		FVector Location;
+	};
 }
+
 UUxtNearPointerComponent::UUxtNearPointerComponent()
 {
 	PrimaryComponentTick.bCanEverTick = true;
@@ -135,9 +178,18 @@ static FTransform CalcPokePointerTransform(EControllerHand Hand)
 
 void UUxtNearPointerComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+	UXT_SCOPE_CYCLE_COUNTER(NearPointerTick);
+
+	// Keep the previous sample so targets can interpolate between hand samples
+	PreviousPokePointerSampleLocation = PokePointerTransform.GetLocation();
+	PreviousPokePointerSampleTime = PokePointerSampleTime;
+
 	// Update cached transforms
 	GrabPointerTransform = CalcGrabPointerTransform(Hand);
 	PokePointerTransform = CalcPokePointerTransform(Hand);
+	PokePointerSampleTime = UUxtHandTrackingFunctionLibrary::GetHandSampleTime(Hand);
+
+	FUxtFlightRecorder::Get().Record(EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Poke, this, nullptr, PokePointerTransform.GetLocation());
 
 	// Unlock focus if targets have been removed,
 	// e.g. if target actors are destroyed while focus locked.
@@ -163,7 +215,11 @@ void UUxtNearPointerComponent::TickComponent(float DeltaTime, ELevelTick TickTyp
 		FCollisionQueryParams QueryParams(NAME_None, false);
 
 		TArray<FOverlapResult> Overlaps;
-		/*bool HasBlockingOverlap = */ GetWorld()->OverlapMultiByChannel(Overlaps, ProximityCenter, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(ProximityRadius), QueryParams);
+		{
+			UXT_SCOPE_CYCLE_COUNTER(NearPointerQuery);
+			UXT_INC_COUNTER(SceneQueries, 1);
+			/*bool HasBlockingOverlap = */ GetWorld()->OverlapMultiByChannel(Overlaps, ProximityCenter, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(ProximityRadius), QueryParams);
+		}
 
 		GrabFocus->SelectClosestTarget(this, GrabPointerTransform, Overlaps);
 		PokeFocus->SelectClosestTarget(this, PokePointerTransform, Overlaps);
@@ -217,85 +273,18 @@ void UUxtNearPointerComponent::SetActive(bool bNewActive, bool bReset)
 
 void UUxtNearPointerComponent::UpdatePokeInteraction()
 {
-	FVector PokePointerLocation = GetPokePointerTransform().GetLocation();
 	UActorComponent* Target = Cast<UActorComponent>(PokeFocus->GetFocusedTarget());
 	UPrimitiveComponent* Primitive = PokeFocus->GetFocusedPrimitive();
 
-	if (bIsPoking)
-	{
-		if (Primitive && Target)
-		{
-			bool endedPoking = false;
-
-			switch (IUxtPokeTarget::Execute_GetPokeBehaviour(Target))
-			{
-				case EUxtPokeBehaviour::FrontFace:
-					endedPoking = IsFrontFacePokeEnded(Primitive, PokePointerLocation, GetPokePointerRadius(), PokeDepth);
-					break;
-				case EUxtPokeBehaviour::Volume:
-					endedPoking = !Primitive->OverlapComponent(PokePointerLocation, FQuat::Identity, FCollisionShape::MakeSphere(GetPokePointerRadius()));
-					break;
-			}
-
-			if (endedPoking)
-			{
-				bIsPoking = false;
-				IUxtPokeTarget::Execute_OnEndPoke(Target, this);
-
-				bWasBehindFrontFace = IsBehindFrontFace(Primitive, PokePointerLocation, GetPokePointerRadius());
-			}
-			else
-			{
-				IUxtPokeTarget::Execute_OnUpdatePoke(Target, this);
-			}
-		}
-		else
-		{
-			bIsPoking = false;
-			bFocusLocked = false;
-
-			bWasBehindFrontFace = false;
-		}
-	}
-	else if (Target)
-	{
-		FVector Start = PreviousPokePointerLocation;
-		FVector End = PokePointerLocation;
-
-		bool isBehind = bWasBehindFrontFace;
-		if (Primitive)
-		{
-			isBehind = IsBehindFrontFace(Primitive, End, GetPokePointerRadius());
-		}
-
-		FHitResult HitResult;
-		GetWorld()->SweepSingleByChannel(HitResult, Start, End, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(GetPokePointerRadius()));
-
-		if (HitResult.GetComponent() == Primitive)
-		{
-			bool startedPoking = false;
-
-			switch (IUxtPokeTarget::Execute_GetPokeBehaviour(Target))
-			{
-				case EUxtPokeBehaviour::FrontFace:
-					startedPoking = !bWasBehindFrontFace && isBehind;
-					break;
-				case EUxtPokeBehaviour::Volume:
-					startedPoking = true;
-					break;
-			}
-
-			if (startedPoking)
-			{
-				bIsPoking = true;
-				IUxtPokeTarget::Execute_OnBeginPoke(Target, this);
-			}
-		}
-
-		bWasBehindFrontFace = isBehind;
-	}
+	FUxtPokeCore::FInput Input;
+	Input.Target = FUxtPointerFocus::GetTargetId(Target);
+	Input.Primitive = FUxtPointerFocus::GetTargetId(Primitive);
+	Input.Location = GetPokePointerTransform().GetLocation();
+	Input.Radius = GetPokePointerRadius();
+	Input.Depth = PokeDepth;
 
-	PreviousPokePointerLocation = PokePointerLocation;
+	FPokeAdapter Adapter(this, TraceChannel, Target, Primitive, Input.Location);
+	PokeCore.Update(Input, Adapter, Adapter);
 }
 
 UObject* UUxtNearPointerComponent::GetFocusedGrabTarget(FVector& OutClosestPointOnTarget) const
@@ -353,7 +342,7 @@ bool UUxtNearPointerComponent::IsGrabbing() const
 
 bool UUxtNearPointerComponent::GetIsPoking() const
 {
-	return bIsPoking;
+	return PokeCore.IsPoking();
 }
 
 FTransform UUxtNearPointerComponent::GetGrabPointerTransform() const
@@ -377,3 +366,18 @@ float UUxtNearPointerComponent::GetPokePointerRadius() const
 	}
 	return 0;
 }
+
+double UUxtNearPointerComponent::GetPokePointerSampleTime() const
+{
+	return PokePointerSampleTime;
+}
+
+FVector UUxtNearPointerComponent::GetPreviousPokePointerSampleLocation() const
+{
+	return PreviousPokePointerSampleLocation;
+}
+
+double UUxtNearPointerComponent::GetPreviousPokePointerSampleTime() const
+{
+	return PreviousPokePointerSampleTime;
+}
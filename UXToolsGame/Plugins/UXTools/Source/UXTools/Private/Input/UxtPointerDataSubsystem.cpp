@@ -0,0 +1,264 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Input/UxtPointerDataSubsystem.h"
+#include "UXTools.h"
+#include "Utils/UxtDefaultAssets.h"
+
+#include <Engine/Level.h>
+#include <Engine/Texture2D.h>
+#include <Engine/World.h>
+#include <Materials/MaterialInstanceDynamic.h>
+#include <Materials/MaterialParameterCollection.h>
+#include <Materials/MaterialParameterCollectionInstance.h>
+
+namespace
+{
+	const int32 NumTexelRows = 2;
+
+	const FName LeftPointerPositionParameter = "LeftPointerPosition";
+	const FName RightPointerPositionParameter = "RightPointerPosition";
+
+	float GetHandValue(EControllerHand Hand)
+	{
+		switch (Hand)
+		{
+		case EControllerHand::Left:
+			return 0.0f;
+		case EControllerHand::Right:
+			return 1.0f;
+		default:
+			return 2.0f;
+		}
+	}
+}
+
+const FName UUxtPointerDataSubsystem::PointerDataParameter = "PointerData";
+
+void FUxtPointerDataTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Target && !Target->IsPendingKill())
+	{
+		Target->PublishPointerData();
+	}
+}
+
+FString FUxtPointerDataTickFunction::DiagnosticMessage()
+{
+	return TEXT("UUxtPointerDataSubsystem::PublishPointerData");
+}
+
+void UUxtPointerDataSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Slots.SetNum(MaxPointers);
+}
+
+void UUxtPointerDataSubsystem::Deinitialize()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.UnRegisterTickFunction();
+	}
+
+	Slots.Empty();
+	TexelData.Empty();
+	BoundMaterials.Empty();
+	Texture = nullptr;
+	ParameterCollection = nullptr;
+
+	Super::Deinitialize();
+}
+
+int32 UUxtPointerDataSubsystem::AddPointer()
+{
+	const int32 Slot = Slots.IndexOfByPredicate([](const FPointerSlot& PointerSlot) { return !PointerSlot.bInUse; });
+	if (Slot == INDEX_NONE)
+	{
+		UE_LOG(UXTools, Warning, TEXT("All %d pointer data slots are in use, the pointer will not be visible to materials."), MaxPointers);
+		return INDEX_NONE;
+	}
+
+	// Resources are only created once pointers are used, i.e. not in editor worlds.
+	if (!Texture)
+	{
+		Texture = UTexture2D::CreateTransient(MaxPointers, NumTexelRows, PF_A32B32G32R32F);
+		Texture->SRGB = false;
+		Texture->Filter = TF_Nearest;
+		Texture->AddressX = TA_Clamp;
+		Texture->AddressY = TA_Clamp;
+		Texture->UpdateResource();
+
+		TexelData.Init(FLinearColor::Transparent, MaxPointers * NumTexelRows);
+
+		for (const TWeakObjectPtr<UMaterialInstanceDynamic>& Material : BoundMaterials)
+		{
+			if (Material.IsValid())
+			{
+				Material->SetTextureParameterValue(PointerDataParameter, Texture);
+			}
+		}
+		BoundMaterials.Empty();
+
+		// The parameter collection is written once the default assets have loaded
+		FUxtDefaultAssets::Get().CallWhenLoaded(this, [this]
+			{
+				// Resources are released when the subsystem is deinitialized
+				if (Texture)
+				{
+					ParameterCollection = FUxtDefaultAssets::Get().GetPointerPositions();
+				}
+			});
+	}
+
+	// Pointer data is published after all pointers have updated.
+	if (!TickFunction.IsTickFunctionRegistered())
+	{
+		TickFunction.Target = this;
+		TickFunction.bCanEverTick = true;
+		TickFunction.bStartWithTickEnabled = false;
+		TickFunction.TickGroup = ETickingGroup::TG_PostUpdateWork;
+		TickFunction.RegisterTickFunction(GetWorld()->PersistentLevel);
+	}
+
+	Slots[Slot] = FPointerSlot();
+	Slots[Slot].bInUse = true;
+	UpdateTickEnabled();
+
+	return Slot;
+}
+
+void UUxtPointerDataSubsystem::RemovePointer(int32 Slot)
+{
+	if (Slots.IsValidIndex(Slot))
+	{
+		Slots[Slot] = FPointerSlot();
+
+		// Publish the removal before the tick is disabled.
+		PublishPointerData();
+		UpdateTickEnabled();
+	}
+}
+
+void UUxtPointerDataSubsystem::UpdatePointer(int32 Slot, EControllerHand Hand, const FVector& Position, float Radius, EUxtPointerDataFlags Flags)
+{
+	if (Slots.IsValidIndex(Slot) && Slots[Slot].bInUse)
+	{
+		FPointerSlot& PointerSlot = Slots[Slot];
+		PointerSlot.Hand = Hand;
+		PointerSlot.Position = Position;
+		PointerSlot.Radius = Radius;
+		PointerSlot.Flags = Flags;
+	}
+}
+
+void UUxtPointerDataSubsystem::SetPointerFlags(int32 Slot, EUxtPointerDataFlags Flags)
+{
+	if (Slots.IsValidIndex(Slot) && Slots[Slot].bInUse)
+	{
+		Slots[Slot].Flags = Flags;
+	}
+}
+
+void UUxtPointerDataSubsystem::BindMaterial(UMaterialInstanceDynamic* Material)
+{
+	if (!Material)
+	{
+		return;
+	}
+
+	if (Texture)
+	{
+		Material->SetTextureParameterValue(PointerDataParameter, Texture);
+	}
+	else
+	{
+		// Bound until the texture is created by the first pointer
+		BoundMaterials.RemoveAll([](const TWeakObjectPtr<UMaterialInstanceDynamic>& BoundMaterial) { return !BoundMaterial.IsValid(); });
+		BoundMaterials.AddUnique(Material);
+	}
+}
+
+void UUxtPointerDataSubsystem::PublishPointerData()
+{
+	if (!Texture)
+	{
+		return;
+	}
+
+	bool bChanged = false;
+	for (int32 Slot = 0; Slot < MaxPointers; ++Slot)
+	{
+		const FPointerSlot& PointerSlot = Slots[Slot];
+		const FLinearColor PositionTexel = PointerSlot.bInUse ? FLinearColor(PointerSlot.Position.X, PointerSlot.Position.Y, PointerSlot.Position.Z, PointerSlot.Radius) : FLinearColor::Transparent;
+		const FLinearColor StateTexel = PointerSlot.bInUse ? FLinearColor((float)PointerSlot.Flags, GetHandValue(PointerSlot.Hand), 0, 0) : FLinearColor::Transparent;
+
+		FLinearColor& PositionData = TexelData[Slot];
+		FLinearColor& StateData = TexelData[MaxPointers + Slot];
+		if (PositionData != PositionTexel || StateData != StateTexel)
+		{
+			PositionData = PositionTexel;
+			StateData = StateTexel;
+			bChanged = true;
+		}
+	}
+
+	if (bChanged)
+	{
+		// The render thread owns the copy until the upload is done.
+		FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, 0, 0, 0, MaxPointers, NumTexelRows);
+		const int32 NumBytes = TexelData.Num() * sizeof(FLinearColor);
+		uint8* Data = new uint8[NumBytes];
+		FMemory::Memcpy(Data, TexelData.GetData(), NumBytes);
+
+		Texture->UpdateTextureRegions(0, 1, Region, MaxPointers * sizeof(FLinearColor), sizeof(FLinearColor), Data,
+			[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+			{
+				delete[] SrcData;
+				delete Regions;
+			});
+
+		PublishParameterCollection();
+	}
+}
+
+void UUxtPointerDataSubsystem::PublishParameterCollection()
+{
+	if (!ParameterCollection)
+	{
+		return;
+	}
+
+	const FPointerSlot* LeftSlot = Slots.FindByPredicate([](const FPointerSlot& Slot) { return Slot.bInUse && Slot.Hand == EControllerHand::Left && EnumHasAnyFlags(Slot.Flags, EUxtPointerDataFlags::Tracked); });
+	const FPointerSlot* RightSlot = Slots.FindByPredicate([](const FPointerSlot& Slot) { return Slot.bInUse && Slot.Hand == EControllerHand::Right && EnumHasAnyFlags(Slot.Flags, EUxtPointerDataFlags::Tracked); });
+
+	// Untracked hands keep their last position, as they did when each hand wrote its own parameter.
+	const FVector NewLeftPosition = LeftSlot ? LeftSlot->Position : LeftPointerPosition;
+	const FVector NewRightPosition = RightSlot ? RightSlot->Position : RightPointerPosition;
+	if (NewLeftPosition == LeftPointerPosition && NewRightPosition == RightPointerPosition)
+	{
+		return;
+	}
+
+	UMaterialParameterCollectionInstance* ParameterCollectionInstance = GetWorld()->GetParameterCollectionInstance(ParameterCollection);
+	if (NewLeftPosition != LeftPointerPosition)
+	{
+		ParameterCollectionInstance->SetVectorParameterValue(LeftPointerPositionParameter, NewLeftPosition);
+		LeftPointerPosition = NewLeftPosition;
+	}
+	if (NewRightPosition != RightPointerPosition)
+	{
+		ParameterCollectionInstance->SetVectorParameterValue(RightPointerPositionParameter, NewRightPosition);
+		RightPointerPosition = NewRightPosition;
+	}
+}
+
+void UUxtPointerDataSubsystem::UpdateTickEnabled()
+{
+	if (TickFunction.IsTickFunctionRegistered())
+	{
+		const bool bAnyInUse = Slots.ContainsByPredicate([](const FPointerSlot& Slot) { return Slot.bInUse; });
+		TickFunction.SetTickFunctionEnable(bAnyInUse);
+	}
+}
@@ -6,6 +6,7 @@
 #include "Interactions/UxtGrabTarget.h"
 #include "Interactions/UxtPokeTarget.h"
 #include "Interactions/UxtInteractionUtils.h"
+#include "Utils/UxtStats.h"
 
 #include "Components/PrimitiveComponent.h"
 
@@ -16,9 +17,51 @@ bool FUxtPointerFocusSearchResult::IsValid() const
 }
 
 
+struct FUxtPointerFocus::FEventAdapter : public IUxtFocusListener
+{
+	FEventAdapter(FUxtPointerFocus& InFocus, UUxtNearPointerComponent* InPointer, UObject* InNewTarget, UPrimitiveComponent* InNewPrimitive)
+		: Focus(InFocus), Pointer(InPointer), NewTarget(InNewTarget), NewPrimitive(InNewPrimitive)
+	{
+	}
+
+	virtual void OnEnterFocus(FUxtTargetId Target) override
+	{
+		UObject* FocusedTarget = Focus.FocusedTargetWeak.Get();
+		FUxtFlightRecorder::Get().Record(EUxtFlightEventType::FocusEnter, Focus.GetFlightInteraction(), Pointer, FocusedTarget, Focus.Core.GetClosestPoint());
+		if (FocusedTarget && Focus.ImplementsTargetInterface(FocusedTarget))
+		{
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+			Focus.RaiseEnterFocusEvent(FocusedTarget, Pointer);
+		}
+	}
+
+	virtual void OnExitFocus(FUxtTargetId Target) override
+	{
+		UObject* FocusedTarget = Focus.FocusedTargetWeak.Get();
+		FUxtFlightRecorder::Get().Record(EUxtFlightEventType::FocusExit, Focus.GetFlightInteraction(), Pointer, FocusedTarget, Focus.Core.GetClosestPoint());
+		if (FocusedTarget && Focus.ImplementsTargetInterface(FocusedTarget))
+		{
+			UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+			Focus.RaiseExitFocusEvent(FocusedTarget, Pointer);
+		}
+	}
+
+	virtual void OnFocusChanged(FUxtTargetId Target, FUxtTargetId Primitive) override
+	{
+		Focus.FocusedTargetWeak = NewTarget;
+		Focus.FocusedPrimitiveWeak = NewPrimitive;
+	}
+
+	FUxtPointerFocus& Focus;
+	UUxtNearPointerComponent* Pointer;
+	UObject* NewTarget;
+	UPrimitiveComponent* NewPrimitive;
+};
+
+
 const FVector& FUxtPointerFocus::GetClosestTargetPoint() const
 {
-	return ClosestTargetPoint;
+	return Core.GetClosestPoint();
 }
 
 UObject* FUxtPointerFocus::GetFocusedTarget() const
@@ -62,7 +105,9 @@ void FUxtPointerFocus::UpdateClosestTarget(const FTransform& PointerTransform)
 	{
 		if (UPrimitiveComponent* Primitive = FocusedPrimitiveWeak.Get())
 		{
-			GetClosestPointOnTarget(ClosesTarget, Primitive, PointerTransform.GetLocation(), ClosestTargetPoint);
+			FVector ClosestPoint = Core.GetClosestPoint();
+			GetClosestPointOnTarget(ClosesTarget, Primitive, PointerTransform.GetLocation(), ClosestPoint);
+			Core.SetClosestPoint(ClosestPoint);
 		}
 	}
 }
@@ -95,21 +140,17 @@ void FUxtPointerFocus::SelectClosestPointOnTarget(
 
 void FUxtPointerFocus::ClearFocus(UUxtNearPointerComponent* Pointer)
 {
-	UObject* FocusedTarget = FocusedTargetWeak.Get();
-	if (FocusedTarget && ImplementsTargetInterface(FocusedTarget))
-	{
-		RaiseExitFocusEvent(FocusedTarget, Pointer);
-	}
+	ForgetDestroyedTargets();
 
-	FocusedTargetWeak.Reset();
-	FocusedPrimitiveWeak.Reset();
-	ClosestTargetPoint = FVector::ZeroVector;
+	FEventAdapter Adapter(*this, Pointer, nullptr, nullptr);
+	Core.ClearFocus(Adapter);
 }
 
 void FUxtPointerFocus::UpdateFocus(UUxtNearPointerComponent* Pointer) const
 {
 	if (UObject* FocusedTarget = GetFocusedTargetChecked())
 	{
+		UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
 		RaiseUpdateFocusEvent(FocusedTarget, Pointer);
 	}
 }
@@ -121,31 +162,21 @@ void FUxtPointerFocus::SetFocus(
 	UPrimitiveComponent* NewPrimitive,
 	const FVector& NewClosestPointOnTarget)
 {
-	UObject* FocusedTarget = FocusedTargetWeak.Get();
-	UPrimitiveComponent* FocusedPrimitive = FocusedPrimitiveWeak.Get();
+	ForgetDestroyedTargets();
+
+	FEventAdapter Adapter(*this, Pointer, NewTarget, NewPrimitive);
+	Core.SetFocus(GetTargetId(NewTarget), GetTargetId(NewPrimitive), NewClosestPointOnTarget, Adapter);
+}
 
-	// If focused target is unchanged, then update only the closest-point-on-target
-	if (NewTarget == FocusedTarget && NewPrimitive == FocusedPrimitive)
+void FUxtPointerFocus::ForgetDestroyedTargets()
+{
+	if (Core.GetTarget() && !FocusedTargetWeak.IsValid())
 	{
-		ClosestTargetPoint = NewClosestPointOnTarget;
+		Core.ForgetTarget();
 	}
-	else
+	if (Core.GetPrimitive() && !FocusedPrimitiveWeak.IsValid())
 	{
-		// Update focused target
-		if (FocusedTarget && ImplementsTargetInterface(FocusedTarget))
-		{
-			RaiseExitFocusEvent(FocusedTarget, Pointer);
-		}
-
-		FocusedTarget = NewTarget;
-		FocusedTargetWeak = NewTarget;
-		FocusedPrimitiveWeak = NewPrimitive;
-		ClosestTargetPoint = NewClosestPointOnTarget;
-
-		if (FocusedTarget && ImplementsTargetInterface(FocusedTarget))
-		{
-			RaiseEnterFocusEvent(FocusedTarget, Pointer);
-		}
+		Core.ForgetPrimitive();
 	}
 }
 
@@ -164,6 +195,8 @@ UActorComponent* FUxtPointerFocus::FindInterfaceComponent(AActor* Owner) const
 
 FUxtPointerFocusSearchResult FUxtPointerFocus::FindClosestTarget(const TArray<FOverlapResult>& Overlaps, const FVector& Point) const
 {
+	UXT_SCOPE_CYCLE_COUNTER(FocusResolution);
+
 	float MinDistanceSqr = MAX_FLT;
 	UActorComponent* ClosestTarget = nullptr;
 	UPrimitiveComponent* ClosestPrimitive = nullptr;
@@ -177,6 +210,8 @@ FUxtPointerFocusSearchResult FUxtPointerFocus::FindClosestTarget(const TArray<FO
 		{
 			if (ImplementsTargetInterface(Component))
 			{
+				UXT_INC_COUNTER(TargetsEvaluated, 1);
+
 				FVector PointOnTarget;
 				if (GetClosestPointOnTarget(Component, Primitive, Point, PointOnTarget))
 				{
@@ -208,6 +243,8 @@ FUxtPointerFocusSearchResult FUxtPointerFocus::FindClosestTarget(const TArray<FO
 
 FUxtPointerFocusSearchResult FUxtPointerFocus::FindClosestPointOnComponent(UActorComponent* Target, const FVector& Point) const
 {
+	UXT_SCOPE_CYCLE_COUNTER(FocusResolution);
+
 	TArray<UPrimitiveComponent*> PrimitiveComponents;
 	Target->GetOwner()->GetComponents<UPrimitiveComponent>(PrimitiveComponents);
 
@@ -216,6 +253,8 @@ FUxtPointerFocusSearchResult FUxtPointerFocus::FindClosestPointOnComponent(UActo
 	float MinDistanceSqr = -1.f;
 	for (UPrimitiveComponent* Primitive : PrimitiveComponents)
 	{
+		UXT_INC_COUNTER(TargetsEvaluated, 1);
+
 		FVector PointOnPrimitive;
 		GetClosestPointOnTarget(Target, Primitive, Point, PointOnPrimitive);
 
@@ -245,37 +284,71 @@ FUxtPointerFocusSearchResult FUxtPointerFocus::FindClosestPointOnComponent(UActo
 }
 
 
-void FUxtGrabPointerFocus::BeginGrab(UUxtNearPointerComponent* Pointer)
+namespace
 {
-	if (UObject* Target = GetFocusedTargetChecked())
+	/** Raises the grab events of the core on the focused grab target. */
+	struct FGrabEventAdapter : public IUxtFocusListener
 	{
-		IUxtGrabTarget::Execute_OnBeginGrab(Target, Pointer);
-	}
+		FGrabEventAdapter(const FUxtGrabPointerFocus& InFocus, UUxtNearPointerComponent* InPointer)
+			: Focus(InFocus), Pointer(InPointer)
+		{
+		}
+
+		// Focus does not change while grabbing starts or ends.
+		virtual void OnEnterFocus(FUxtTargetId Target) override {}
+		virtual void OnExitFocus(FUxtTargetId Target) override {}
+
+		virtual void OnBeginGrab(FUxtTargetId Target) override
+		{
+			if (UObject* FocusedTarget = Focus.GetFocusedTargetChecked())
+			{
+				FUxtFlightRecorder::Get().Record(EUxtFlightEventType::GrabBegin, EUxtFlightInteraction::Grab, Pointer, FocusedTarget, Focus.GetClosestTargetPoint());
+
+				UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+				IUxtGrabTarget::Execute_OnBeginGrab(FocusedTarget, Pointer);
+			}
+		}
+
+		virtual void OnEndGrab(FUxtTargetId Target) override
+		{
+			if (UObject* FocusedTarget = Focus.GetFocusedTargetChecked())
+			{
+				FUxtFlightRecorder::Get().Record(EUxtFlightEventType::GrabEnd, EUxtFlightInteraction::Grab, Pointer, FocusedTarget, Focus.GetClosestTargetPoint());
 
-	bIsGrabbing = true;
+				UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
+				IUxtGrabTarget::Execute_OnEndGrab(FocusedTarget, Pointer);
+			}
+		}
+
+		const FUxtGrabPointerFocus& Focus;
+		UUxtNearPointerComponent* Pointer;
+	};
+}
+
+void FUxtGrabPointerFocus::BeginGrab(UUxtNearPointerComponent* Pointer)
+{
+	FGrabEventAdapter Adapter(*this, Pointer);
+	Core.BeginGrab(Adapter);
 }
 
 void FUxtGrabPointerFocus::UpdateGrab(UUxtNearPointerComponent* Pointer)
 {
 	if (UObject* Target = GetFocusedTargetChecked())
 	{
+		UXT_SCOPE_CYCLE_COUNTER(EventDispatch);
 		IUxtGrabTarget::Execute_OnUpdateGrab(Target, Pointer);
 	}
 }
 
 void FUxtGrabPointerFocus::EndGrab(UUxtNearPointerComponent* Pointer)
 {
-	bIsGrabbing = false;
-
-	if (UObject* Target = GetFocusedTargetChecked())
-	{
-		IUxtGrabTarget::Execute_OnEndGrab(Target, Pointer);
-	}
+	FGrabEventAdapter Adapter(*this, Pointer);
+	Core.EndGrab(Adapter);
 }
 
 bool FUxtGrabPointerFocus::IsGrabbing() const
 {
-	return bIsGrabbing;
+	return Core.IsGrabbing();
 }
 
 UClass* FUxtGrabPointerFocus::GetInterfaceClass() const
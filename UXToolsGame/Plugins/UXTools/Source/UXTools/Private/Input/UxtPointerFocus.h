@@ -4,6 +4,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Input/UxtNearInteractionCore.h"
+#include "Utils/UxtFlightRecorder.h"
 
 class UUxtNearPointerComponent;
 
@@ -25,13 +27,19 @@ struct FUxtPointerFocusSearchResult
 	float MinDistance;
 };
 
-/** Utility class that is used by components to manage different pointers and their focus targets. */
+/**
+ * Utility class that is used by components to manage different pointers and their focus targets.
+ * Focus transitions are made by FUxtFocusCore, this class resolves targets and raises events on them.
+ */
 struct FUxtPointerFocus
 {
 public:
 
 	virtual ~FUxtPointerFocus() {}
 
+	/** Identifier of an object in the near interaction core. */
+	static FUxtTargetId GetTargetId(const UObject* Object) { return static_cast<FUxtTargetId>(reinterpret_cast<UPTRINT>(Object)); }
+
 	/** Get the closest point on the surface of the focused target */
 	const FVector& GetClosestTargetPoint() const;
 
@@ -70,6 +78,9 @@ public:
 
 protected:
 
+	/** Drop targets that have been destroyed from the core, no exit events are raised for them. */
+	void ForgetDestroyedTargets();
+
 	/** Set the focus to the given target object, primitive, and point on the target. */
 	void SetFocus(
 		UUxtNearPointerComponent* Pointer,
@@ -93,6 +104,9 @@ protected:
 	/** Find the closest point on the given primitive using the distance function of the target interface. */
 	virtual bool GetClosestPointOnTarget(const UActorComponent* Target, const UPrimitiveComponent* Primitive, const FVector& Point, FVector& OutClosestPoint) const = 0;
 
+	/** Interaction recorded in the flight recorder for focus changes. */
+	virtual EUxtFlightInteraction GetFlightInteraction() const = 0;
+
 	/** Notify the target object that it has entered focus. */
 	virtual void RaiseEnterFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const = 0;
 	/** Notify the focused target object that the pointer has been updated. */
@@ -100,16 +114,19 @@ protected:
 	/** Notify the target object that it has exited focus. */
 	virtual void RaiseExitFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const = 0;
 
+	/** Focus state, with IDs of the focused target and primitive. */
+	FUxtFocusCore Core;
+
 private:
 
+	/** Raises the focus events of the core on the targets. */
+	struct FEventAdapter;
+
 	/** Weak reference to the currently focused target. */
 	TWeakObjectPtr<UObject> FocusedTargetWeak;
 
 	/** Weak reference to the focused grab target primitive. */
 	TWeakObjectPtr<UPrimitiveComponent> FocusedPrimitiveWeak;
-
-	/** Closest point on the surface of the focused target. */
-	FVector ClosestTargetPoint = FVector::ZeroVector;
 };
 
 
@@ -135,14 +152,11 @@ protected:
 
 	virtual bool GetClosestPointOnTarget(const UActorComponent* Target, const UPrimitiveComponent* Primitive, const FVector& Point, FVector& OutClosestPoint) const override;
 
+	virtual EUxtFlightInteraction GetFlightInteraction() const override { return EUxtFlightInteraction::Grab; }
+
 	virtual void RaiseEnterFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const override;
 	virtual void RaiseUpdateFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const override;
 	virtual void RaiseExitFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const override;
-
-private:
-
-	bool bIsGrabbing = false;
-
 };
 
 
@@ -157,6 +171,8 @@ protected:
 
 	virtual bool GetClosestPointOnTarget(const UActorComponent* Target, const UPrimitiveComponent* Primitive, const FVector& Point, FVector& OutClosestPoint) const override;
 
+	virtual EUxtFlightInteraction GetFlightInteraction() const override { return EUxtFlightInteraction::Poke; }
+
 	virtual void RaiseEnterFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const override;
 	virtual void RaiseUpdateFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const override;
 	virtual void RaiseExitFocusEvent(UObject* Target, UUxtNearPointerComponent* Pointer) const override;
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 #include "UxtTwoHandRotateLogic.h"
+#include "Utils/UxtMathKernels.h"
 
 namespace
 {
@@ -24,8 +25,6 @@ void UxtTwoHandManipulationRotateLogic::Setup(GrabPointers PointerData, const FQ
 FQuat UxtTwoHandManipulationRotateLogic::Update(GrabPointers PointerData) const
 {
 	FVector UpdatedHandleBar = GetHandleBarDirection(PointerData);
-	FQuat Rot = FQuat::FindBetween(StartHandleBar, UpdatedHandleBar);
-	Rot.Normalize();
-	return Rot * StartRotation;
+	return FUxtMathKernels::TwoHandRotate(StartHandleBar, UpdatedHandleBar, StartRotation);
 }
 
@@ -1,26 +1,18 @@
 // Copyright (c) Microsoft Corporation.
 // Licensed under the MIT License.
 #include "UxtTwoHandScaleLogic.h"
+#include "Utils/UxtMathKernels.h"
 
 namespace
 {
 	float GetMinDistanceBetweenHands(UxtTwoHandManipulationScaleLogic::GrabPointers PointerData)
 	{
-		float Result = TNumericLimits<float>::Max();
-		for (int i = 0; i < PointerData.Num(); i++)
+		TArray<FVector, TInlineAllocator<4>> Locations;
+		for (const FUxtGrabPointerData& Pointer : PointerData)
 		{
-			for (int j = i + 1; j < PointerData.Num(); j++)
-			{
-				FVector HandLocationFirst = UUxtGrabPointerDataFunctionLibrary::GetPointerLocation(PointerData[i]);
-				FVector HandLocationSecond = UUxtGrabPointerDataFunctionLibrary::GetPointerLocation(PointerData[j]);
-				float Distance = FVector::Dist(HandLocationFirst, HandLocationSecond);
-				if (Distance < Result)
-				{
-					Result = Distance;
-				}
-			}
+			Locations.Add(UUxtGrabPointerDataFunctionLibrary::GetPointerLocation(Pointer));
 		}
-		return Result;
+		return FUxtMathKernels::GetMinDistanceBetweenPoints(Locations);
 	}
 }
 
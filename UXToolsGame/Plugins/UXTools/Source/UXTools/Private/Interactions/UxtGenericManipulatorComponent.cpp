@@ -2,11 +2,14 @@
 // Licensed under the MIT License.
 
 #include "Interactions/UxtGenericManipulatorComponent.h"
+#include "Interactions/Manipulation/UxtManipulationMoveLogic.h"
 #include "Interactions/Manipulation/UxtTwoHandRotateLogic.h"
 #include "Interactions/Manipulation/UxtTwoHandScaleLogic.h"
 #include "Utils/UxtMathUtilsFunctionLibrary.h"
 #include "Utils/UxtFunctionLibrary.h"
+#include "Utils/UxtStats.h"
 
+#include "Components/PrimitiveComponent.h"
 #include "Engine/World.h"
 
 // Sets default values for this component's properties
@@ -26,22 +29,229 @@ void UUxtGenericManipulatorComponent::TickComponent(float DeltaTime, ELevelTick
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	int NumPointers = GetGrabPointers().Num();
-	if (NumPointers == 0)
+	FTransform TargetTransform;
+	if (ComputeTargetTransform(DeltaTime, TargetTransform))
 	{
-		return;
+		ApplyTargetTransform(TargetTransform);
+	}
+}
+
+bool UUxtGenericManipulatorComponent::ComputeTargetTransform(float DeltaTime, FTransform& OutTargetTransform)
+{
+	UXT_SCOPE_CYCLE_COUNTER(ManipulationSolve);
+
+	if (FManipulationPipeline Pipeline = GetPipeline(GetGrabPointers().Num()))
+	{
+		OutTargetTransform = InitialTransform;
+		(this->*Pipeline)(DeltaTime, OutTargetTransform);
+		return true;
 	}
-	else if (NumPointers == 1)
+
+	return false;
+}
+
+void UUxtGenericManipulatorComponent::UpdateOneHandManipulation(float DeltaTime)
+{
+	FManipulationPipeline Pipeline = GetPipeline(1);
+	if (Pipeline && GetGrabPointers().Num() > 0)
 	{
-		UpdateOneHandManipulation(DeltaTime);
+		FTransform TargetTransform = InitialTransform;
+		(this->*Pipeline)(DeltaTime, TargetTransform);
+		ApplyTargetTransform(TargetTransform);
+	}
+}
+
+void UUxtGenericManipulatorComponent::UpdateTwoHandManipulation(float DeltaTime)
+{
+	FManipulationPipeline Pipeline = GetPipeline(2);
+	if (Pipeline && GetGrabPointers().Num() > 1)
+	{
+		FTransform TargetTransform = InitialTransform;
+		(this->*Pipeline)(DeltaTime, TargetTransform);
+		ApplyTargetTransform(TargetTransform);
+	}
+}
+
+UUxtGenericManipulatorComponent::FManipulationPipeline UUxtGenericManipulatorComponent::GetPipeline(int32 NumPointers)
+{
+	// Settings are public properties, so changes can only be detected here.
+	if (PipelineSettingsKey != GetPipelineSettingsKey())
+	{
+		UpdatePipelines();
+	}
+
+	if (NumPointers == 1)
+	{
+		return OneHandPipeline;
 	}
 	else if (NumPointers == 2)
 	{
-		UpdateTwoHandManipulation(DeltaTime);
+		return TwoHandPipeline;
 	}
 	else
 	{
-		// 3+ hands not supported
+		// 0 or 3+ hands not supported
+		return nullptr;
+	}
+}
+
+uint32 UUxtGenericManipulatorComponent::GetPipelineSettingsKey() const
+{
+	return (uint32)ManipulationModes | ((uint32)TwoHandTransformModes << 8) | ((uint32)OneHandRotationMode << 16);
+}
+
+void UUxtGenericManipulatorComponent::UpdatePipelines()
+{
+	static const FManipulationPipeline OneHandPipelines[] =
+	{
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::MaintainOriginalRotation>,
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::RotateAboutObjectCenter>,
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::RotateAboutGrabPoint>,
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::MaintainRotationToUser>,
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::GravityAlignedMaintainRotationToUser>,
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::FaceUser>,
+		&UUxtGenericManipulatorComponent::RunOneHandPipeline<EUxtOneHandRotationMode::FaceAwayFromUser>,
+	};
+
+	// Indexed by the two-hand transform mode bits: translation (1), rotation (2), scaling (4).
+	static const FManipulationPipeline TwoHandPipelines[] =
+	{
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<false, false, false>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<false, false, true>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<false, true, false>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<false, true, true>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<true, false, false>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<true, false, true>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<true, true, false>,
+		&UUxtGenericManipulatorComponent::RunTwoHandPipeline<true, true, true>,
+	};
+
+	static_assert((uint8)EUxtTwoHandTransformMode::Translation == 0 && (uint8)EUxtTwoHandTransformMode::Rotation == 1 && (uint8)EUxtTwoHandTransformMode::Scaling == 2,
+		"Two-hand pipeline table assumes transform mode bit order");
+
+	PipelineSettingsKey = GetPipelineSettingsKey();
+
+	OneHandPipeline = nullptr;
+	if (!!(ManipulationModes & (1 << (uint8)EUxtGenericManipulationMode::OneHanded)) && (uint8)OneHandRotationMode < UE_ARRAY_COUNT(OneHandPipelines))
+	{
+		OneHandPipeline = OneHandPipelines[(uint8)OneHandRotationMode];
+	}
+
+	TwoHandPipeline = nullptr;
+	if (!!(ManipulationModes & (1 << (uint8)EUxtGenericManipulationMode::TwoHanded)))
+	{
+		TwoHandPipeline = TwoHandPipelines[TwoHandTransformModes & 0x7];
+	}
+}
+
+template <EUxtOneHandRotationMode RotationMode>
+void UUxtGenericManipulatorComponent::RunOneHandPipeline(float DeltaTime, FTransform& Transform) const
+{
+	const FUxtGrabPointerData& PrimaryPointerData = GetGrabPointers()[0];
+
+	// Head pose is queried once and shared by all stages.
+	const FTransform HeadPose = UUxtFunctionLibrary::GetHeadPose(GetWorld());
+
+	// Move stage
+	const bool bUsePointerRotation = (RotationMode != EUxtOneHandRotationMode::RotateAboutObjectCenter);
+	Transform.SetLocation(MoveLogic->Update(GetPointersTransformCentroid(), Transform.GetRotation(), Transform.GetScale3D(), bUsePointerRotation, HeadPose.GetLocation()));
+
+	// Rotation stage, the switch is resolved at compile time.
+	switch (RotationMode)
+	{
+	case EUxtOneHandRotationMode::MaintainOriginalRotation:
+		break;
+
+	case EUxtOneHandRotationMode::RotateAboutObjectCenter:
+	case EUxtOneHandRotationMode::RotateAboutGrabPoint:
+	{
+		// Only the orientation of the rotated transform is used, which does not depend on the pivot.
+		const FRotator DeltaRot = UUxtGrabPointerDataFunctionLibrary::GetRotationOffset(Transform, PrimaryPointerData);
+		Transform.SetRotation(FQuat(DeltaRot) * Transform.GetRotation());
+		break;
+	}
+
+	case EUxtOneHandRotationMode::MaintainRotationToUser:
+	case EUxtOneHandRotationMode::GravityAlignedMaintainRotationToUser:
+	{
+		FRotator CameraSpaceYawPitchRotation = HeadPose.GetRotation().Rotator();
+		CameraSpaceYawPitchRotation.Roll = 0.0f;
+		Transform.SetRotation(CameraSpaceYawPitchRotation.Quaternion() * InitialCameraSpaceTransform.GetRotation());
+		break;
+	}
+
+	case EUxtOneHandRotationMode::FaceUser:
+	{
+		const FVector Forward = HeadPose.GetLocation() - Transform.GetLocation();
+		Transform.SetRotation(FRotationMatrix::MakeFromXZ(Forward, FVector::UpVector).ToQuat());
+		break;
+	}
+
+	case EUxtOneHandRotationMode::FaceAwayFromUser:
+	{
+		const FVector Forward = Transform.GetLocation() - HeadPose.GetLocation();
+		Transform.SetRotation(FRotationMatrix::MakeFromXZ(Forward, FVector::UpVector).ToQuat());
+		break;
+	}
+	}
+
+	SmoothTransform(Transform, Smoothing, Smoothing, DeltaTime, Transform);
+}
+
+template <bool bScale, bool bRotate, bool bTranslate>
+void UUxtGenericManipulatorComponent::RunTwoHandPipeline(float DeltaTime, FTransform& Transform) const
+{
+	if (bScale)
+	{
+		Transform.SetScale3D(TwoHandScaleLogic->Update(GetGrabPointers()));
+	}
+
+	if (bRotate)
+	{
+		Transform.SetRotation(TwoHandRotateLogic->Update(GetGrabPointers()));
+	}
+
+	if (bTranslate)
+	{
+		const FVector HeadLocation = UUxtFunctionLibrary::GetHeadPose(GetWorld()).GetLocation();
+		Transform.SetLocation(MoveLogic->Update(GetPointersTransformCentroid(), Transform.GetRotation(), Transform.GetScale3D(), true, HeadLocation));
+	}
+
+	SmoothTransform(Transform, Smoothing, Smoothing, DeltaTime, Transform);
+}
+
+void UUxtGenericManipulatorComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	UpdatePipelines();
+
+	OnEndGrab.AddDynamic(this, &UUxtGenericManipulatorComponent::OnManipulationReleased);
+}
+
+void UUxtGenericManipulatorComponent::OnManipulationReleased(UUxtGrabTargetComponent* Grabbable, FUxtGrabPointerData GrabPointer)
+{
+	// The released pointer is still in the grab pointer list, so only throw if it was the last one.
+	if (!bThrowOnRelease || GetGrabPointers().Num() != 1)
+	{
+		return;
+	}
+
+	UPrimitiveComponent* Root = Cast<UPrimitiveComponent>(GetOwner()->GetRootComponent());
+	if (!Root || !Root->IsSimulatingPhysics())
+	{
+		return;
+	}
+
+	bool bHasVelocity;
+	FVector LinearVelocity, AngularVelocity;
+	GetGrabPointerVelocity(GrabPointer.NearPointer, GrabPointer.FarPointer, bHasVelocity, LinearVelocity, AngularVelocity);
+	if (bHasVelocity)
+	{
+		// The center of mass moves with the grab point plus the rotation of the lever arm between them.
+		FVector LeverArm = Root->GetCenterOfMass() - UUxtGrabPointerDataFunctionLibrary::GetTargetLocation(GrabPointer);
+		Root->SetPhysicsLinearVelocity(LinearVelocity + FVector::CrossProduct(AngularVelocity, LeverArm));
+		Root->SetPhysicsAngularVelocityInRadians(AngularVelocity);
 	}
 }
 
@@ -153,54 +363,6 @@ bool UUxtGenericManipulatorComponent::GetTwoHandScale(const FTransform& InSource
 	return true;
 }
 
-void UUxtGenericManipulatorComponent::UpdateOneHandManipulation(float DeltaTime)
-{
-	if (!(ManipulationModes & (1 << (uint8)EUxtGenericManipulationMode::OneHanded)))
-	{
-		return;
-	}
-
-	FTransform TargetTransform = InitialTransform;
-
-	MoveToTargets(TargetTransform, TargetTransform, OneHandRotationMode != EUxtOneHandRotationMode::RotateAboutObjectCenter);
-
-	GetOneHandRotation(TargetTransform, TargetTransform);
-
-	SmoothTransform(TargetTransform, Smoothing, Smoothing, DeltaTime, TargetTransform);
-
-	ApplyTargetTransform(TargetTransform);
-}
-
-void UUxtGenericManipulatorComponent::UpdateTwoHandManipulation(float DeltaTime)
-{
-	if (!(ManipulationModes & (1 << (uint8)EUxtGenericManipulationMode::TwoHanded)))
-	{
-		return;
-	}
-
-	FTransform TargetTransform = InitialTransform;
-
-	if (!!(TwoHandTransformModes & (1 << (uint8)EUxtTwoHandTransformMode::Scaling)))
-	{
-		GetTwoHandScale(TargetTransform, TargetTransform);
-	}
-
-	if (!!(TwoHandTransformModes & (1 << (uint8)EUxtTwoHandTransformMode::Rotation)))
-	{
-		GetTwoHandRotation(TargetTransform, TargetTransform);
-	}
-
-	if (!!(TwoHandTransformModes & (1 << (uint8)EUxtTwoHandTransformMode::Translation)))
-	{
-		MoveToTargets(TargetTransform, TargetTransform, true);
-	}
-
-
-	SmoothTransform(TargetTransform, Smoothing, Smoothing, DeltaTime, TargetTransform);
-
-	ApplyTargetTransform(TargetTransform);
-}
-
 float UUxtGenericManipulatorComponent::GetSmoothing() const
 {
 	return Smoothing;
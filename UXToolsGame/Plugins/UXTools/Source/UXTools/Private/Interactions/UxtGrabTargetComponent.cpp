@@ -85,6 +85,42 @@ const TArray<FUxtGrabPointerData> &UUxtGrabTargetComponent::GetGrabPointers() co
 	return GrabPointers;
 }
 
+void UUxtGrabTargetComponent::GetGrabPointerVelocity(UUxtNearPointerComponent* NearPointer, UUxtFarPointerComponent* FarPointer, bool &Success, FVector &LinearVelocity, FVector &AngularVelocity) const
+{
+	FUxtGrabPointerData const *pData;
+	int Index;
+	if (FindGrabPointerInternal(NearPointer, FarPointer, pData, Index))
+	{
+		const FUxtPointerKinematics& Kinematics = GrabPointerKinematics[Index];
+		const bool bHasLinear = Kinematics.GetLinearVelocity(VelocityWindow, LinearVelocity);
+		const bool bHasAngular = Kinematics.GetAngularVelocity(VelocityWindow, AngularVelocity);
+		Success = bHasLinear && bHasAngular;
+	}
+	else
+	{
+		LinearVelocity = FVector::ZeroVector;
+		AngularVelocity = FVector::ZeroVector;
+		Success = false;
+	}
+}
+
+const FUxtPointerKinematics& UUxtGrabTargetComponent::GetGrabPointerKinematics(int Index) const
+{
+	return GrabPointerKinematics[Index];
+}
+
+void UUxtGrabTargetComponent::AddGrabPointer(const FUxtGrabPointerData& GrabData)
+{
+	GrabPointers.Add(GrabData);
+	GrabPointerKinematics.AddDefaulted();
+	RecordGrabPointerSample(GrabPointers.Num() - 1);
+}
+
+void UUxtGrabTargetComponent::RecordGrabPointerSample(int Index)
+{
+	GrabPointerKinematics[Index].AddSample(GetWorld()->GetTimeSeconds(), GrabPointers[Index].GrabPointTransform);
+}
+
 FVector UUxtGrabTargetComponent::GetGrabPointCentroid(const FTransform &Transform) const
 {
 	FVector centroid = FVector::ZeroVector;
@@ -226,7 +262,7 @@ void UUxtGrabTargetComponent::OnBeginGrab_Implementation(UUxtNearPointerComponen
 	GrabData.StartTime = GetWorld()->GetTimeSeconds();
 	InitGrabTransform(GrabData);
 
-	GrabPointers.Add(GrabData);
+	AddGrabPointer(GrabData);
 
 	// Lock the grabbing pointer so we remain the focused target as it moves.
 	Pointer->SetFocusLocked(true);
@@ -239,11 +275,13 @@ void UUxtGrabTargetComponent::OnBeginGrab_Implementation(UUxtNearPointerComponen
 void UUxtGrabTargetComponent::OnUpdateGrab_Implementation(UUxtNearPointerComponent* Pointer)
 {
 	// Update the copy of the pointer data in the grab pointer array
-	for (FUxtGrabPointerData& GrabData : GrabPointers)
+	for (int i = 0; i < GrabPointers.Num(); ++i)
 	{
+		FUxtGrabPointerData& GrabData = GrabPointers[i];
 		if (GrabData.NearPointer == Pointer)
 		{
 			GrabData.GrabPointTransform = Pointer->GetGrabPointerTransform();
+			RecordGrabPointerSample(i);
 
 			OnUpdateGrab.Broadcast(this, GrabData);
 		}
@@ -253,18 +291,22 @@ void UUxtGrabTargetComponent::OnUpdateGrab_Implementation(UUxtNearPointerCompone
 
 void UUxtGrabTargetComponent::OnEndGrab_Implementation(UUxtNearPointerComponent* Pointer)
 {
-	int numRemoved = GrabPointers.RemoveAll([this, Pointer](const FUxtGrabPointerData& GrabData)
+	// Iterate backwards so pointers can be removed in place.
+	// The end grab event is raised before removal so listeners can still query the pointer history.
+	for (int i = GrabPointers.Num() - 1; i >= 0; --i)
+	{
+		if (GrabPointers[i].NearPointer == Pointer)
 		{
-			if (GrabData.NearPointer == Pointer)
-			{
-				// Unlock the pointer focus so that another target can be selected.
-				Pointer->SetFocusLocked(false);
+			// Unlock the pointer focus so that another target can be selected.
+			Pointer->SetFocusLocked(false);
 
-				OnEndGrab.Broadcast(this, GrabData);
-				return true;
-			}
-			return false;
-		});
+			const FUxtGrabPointerData GrabData = GrabPointers[i];
+			OnEndGrab.Broadcast(this, GrabData);
+
+			GrabPointers.RemoveAt(i);
+			GrabPointerKinematics.RemoveAt(i);
+		}
+	}
 
 	// make sure to update initial ptr transforms once a pointer gets removed to ensure
 	// calculations are performed on the correct starting values
@@ -309,7 +351,7 @@ void UUxtGrabTargetComponent::OnFarPressed_Implementation(UUxtFarPointerComponen
 	PointerData.StartTime = GetWorld()->GetTimeSeconds();
 
 	InitGrabTransform(PointerData);
-	GrabPointers.Add(PointerData);
+	AddGrabPointer(PointerData);
 
 	// Lock the grabbing pointer so we remain the hovered target as it moves.
 	Pointer->SetFocusLocked(true);
@@ -319,16 +361,19 @@ void UUxtGrabTargetComponent::OnFarPressed_Implementation(UUxtFarPointerComponen
 
 void UUxtGrabTargetComponent::OnFarReleased_Implementation(UUxtFarPointerComponent* Pointer)
 {
-	int numRemoved = GrabPointers.RemoveAll([this, Pointer](const FUxtGrabPointerData& PointerData)
+	for (int i = GrabPointers.Num() - 1; i >= 0; --i)
+	{
+		if (GrabPointers[i].FarPointer == Pointer)
 		{
-			if (PointerData.FarPointer == Pointer)
-			{
-				Pointer->SetFocusLocked(false);
-				OnEndGrab.Broadcast(this, PointerData);
-				return true;
-			}
-			return false;
-		});
+			Pointer->SetFocusLocked(false);
+
+			const FUxtGrabPointerData PointerData = GrabPointers[i];
+			OnEndGrab.Broadcast(this, PointerData);
+
+			GrabPointers.RemoveAt(i);
+			GrabPointerKinematics.RemoveAt(i);
+		}
+	}
 
 	// make sure to update initial ptr transforms once a pointer gets removed to ensure
 	// calculations are performed on the correct starting values
@@ -343,12 +388,14 @@ void UUxtGrabTargetComponent::OnFarReleased_Implementation(UUxtFarPointerCompone
 void UUxtGrabTargetComponent::OnFarDragged_Implementation(UUxtFarPointerComponent* Pointer)
 {
 	// Update the copy of the pointer data in the grab pointer array
-	for (FUxtGrabPointerData& GrabData : GrabPointers)
+	for (int i = 0; i < GrabPointers.Num(); ++i)
 	{
+		FUxtGrabPointerData& GrabData = GrabPointers[i];
 		if (GrabData.FarPointer == Pointer)
 		{
 			FTransform PointerTransform(GrabData.FarPointer->GetPointerOrientation(), GrabData.FarPointer->GetPointerOrigin());
 			GrabData.GrabPointTransform = GrabData.FarRayHitPointInPointer * PointerTransform;
+			RecordGrabPointerSample(i);
 
 			OnUpdateGrab.Broadcast(this, GrabData);
 		}
@@ -4,6 +4,7 @@
 #include "Interactions/UxtInteractionUtils.h"
 
 #include "Components/PrimitiveComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "GameFramework/Actor.h"
 
 bool FUxtInteractionUtils::GetDefaultClosestPointOnPrimitive(const UPrimitiveComponent* Primitive, const FVector& Point, FVector& OutPointOnSurface, float& OutDistanceSqr)
@@ -13,6 +14,12 @@ bool FUxtInteractionUtils::GetDefaultClosestPointOnPrimitive(const UPrimitiveCom
 
 	if (Primitive->IsRegistered() && Primitive->IsCollisionEnabled())
 	{
+		// Instances have their own bodies, the component body is not used for collision.
+		if (const UInstancedStaticMeshComponent* Instanced = Cast<UInstancedStaticMeshComponent>(Primitive))
+		{
+			return GetClosestInstance(Instanced, Point, OutPointOnSurface, OutDistanceSqr) != INDEX_NONE;
+		}
+
 		FVector ClosestPoint;
 		float DistanceSqr = -1.f;
 
@@ -27,3 +34,31 @@ bool FUxtInteractionUtils::GetDefaultClosestPointOnPrimitive(const UPrimitiveCom
 
 	return false;
 }
+
+int32 FUxtInteractionUtils::GetClosestInstance(const UInstancedStaticMeshComponent* Instanced, const FVector& Point, FVector& OutPointOnSurface, float& OutDistanceSqr)
+{
+	OutPointOnSurface = Point;
+	OutDistanceSqr = -1.f;
+	int32 ClosestInstance = INDEX_NONE;
+
+	for (int32 InstanceIndex = 0; InstanceIndex < Instanced->InstanceBodies.Num(); ++InstanceIndex)
+	{
+		const FBodyInstance* Body = Instanced->InstanceBodies[InstanceIndex];
+		if (Body == nullptr)
+		{
+			continue;
+		}
+
+		FVector ClosestPoint;
+		float DistanceSqr = -1.f;
+
+		if (Body->GetSquaredDistanceToBody(Point, DistanceSqr, ClosestPoint) && (ClosestInstance == INDEX_NONE || DistanceSqr < OutDistanceSqr))
+		{
+			OutPointOnSurface = ClosestPoint;
+			OutDistanceSqr = DistanceSqr;
+			ClosestInstance = InstanceIndex;
+		}
+	}
+
+	return ClosestInstance;
+}
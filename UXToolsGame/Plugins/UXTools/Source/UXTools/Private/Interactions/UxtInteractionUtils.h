@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 
 class AActor;
+class UInstancedStaticMeshComponent;
 
 class FUxtInteractionUtils
 {
@@ -16,4 +17,9 @@ public:
 	 */
 	static bool GetDefaultClosestPointOnPrimitive(const UPrimitiveComponent* Primitive, const FVector& Point, FVector& OutPointOnSurface, float& OutDistanceSqr);
 
+	/** Finds the instance with collision closest to the point passed in.
+	 *  Returns the instance index, or INDEX_NONE if no instance has collision.
+	 */
+	static int32 GetClosestInstance(const UInstancedStaticMeshComponent* Instanced, const FVector& Point, FVector& OutPointOnSurface, float& OutDistanceSqr);
+
 };
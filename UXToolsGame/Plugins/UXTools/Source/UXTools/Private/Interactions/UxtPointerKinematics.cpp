@@ -0,0 +1,171 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Interactions/UxtPointerKinematics.h"
+
+namespace
+{
+	/** Rotation vector (axis scaled by angle in radians) of the shortest rotation equivalent to Q. */
+	FVector GetRotationVector(FQuat Q)
+	{
+		if (Q.W < 0.0f)
+		{
+			Q = -Q;
+		}
+
+		FVector Axis;
+		float Angle;
+		Q.ToAxisAndAngle(Axis, Angle);
+		return Axis * Angle;
+	}
+
+	/**
+	 * Least-squares slope of values over time.
+	 * Times are relative to the latest sample to keep precision for large world times.
+	 */
+	template <typename GetValueFunc>
+	bool FitSlope(int32 NumSamples, const float* Times, GetValueFunc GetValue, FVector& OutSlope)
+	{
+		float MeanTime = 0.0f;
+		FVector MeanValue = FVector::ZeroVector;
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			MeanTime += Times[i];
+			MeanValue += GetValue(i);
+		}
+		MeanTime /= NumSamples;
+		MeanValue /= NumSamples;
+
+		float TimeVariance = 0.0f;
+		FVector Covariance = FVector::ZeroVector;
+		for (int32 i = 0; i < NumSamples; ++i)
+		{
+			const float DeltaTime = Times[i] - MeanTime;
+			TimeVariance += DeltaTime * DeltaTime;
+			Covariance += (GetValue(i) - MeanValue) * DeltaTime;
+		}
+
+		if (TimeVariance <= SMALL_NUMBER)
+		{
+			OutSlope = FVector::ZeroVector;
+			return false;
+		}
+
+		OutSlope = Covariance / TimeVariance;
+		return true;
+	}
+}
+
+void FUxtPointerKinematics::Reset()
+{
+	Head = 0;
+	NumSamples = 0;
+}
+
+void FUxtPointerKinematics::AddSample(float Time, const FTransform& Transform)
+{
+	if (NumSamples > 0)
+	{
+		const float LatestTime = GetSample(0).Time;
+		if (Time < LatestTime)
+		{
+			return;
+		}
+
+		// Multiple updates in the same frame replace the previous sample
+		if (Time == LatestTime)
+		{
+			Head = (Head + Capacity - 1) % Capacity;
+			--NumSamples;
+		}
+	}
+
+	FSample& Sample = Samples[Head];
+	Sample.Time = Time;
+	Sample.Location = Transform.GetLocation();
+	Sample.Rotation = Transform.GetRotation();
+
+	Head = (Head + 1) % Capacity;
+	NumSamples = FMath::Min(NumSamples + 1, Capacity);
+}
+
+float FUxtPointerKinematics::GetLatestTime() const
+{
+	return NumSamples > 0 ? GetSample(0).Time : 0.0f;
+}
+
+FTransform FUxtPointerKinematics::GetLatestTransform() const
+{
+	if (NumSamples > 0)
+	{
+		const FSample& Latest = GetSample(0);
+		return FTransform(Latest.Rotation, Latest.Location);
+	}
+	return FTransform::Identity;
+}
+
+bool FUxtPointerKinematics::GetLinearVelocity(float Window, FVector& OutVelocity) const
+{
+	const int32 NumInWindow = GetNumSamplesInWindow(Window);
+	if (NumInWindow < 2)
+	{
+		OutVelocity = FVector::ZeroVector;
+		return false;
+	}
+
+	const FSample& Latest = GetSample(0);
+	float Times[Capacity];
+	for (int32 i = 0; i < NumInWindow; ++i)
+	{
+		Times[i] = GetSample(i).Time - Latest.Time;
+	}
+
+	return FitSlope(NumInWindow, Times, [this, &Latest](int32 i) { return GetSample(i).Location - Latest.Location; }, OutVelocity);
+}
+
+bool FUxtPointerKinematics::GetAngularVelocity(float Window, FVector& OutVelocity) const
+{
+	const int32 NumInWindow = GetNumSamplesInWindow(Window);
+	if (NumInWindow < 2)
+	{
+		OutVelocity = FVector::ZeroVector;
+		return false;
+	}
+
+	// Express rotations as rotation vectors relative to the latest sample,
+	// the slope of which is the angular velocity for small time windows.
+	const FSample& Latest = GetSample(0);
+	const FQuat InvLatestRotation = Latest.Rotation.Inverse();
+	float Times[Capacity];
+	FVector RotationVectors[Capacity];
+	for (int32 i = 0; i < NumInWindow; ++i)
+	{
+		const FSample& Sample = GetSample(i);
+		Times[i] = Sample.Time - Latest.Time;
+		RotationVectors[i] = GetRotationVector(Sample.Rotation * InvLatestRotation);
+	}
+
+	return FitSlope(NumInWindow, Times, [&RotationVectors](int32 i) { return RotationVectors[i]; }, OutVelocity);
+}
+
+const FUxtPointerKinematics::FSample& FUxtPointerKinematics::GetSample(int32 Age) const
+{
+	check(Age >= 0 && Age < NumSamples);
+	return Samples[(Head + Capacity - 1 - Age) % Capacity];
+}
+
+int32 FUxtPointerKinematics::GetNumSamplesInWindow(float Window) const
+{
+	if (NumSamples == 0)
+	{
+		return 0;
+	}
+
+	const float MinTime = GetSample(0).Time - Window;
+	int32 Count = 1;
+	while (Count < NumSamples && GetSample(Count).Time >= MinTime)
+	{
+		++Count;
+	}
+	return Count;
+}
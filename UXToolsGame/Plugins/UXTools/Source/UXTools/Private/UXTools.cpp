@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "UXTools.h"
+#include "Utils/UxtDefaultAssets.h"
+#include "Utils/UxtFlightRecorder.h"
+
+#include "Misc/CoreDelegates.h"
 
 DEFINE_LOG_CATEGORY(UXTools)
 
@@ -10,12 +14,22 @@ DEFINE_LOG_CATEGORY(UXTools)
 void FUXToolsModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	FUxtFlightRecorder::RegisterCrashHandler();
+
+	// Start loading default assets as soon as the asset manager exists, so they are ready before the first pointer is spawned
+	PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddLambda([] { FUxtDefaultAssets::Get().Preload(); });
 }
 
 void FUXToolsModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+	FUxtFlightRecorder::UnregisterCrashHandler();
+
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FUxtDefaultAssets::Get().Reset();
 }
 
 #undef LOCTEXT_NAMESPACE
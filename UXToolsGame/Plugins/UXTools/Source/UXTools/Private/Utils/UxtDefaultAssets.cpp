@@ -0,0 +1,184 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Utils/UxtDefaultAssets.h"
+#include "UXTools.h"
+
+#include "Engine/AssetManager.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StreamableManager.h"
+#include "HAL/PlatformTime.h"
+#include "Materials/MaterialInterface.h"
+#include "Materials/MaterialParameterCollection.h"
+
+FUxtDefaultAssets& FUxtDefaultAssets::Get()
+{
+	static FUxtDefaultAssets DefaultAssets;
+	return DefaultAssets;
+}
+
+FUxtDefaultAssets::FUxtDefaultAssets()
+	: RingCursorMesh(FSoftObjectPath(TEXT("/UXTools/Pointers/SM_UnitQuad.SM_UnitQuad")))
+	, RingCursorMaterial(FSoftObjectPath(TEXT("/UXTools/Pointers/M_RingCursor.M_RingCursor")))
+	, BeamMesh(FSoftObjectPath(TEXT("/UXTools/Pointers/SM_Beam.SM_Beam")))
+	, BeamMaterial(FSoftObjectPath(TEXT("/UXTools/Pointers/M_Beam.M_Beam")))
+	, PointerPositions(FSoftObjectPath(TEXT("/UXTools/Pointers/PointerPositions.PointerPositions")))
+	, AffordanceCubeMesh(FSoftObjectPath(TEXT("/Engine/BasicShapes/Cube.Cube")))
+	, AffordanceSphereMesh(FSoftObjectPath(TEXT("/Engine/BasicShapes/Sphere.Sphere")))
+{
+}
+
+void FUxtDefaultAssets::Preload()
+{
+	if (Handle.IsValid() || bLoadCompleted)
+	{
+		return;
+	}
+
+	// The asset manager is created during engine initialization, loading starts on first use after that
+	if (!UAssetManager::IsValid())
+	{
+		return;
+	}
+
+	// Also request assets that are in memory already, e.g. in the editor, the handle keeps them from being collected
+	LoadStartCycles = FPlatformTime::Cycles64();
+	Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(
+		GetAssetPaths(), FStreamableDelegate::CreateRaw(this, &FUxtDefaultAssets::OnLoadCompleted), FStreamableManager::AsyncLoadHighPriority);
+}
+
+bool FUxtDefaultAssets::IsLoaded() const
+{
+	return bLoadCompleted;
+}
+
+void FUxtDefaultAssets::CallWhenLoaded(const UObject* Owner, TFunction<void()> Callback)
+{
+	if (!bLoadCompleted)
+	{
+		Preload();
+	}
+
+	if (bLoadCompleted)
+	{
+		Callback();
+	}
+	else
+	{
+		PendingCallbacks.Add({ FWeakObjectPtr(Owner), MoveTemp(Callback) });
+	}
+}
+
+void FUxtDefaultAssets::WaitUntilLoaded()
+{
+	if (bLoadCompleted)
+	{
+		return;
+	}
+
+	Preload();
+
+	if (Handle.IsValid())
+	{
+		Handle->WaitUntilComplete();
+
+		// The completion delegate may be deferred to the next tick
+		if (Handle->HasLoadCompleted())
+		{
+			OnLoadCompleted();
+		}
+	}
+}
+
+double FUxtDefaultAssets::GetLoadTimeMs() const
+{
+	return FPlatformTime::ToMilliseconds64(LoadCycles);
+}
+
+void FUxtDefaultAssets::Reset()
+{
+	if (Handle.IsValid())
+	{
+		Handle->CancelHandle();
+		Handle.Reset();
+	}
+
+	// Pending callbacks stay registered, components waiting for the assets get them from the next load
+	bLoadCompleted = false;
+}
+
+UStaticMesh* FUxtDefaultAssets::GetRingCursorMesh() const
+{
+	return RingCursorMesh.Get();
+}
+
+UMaterialInterface* FUxtDefaultAssets::GetRingCursorMaterial() const
+{
+	return RingCursorMaterial.Get();
+}
+
+UStaticMesh* FUxtDefaultAssets::GetBeamMesh() const
+{
+	return BeamMesh.Get();
+}
+
+UMaterialInterface* FUxtDefaultAssets::GetBeamMaterial() const
+{
+	return BeamMaterial.Get();
+}
+
+UMaterialParameterCollection* FUxtDefaultAssets::GetPointerPositions() const
+{
+	return PointerPositions.Get();
+}
+
+UStaticMesh* FUxtDefaultAssets::GetAffordanceCubeMesh() const
+{
+	return AffordanceCubeMesh.Get();
+}
+
+UStaticMesh* FUxtDefaultAssets::GetAffordanceSphereMesh() const
+{
+	return AffordanceSphereMesh.Get();
+}
+
+TArray<FSoftObjectPath> FUxtDefaultAssets::GetAssetPaths() const
+{
+	return {
+		RingCursorMesh.ToSoftObjectPath(),
+		RingCursorMaterial.ToSoftObjectPath(),
+		BeamMesh.ToSoftObjectPath(),
+		BeamMaterial.ToSoftObjectPath(),
+		PointerPositions.ToSoftObjectPath(),
+		AffordanceCubeMesh.ToSoftObjectPath(),
+		AffordanceSphereMesh.ToSoftObjectPath() };
+}
+
+void FUxtDefaultAssets::OnLoadCompleted()
+{
+	if (bLoadCompleted)
+	{
+		return;
+	}
+	bLoadCompleted = true;
+	LoadCycles = FPlatformTime::Cycles64() - LoadStartCycles;
+
+	for (const FSoftObjectPath& Path : GetAssetPaths())
+	{
+		if (!Path.ResolveObject())
+		{
+			UE_LOG(UXTools, Error, TEXT("Could not load default asset '%s'."), *Path.ToString());
+		}
+	}
+
+	// Callbacks may register new callbacks
+	TArray<FPendingCallback> Callbacks = MoveTemp(PendingCallbacks);
+	PendingCallbacks.Reset();
+	for (FPendingCallback& Pending : Callbacks)
+	{
+		if (Pending.Owner.IsValid())
+		{
+			Pending.Callback();
+		}
+	}
+}
@@ -0,0 +1,351 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Utils/UxtFlightRecorder.h"
+#include "UXTools.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFilemanager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/DateTime.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectArray.h"
+
+namespace
+{
+	const uint32 DumpMagic = 0x52465855; // "UXFR"
+	const int32 DumpVersion = 1;
+
+	/** Number of events kept by default, about a minute of pointer samples for two hands. */
+	const uint32 DefaultCapacity = 16384;
+
+	int32 GFlightRecorderEnabled = 1;
+
+	FAutoConsoleVariableRef CVarFlightRecorderEnabled(
+		TEXT("UXTools.FlightRecorder.Enabled"),
+		GFlightRecorderEnabled,
+		TEXT("Record pointer and interaction events in the UX Tools flight recorder."));
+
+	void DumpCommand(const TArray<FString>& Args)
+	{
+		const FString Filename = FUxtFlightRecorder::Get().Dump(Args.Num() > 0 ? Args[0] : FString());
+		if (!Filename.IsEmpty())
+		{
+			UE_LOG(UXTools, Display, TEXT("Flight recorder written to %s"), *Filename);
+		}
+	}
+
+	FAutoConsoleCommand DumpConsoleCommand(
+		TEXT("UXTools.FlightRecorder.Dump"),
+		TEXT("Write the UX Tools flight recorder buffer to a file, by default in Saved/UXTools/FlightRecorder."),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&DumpCommand));
+
+	FString GetDefaultDumpFilename(const TCHAR* Prefix)
+	{
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UXTools"), TEXT("FlightRecorder"),
+			FString::Printf(TEXT("%s%s.uxtflight"), Prefix, *FDateTime::Now().ToString()));
+	}
+
+	/** Size of an event as serialized by operator<<, see FUxtFlightEvent. */
+	const uint64 SerializedEventSize = sizeof(uint64) + 3 * sizeof(uint32) + 2 * sizeof(uint8) + 3 * sizeof(float);
+
+	/** Size of the dump header, the event count and the empty name map. */
+	const uint64 SerializedHeaderSize = sizeof(uint32) + sizeof(int32) + sizeof(double) + sizeof(uint64) + 2 * sizeof(int32);
+
+	/** Crash dump file and buffer, allocated when the crash handler is registered. */
+	FString CrashDumpFilename;
+	TArray<uint8> CrashDumpBuffer;
+
+	/** Appends values to a preallocated buffer in the byte order of FArchive on this platform. */
+	struct FRawWriter
+	{
+		uint8* Data;
+		uint64 Size;
+		uint64 Offset = 0;
+
+		template <typename T>
+		void Write(const T& Value)
+		{
+			check(Offset + sizeof(T) <= Size);
+			FMemory::Memcpy(Data + Offset, &Value, sizeof(T));
+			Offset += sizeof(T);
+		}
+	};
+}
+
+FArchive& operator<<(FArchive& Ar, FUxtFlightEvent& Event)
+{
+	uint8 Type = static_cast<uint8>(Event.Type);
+	uint8 Interaction = static_cast<uint8>(Event.Interaction);
+
+	Ar << Event.Cycles << Event.Frame << Event.PointerId << Event.TargetId << Type << Interaction << Event.Location;
+
+	Event.Type = static_cast<EUxtFlightEventType>(Type);
+	Event.Interaction = static_cast<EUxtFlightInteraction>(Interaction);
+	return Ar;
+}
+
+bool FUxtFlightDump::Save(const FString& Filename) const
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Filename));
+	if (!Ar)
+	{
+		return false;
+	}
+
+	uint32 Magic = DumpMagic;
+	int32 Version = DumpVersion;
+	double SecondsPerCycleCopy = SecondsPerCycle;
+	uint64 NumRecordedCopy = NumRecorded;
+	*Ar << Magic << Version << SecondsPerCycleCopy << NumRecordedCopy;
+
+	// Serialization of containers is not const
+	*Ar << const_cast<TArray<FUxtFlightEvent>&>(Events);
+	*Ar << const_cast<TMap<uint32, FString>&>(Names);
+
+	return Ar->Close();
+}
+
+bool FUxtFlightDump::Load(const FString& Filename)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Filename));
+	if (!Ar)
+	{
+		return false;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	*Ar << Magic << Version;
+	if (Magic != DumpMagic || Version != DumpVersion)
+	{
+		return false;
+	}
+
+	*Ar << SecondsPerCycle << NumRecorded;
+	*Ar << Events;
+	*Ar << Names;
+
+	return !Ar->IsError();
+}
+
+FString FUxtFlightDump::GetName(uint32 Id) const
+{
+	if (const FString* Name = Names.Find(Id))
+	{
+		return *Name;
+	}
+	return FString::Printf(TEXT("#%u"), Id);
+}
+
+FDelegateHandle FUxtFlightRecorder::SystemErrorHandle;
+
+FUxtFlightRecorder& FUxtFlightRecorder::Get()
+{
+	static FUxtFlightRecorder Recorder([]
+		{
+			uint32 RequestedCapacity = DefaultCapacity;
+			FParse::Value(FCommandLine::Get(), TEXT("UxtFlightRecorderCapacity="), RequestedCapacity);
+			return RequestedCapacity;
+		}());
+	return Recorder;
+}
+
+FUxtFlightRecorder::FUxtFlightRecorder(uint32 InCapacity)
+{
+	Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InCapacity, 2u));
+	Slots = MakeUnique<FSlot[]>(Capacity);
+}
+
+void FUxtFlightRecorder::Record(EUxtFlightEventType Type, EUxtFlightInteraction Interaction, const UObject* Pointer, const UObject* Target, const FVector& Location)
+{
+	if (!GFlightRecorderEnabled)
+	{
+		return;
+	}
+
+	// Claim a slot, the oldest event is overwritten once the buffer is full.
+	const uint64 Index = WriteIndex++;
+	FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+	// Take ownership of the slot, readers discard it until the new sequence number is published.
+	// Writers a whole lap apart can claim the same slot, the event is dropped if another writer owns it or has written a newer event.
+	uint64 Sequence = Slot.Sequence.Load();
+	do
+	{
+		if (Sequence == WritingSequence || Sequence > Index)
+		{
+			return;
+		}
+	} while (!Slot.Sequence.CompareExchange(Sequence, WritingSequence));
+
+	FUxtFlightEvent& Event = Slot.Event;
+	Event.Cycles = FPlatformTime::Cycles64();
+	Event.Frame = static_cast<uint32>(GFrameCounter);
+	Event.PointerId = Pointer ? Pointer->GetUniqueID() : 0;
+	Event.TargetId = Target ? Target->GetUniqueID() : 0;
+	Event.Type = Type;
+	Event.Interaction = Interaction;
+	Event.Location = Location;
+
+	FPlatformMisc::MemoryBarrier();
+	Slot.Sequence.Store(Index + 1, EMemoryOrder::Relaxed);
+}
+
+void FUxtFlightRecorder::Snapshot(FUxtFlightDump& OutDump, bool bResolveNames) const
+{
+	const uint64 End = WriteIndex.Load();
+	const uint64 Begin = End > Capacity ? End - Capacity : 0;
+
+	OutDump.SecondsPerCycle = FPlatformTime::GetSecondsPerCycle64();
+	OutDump.NumRecorded = End;
+	OutDump.Events.Reset(static_cast<int32>(End - Begin));
+	OutDump.Names.Reset();
+
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index & (Capacity - 1)];
+
+		// Skip slots that are being written or have been overwritten while copying.
+		if (Slot.Sequence.Load(EMemoryOrder::Relaxed) != Index + 1)
+		{
+			continue;
+		}
+		FPlatformMisc::MemoryBarrier();
+		const FUxtFlightEvent Event = Slot.Event;
+		FPlatformMisc::MemoryBarrier();
+		if (Slot.Sequence.Load(EMemoryOrder::Relaxed) == Index + 1)
+		{
+			OutDump.Events.Add(Event);
+		}
+	}
+
+	if (bResolveNames)
+	{
+		check(IsInGameThread());
+
+		// IDs are object indices, so only objects that are still alive can be named.
+		// An index may have been reused by a newer object, names are a hint.
+		for (const FUxtFlightEvent& Event : OutDump.Events)
+		{
+			for (uint32 Id : { Event.PointerId, Event.TargetId })
+			{
+				if (Id != 0 && !OutDump.Names.Contains(Id))
+				{
+					const FUObjectItem* Item = GUObjectArray.IndexToObject(static_cast<int32>(Id));
+					if (Item && Item->Object)
+					{
+						OutDump.Names.Add(Id, static_cast<UObject*>(Item->Object)->GetPathName());
+					}
+				}
+			}
+		}
+	}
+}
+
+FString FUxtFlightRecorder::Dump(const FString& Filename, bool bResolveNames) const
+{
+	FUxtFlightDump FlightDump;
+	Snapshot(FlightDump, bResolveNames);
+
+	const FString OutFilename = Filename.IsEmpty() ? GetDefaultDumpFilename(TEXT("")) : Filename;
+	if (!FlightDump.Save(OutFilename))
+	{
+		UE_LOG(UXTools, Warning, TEXT("Failed to write flight recorder to %s"), *OutFilename);
+		return FString();
+	}
+	return OutFilename;
+}
+
+uint64 FUxtFlightRecorder::GetRawDumpSize() const
+{
+	return SerializedHeaderSize + Capacity * SerializedEventSize;
+}
+
+bool FUxtFlightRecorder::DumpRaw(const TCHAR* Filename, uint8* Buffer, uint64 BufferSize) const
+{
+	if (BufferSize < GetRawDumpSize())
+	{
+		return false;
+	}
+
+	const uint64 End = WriteIndex.Load();
+	const uint64 Begin = End > Capacity ? End - Capacity : 0;
+
+	// Same layout as FUxtFlightDump::Save, the event count is written once the valid events are known
+	FRawWriter Writer { Buffer, BufferSize };
+	Writer.Write(DumpMagic);
+	Writer.Write(DumpVersion);
+	Writer.Write(FPlatformTime::GetSecondsPerCycle64());
+	Writer.Write(End);
+	const uint64 NumEventsOffset = Writer.Offset;
+	Writer.Write(int32(0));
+
+	int32 NumEvents = 0;
+	for (uint64 Index = Begin; Index < End; ++Index)
+	{
+		const FSlot& Slot = Slots[Index & (Capacity - 1)];
+		if (Slot.Sequence.Load(EMemoryOrder::Relaxed) != Index + 1)
+		{
+			continue;
+		}
+		FPlatformMisc::MemoryBarrier();
+		const FUxtFlightEvent Event = Slot.Event;
+		FPlatformMisc::MemoryBarrier();
+		if (Slot.Sequence.Load(EMemoryOrder::Relaxed) != Index + 1)
+		{
+			continue;
+		}
+
+		Writer.Write(Event.Cycles);
+		Writer.Write(Event.Frame);
+		Writer.Write(Event.PointerId);
+		Writer.Write(Event.TargetId);
+		Writer.Write(static_cast<uint8>(Event.Type));
+		Writer.Write(static_cast<uint8>(Event.Interaction));
+		Writer.Write(Event.Location.X);
+		Writer.Write(Event.Location.Y);
+		Writer.Write(Event.Location.Z);
+		++NumEvents;
+	}
+
+	// Names can not be resolved without allocating, the analyzer shows IDs instead.
+	Writer.Write(int32(0));
+	FMemory::Memcpy(Buffer + NumEventsOffset, &NumEvents, sizeof(NumEvents));
+
+	IFileHandle* File = FPlatformFileManager::Get().GetPlatformFile().OpenWrite(Filename);
+	if (!File)
+	{
+		return false;
+	}
+	const bool bWritten = File->Write(Buffer, Writer.Offset);
+	delete File;
+	return bWritten;
+}
+
+void FUxtFlightRecorder::RegisterCrashHandler()
+{
+	if (!SystemErrorHandle.IsValid())
+	{
+		// Everything the crash handler needs is allocated up front, so the dump has a name from the time of registration.
+		CrashDumpFilename = GetDefaultDumpFilename(TEXT("Crash-"));
+		CrashDumpBuffer.SetNumUninitialized(Get().GetRawDumpSize());
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(CrashDumpFilename), true);
+
+		SystemErrorHandle = FCoreDelegates::OnHandleSystemError.AddLambda([]
+			{
+				Get().DumpRaw(*CrashDumpFilename, CrashDumpBuffer.GetData(), CrashDumpBuffer.Num());
+			});
+	}
+}
+
+void FUxtFlightRecorder::UnregisterCrashHandler()
+{
+	FCoreDelegates::OnHandleSystemError.Remove(SystemErrorHandle);
+	SystemErrorHandle.Reset();
+
+	CrashDumpFilename.Empty();
+	CrashDumpBuffer.Empty();
+}
@@ -0,0 +1,353 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Utils/UxtMathKernels.h"
+#include "Controls/UxtBoundingBoxManipulatorComponent.h"
+
+namespace
+{
+	float SimplifyAngle(float Angle)
+	{
+		while (Angle > PI)
+		{
+			Angle -= 2 * PI;
+		}
+
+		while (Angle < -PI)
+		{
+			Angle += 2 * PI;
+		}
+
+		return Angle;
+	}
+
+	float AngleBetweenVectorAndPlane(FVector Vec, FVector Normal)
+	{
+		Vec.Normalize();
+		Normal.Normalize();
+		return (PI / 2) - FMath::Acos(FVector::DotProduct(Vec, Normal));
+	}
+}
+
+float FUxtMathKernels::AngleBetweenOnPlane(FVector From, FVector To, FVector Normal)
+{
+	From.Normalize();
+	To.Normalize();
+	Normal.Normalize();
+
+	FVector Right = FVector::CrossProduct(Normal, From);
+	FVector Forward = FVector::CrossProduct(Right, Normal);
+
+	float Angle = FMath::Atan2(FVector::DotProduct(To, Right), FVector::DotProduct(To, Forward));
+
+	return SimplifyAngle(Angle);
+}
+
+bool FUxtMathKernels::AngularClamp(
+	FVector RefPosition,
+	FQuat RefRotation,
+	FVector CurrentPosition,
+	bool bIgnoreVertical,
+	float MaxHorizontalDegrees,
+	float MaxVerticalDegrees,
+	FVector& RefForward)
+{
+	FVector ToTarget = CurrentPosition - RefPosition;
+	float CurrentDistance = ToTarget.Size();
+	if (CurrentDistance <= 0)
+	{
+		// No need to clamp
+		return false;
+	}
+
+	ToTarget.Normalize();
+
+	// Start off with a rotation towards the target. If it's within leashing bounds, we can leave it alone.
+	FQuat Rotation = ToTarget.ToOrientationQuat();
+
+	// This is the meat of the leashing algorithm. The goal is to ensure that the reference's forward
+	// vector remains within the bounds set by the leashing parameters. To do this, determine the angles
+	// between toTarget and the leashing bounds about the global Z axis and the reference's X axis.
+	// If toTarget falls within the leashing bounds, then we don't have to modify it.
+	// Otherwise, we apply a correction rotation to bring it within bounds.
+
+	FVector CurrentRefForward = RefRotation * FVector::ForwardVector;
+	FVector RefRight = RefRotation * FVector::RightVector;
+
+	bool bAngularClamped = false;
+
+	// X-axis leashing
+	// Leashing around the reference's X axis only makes sense if the reference isn't gravity aligned.
+	if (bIgnoreVertical)
+	{
+		float Angle = AngleBetweenOnPlane(ToTarget, CurrentRefForward, RefRight);
+		Rotation = FQuat(RefRight, Angle) * Rotation;
+	}
+	else
+	{
+		// These are negated because Unreal is left-handed
+		float Angle = -AngleBetweenOnPlane(ToTarget, CurrentRefForward, RefRight);
+		float MinMaxAngle = FMath::DegreesToRadians(MaxVerticalDegrees) * 0.5f;
+
+		if (Angle < -MinMaxAngle)
+		{
+			Rotation = FQuat(RefRight, -MinMaxAngle - Angle) * Rotation;
+			bAngularClamped = true;
+		}
+		else if (Angle > MinMaxAngle)
+		{
+			Rotation = FQuat(RefRight, MinMaxAngle - Angle) * Rotation;
+			bAngularClamped = true;
+		}
+	}
+
+	// Z-axis leashing
+	{
+		float Angle = AngleBetweenVectorAndPlane(ToTarget, RefRight);
+		float MinMaxAngle = FMath::DegreesToRadians(MaxHorizontalDegrees) * 0.5f;
+
+		if (Angle < -MinMaxAngle)
+		{
+			Rotation = FQuat(FVector::UpVector, -MinMaxAngle - Angle) * Rotation;
+			bAngularClamped = true;
+		}
+		else if (Angle > MinMaxAngle)
+		{
+			Rotation = FQuat(FVector::UpVector, MinMaxAngle - Angle) * Rotation;
+			bAngularClamped = true;
+		}
+	}
+
+	RefForward = Rotation * FVector::ForwardVector;
+
+	return bAngularClamped;
+}
+
+bool FUxtMathKernels::DistanceClamp(
+	float DeltaTime,
+	float MinDistance,
+	float DefaultDistanceIn,
+	float MaxDistance,
+	bool bMaintainPitch,
+	FVector CurrentPosition,
+	FVector RefPosition,
+	FVector RefForward,
+	bool bInterpolateToDefaultDistance,
+	float MoveToDefaultDistanceLerpTime,
+	FVector& ClampedPosition)
+{
+	float ClampedDistance;
+	float CurrentDistance = FVector::Distance(CurrentPosition, RefPosition);
+	FVector Direction = RefForward;
+
+	if (bMaintainPitch)
+	{
+		// If we don't account for pitch offset, the casted object will float up/down as the reference
+		// gets closer to it because we will still be casting in the direction of the pitched offset.
+		// To fix this, only modify the XZ position of the object.
+
+		FVector DirectionYX = RefForward;
+		DirectionYX.Z = 0;
+		DirectionYX.Normalize();
+
+		FVector RefToElementYX = CurrentPosition - RefPosition;
+		RefToElementYX.Z = 0;
+		float DesiredDistanceYX = RefToElementYX.Size();
+
+		FVector MinDistanceYXVector = RefForward * MinDistance;
+		MinDistanceYXVector.Z = 0;
+		float MinDistanceYX = MinDistanceYXVector.Size();
+
+		FVector MaxDistanceYXVector = RefForward * MaxDistance;
+		MaxDistanceYXVector.Z = 0;
+		float MaxDistanceYX = MaxDistanceYXVector.Size();
+
+		DesiredDistanceYX = FMath::Clamp(DesiredDistanceYX, MinDistanceYX, MaxDistanceYX);
+
+		if (bInterpolateToDefaultDistance)
+		{
+			FVector DefaultDistanceYXVector = Direction * DefaultDistanceIn;
+			DefaultDistanceYXVector.Z = 0;
+			float DefaulltDistanceYX = DefaultDistanceYXVector.Size();
+
+			float interpolationRate = FMath::Min(MoveToDefaultDistanceLerpTime * DeltaTime, 1.0f);
+			DesiredDistanceYX = DesiredDistanceYX + (interpolationRate * (DefaulltDistanceYX - DesiredDistanceYX));
+		}
+
+		FVector DesiredPosition = RefPosition + DirectionYX * DesiredDistanceYX;
+		float DesiredHeight = RefPosition.Z + RefForward.Z * MaxDistance;
+		DesiredPosition.Z = DesiredHeight;
+
+		Direction = DesiredPosition - RefPosition;
+		ClampedDistance = Direction.Size();
+		Direction /= ClampedDistance;
+
+		ClampedDistance = FMath::Max(MinDistance, ClampedDistance);
+	}
+	else
+	{
+		ClampedDistance = CurrentDistance;
+
+		if (bInterpolateToDefaultDistance)
+		{
+			float InterpolationRate = FMath::Min(MoveToDefaultDistanceLerpTime * DeltaTime, 1.0f);
+			ClampedDistance = ClampedDistance + (InterpolationRate * (DefaultDistanceIn - ClampedDistance));
+		}
+
+		ClampedDistance = FMath::Clamp(ClampedDistance, MinDistance, MaxDistance);
+	}
+
+	ClampedPosition = RefPosition + Direction * ClampedDistance;
+
+	return !ClampedPosition.Equals(CurrentPosition, 1.0f);
+}
+
+float FUxtMathKernels::GetDistanceToBody(const FVector& PointerCentroidPosition, const FVector& HeadPosition)
+{
+	// The body is treated as a ray, parallel to the y-axis, where the start is head position.
+	// This means that moving your hand down such that is the same distance from the body will
+	// not cause the manipulated object to move further away from your hand. However, when you
+	// move your hand upward, away from your head, the manipulated object will be pushed away.
+	if (PointerCentroidPosition.Z > HeadPosition.Z)
+	{
+		return FVector::Dist(PointerCentroidPosition, HeadPosition);
+	}
+	else
+	{
+		FVector2D HeadPosXZ(HeadPosition.X, HeadPosition.Y);
+		FVector2D PointerPosXZ(PointerCentroidPosition.X, PointerCentroidPosition.Y);
+
+		return FVector2D::Distance(PointerPosXZ, HeadPosXZ);
+	}
+}
+
+FVector FUxtMathKernels::ManipulationMove(const FTransform& PointerCentroidPose, const FQuat& ObjectRotation, const FVector& ObjectScale, bool UsePointerRotation,
+	float DistanceRatio, const FVector& PointerLocalGrabPoint, const FVector& ObjectLocalGrabPoint, const FVector& GrabToObject)
+{
+	if (UsePointerRotation)
+	{
+		FVector ScaledGrabToObject = ObjectLocalGrabPoint * ObjectScale;
+		FVector AdjustedPointerToGrab = PointerLocalGrabPoint * DistanceRatio;
+		AdjustedPointerToGrab = PointerCentroidPose.GetRotation() * AdjustedPointerToGrab;
+
+		return AdjustedPointerToGrab - ObjectRotation * ScaledGrabToObject + PointerCentroidPose.GetLocation();
+	}
+	else
+	{
+		return PointerCentroidPose.GetLocation() + (PointerCentroidPose.GetRotation() * PointerLocalGrabPoint + GrabToObject) * DistanceRatio;
+	}
+}
+
+FQuat FUxtMathKernels::TwoHandRotate(const FVector& StartHandleBar, const FVector& HandleBar, const FQuat& StartRotation)
+{
+	FQuat Rot = FQuat::FindBetween(StartHandleBar, HandleBar);
+	Rot.Normalize();
+	return Rot * StartRotation;
+}
+
+float FUxtMathKernels::GetMinDistanceBetweenPoints(TArrayView<const FVector> Points)
+{
+	float Result = TNumericLimits<float>::Max();
+	for (int i = 0; i < Points.Num(); i++)
+	{
+		for (int j = i + 1; j < Points.Num(); j++)
+		{
+			float Distance = FVector::Dist(Points[i], Points[j]);
+			if (Distance < Result)
+			{
+				Result = Distance;
+			}
+		}
+	}
+	return Result;
+}
+
+void FUxtMathKernels::ComputeModifiedBounds(EUxtBoundingBoxAffordanceAction Action, const FVector& AffordanceLocation, const FMatrix& ConstraintMatrix,
+	const FTransform& InitialTransform, const FBox& InitialBounds, const FVector& LocalGrabPoint, const FVector& TargetLocation, FBox& OutBounds, FQuat& OutDeltaRotation)
+{
+	//
+	// Compute grab pointer movement
+
+	const FVector localTarget = InitialTransform.InverseTransformPosition(TargetLocation);
+
+	//
+	// Compute modified bounding box
+
+	OutBounds = InitialBounds;
+	OutDeltaRotation = FQuat::Identity;
+
+	switch (Action)
+	{
+	case EUxtBoundingBoxAffordanceAction::Resize:
+	{
+
+		FVector localDelta = localTarget - LocalGrabPoint;
+		FVector constrainedDelta = ConstraintMatrix.TransformVector(localDelta);
+
+		// Influence factors based on location: only move the side the affordance is on
+		FVector minFactor = (-AffordanceLocation).ComponentMax(FVector::ZeroVector);
+		FVector maxFactor = AffordanceLocation.ComponentMax(FVector::ZeroVector);
+		OutBounds.Min += constrainedDelta * minFactor;
+		OutBounds.Max += constrainedDelta * maxFactor;
+		break;
+	}
+
+	case EUxtBoundingBoxAffordanceAction::Translate:
+	{
+		FVector localDelta = localTarget - LocalGrabPoint;
+		FVector constrainedDelta = ConstraintMatrix.TransformVector(localDelta);
+
+		// All sides moving together
+		OutBounds.Min += constrainedDelta;
+		OutBounds.Max += constrainedDelta;
+		break;
+	}
+
+	case EUxtBoundingBoxAffordanceAction::Scale:
+	{
+		FVector localDelta = localTarget - LocalGrabPoint;
+		FVector constrainedDelta = ConstraintMatrix.TransformVector(localDelta);
+
+		// Influence factors based on location: move opposing sides in opposite directions
+		FVector minFactor = -AffordanceLocation;
+		FVector maxFactor = AffordanceLocation;
+		OutBounds.Min += constrainedDelta * minFactor;
+		OutBounds.Max += constrainedDelta * maxFactor;
+		break;
+	}
+
+	case EUxtBoundingBoxAffordanceAction::Rotate:
+	{
+		FVector localCenter = InitialBounds.GetCenter();
+		// Apply constraints to the grab and target vectors.
+		FVector constrainedGrab = ConstraintMatrix.TransformVector(LocalGrabPoint - localCenter);
+		FVector constrainedTarget = ConstraintMatrix.TransformVector(localTarget - localCenter);
+		FQuat baseRotation = FQuat::FindBetweenVectors(constrainedGrab, constrainedTarget);
+		FQuat initRot = InitialTransform.GetRotation();
+		OutDeltaRotation = initRot * baseRotation * initRot.Inverse();
+		break;
+	}
+	}
+}
+
+bool FUxtMathKernels::IsBehindFrontFace(const FTransform& ColliderTransform, const FVector& Extents, const FVector& PointerPosition, float Radius)
+{
+	FVector LocalPosition = ColliderTransform.ToMatrixNoScale().InverseTransformPosition(PointerPosition);
+
+	return LocalPosition.X + Radius > -Extents.X;
+}
+
+bool FUxtMathKernels::IsFrontFacePokeEnded(const FTransform& ColliderTransform, const FVector& Extents, const FVector& PointerPosition, float Radius, float Depth)
+{
+	FVector LocalPosition = ColliderTransform.ToMatrixNoScale().InverseTransformPosition(PointerPosition);
+
+	FVector Min = -Extents;
+
+	FVector Max = Extents;
+	Max.X = -Max.X + Depth; // depth is measured from the front face
+
+	FBox PokableVolume(Min, Max);
+	FSphere PokeSphere(LocalPosition, Radius);
+
+	return !FMath::SphereAABBIntersection(PokeSphere, PokableVolume);
+}
@@ -0,0 +1,61 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "Utils/UxtStats.h"
+
+DEFINE_STAT(STAT_UxtNearPointerTick);
+DEFINE_STAT(STAT_UxtNearPointerQuery);
+DEFINE_STAT(STAT_UxtFarPointerTick);
+DEFINE_STAT(STAT_UxtFarPointerQuery);
+DEFINE_STAT(STAT_UxtHandProximityQuery);
+DEFINE_STAT(STAT_UxtFocusResolution);
+DEFINE_STAT(STAT_UxtEventDispatch);
+DEFINE_STAT(STAT_UxtManipulationSolve);
+DEFINE_STAT(STAT_UxtBoundingBoxUpdate);
+DEFINE_STAT(STAT_UxtFollowSolve);
+DEFINE_STAT(STAT_UxtButtonUpdate);
+DEFINE_STAT(STAT_UxtCursorUpdate);
+DEFINE_STAT(STAT_UxtButtonBeginPlay);
+DEFINE_STAT(STAT_UxtBoundingBoxBeginPlay);
+DEFINE_STAT(STAT_UxtHandInteractionBeginPlay);
+
+DEFINE_STAT(STAT_UxtSceneQueries);
+DEFINE_STAT(STAT_UxtTargetsEvaluated);
+
+CSV_DEFINE_CATEGORY_MODULE(UXTOOLS_API, UXTools, true);
+
+UE_TRACE_CHANNEL_DEFINE(UXToolsChannel);
+
+#if UXT_BENCHMARK_INSTRUMENTATION
+TAtomic<uint64> FUxtCounterTotals::SceneQueries(0);
+TAtomic<uint64> FUxtCounterTotals::TargetsEvaluated(0);
+
+namespace
+{
+	TMap<FName, FUxtBeginPlayCost::FEntry>& GetBeginPlayCostEntries()
+	{
+		static TMap<FName, FUxtBeginPlayCost::FEntry> Entries;
+		return Entries;
+	}
+}
+
+void FUxtBeginPlayCost::Reset()
+{
+	GetBeginPlayCostEntries().Reset();
+}
+
+void FUxtBeginPlayCost::Add(FName Name, uint64 Cycles)
+{
+	check(IsInGameThread());
+
+	FEntry& Entry = GetBeginPlayCostEntries().FindOrAdd(Name);
+	Entry.Cycles += Cycles;
+	++Entry.Calls;
+}
+
+const TMap<FName, FUxtBeginPlayCost::FEntry>& FUxtBeginPlayCost::GetEntries()
+{
+	return GetBeginPlayCostEntries();
+}
+
+#endif // UXT_BENCHMARK_INSTRUMENTATION
@@ -7,6 +7,8 @@
 #include "Components/ActorComponent.h"
 #include "UxtFollowComponent.generated.h"
 
+class UUxtFollowSubsystem;
+
 UENUM(BlueprintType)
 enum EUxtFollowOrientBehavior
 {
@@ -41,6 +43,9 @@ enum EUxtFollowOrientBehavior
  * 	Distance Clamps
  * 	The angle between the forward vector of the its owner and toTarget vector (vector between
  * 		the camera and the its owner) is larger than dead zone angle parameter
+ *
+ * Follow components do not tick individually, all active follow components of a world are updated
+ * in one batch by the UUxtFollowSubsystem.
  */
 UCLASS(ClassGroup = UXTools, meta=(BlueprintSpawnableComponent))
 class UXTOOLS_API UUxtFollowComponent : public UActorComponent
@@ -54,6 +59,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = FollowMethods)
 	void Recenter();
 
+	/** True if the owner has settled on its goal and the component waits for the reference to move. */
+	UFUNCTION(BlueprintPure, Category = FollowMethods)
+	bool IsAtRest() const;
+
 public:
 
 	/** Actor that this component will follow. If null, this component will follow the camera */
@@ -116,11 +125,43 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = FollowParameters)
 	float VerticalMaxDistance = 0.0f;
 
+	/**
+	 * Stop updating once the owner has settled on its goal, until the reference moves or rotates beyond the rest tolerances.
+	 * Parameter changes take effect once the component wakes up, call Recenter to apply them immediately.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = FollowParameters)
+	bool bSleepAtRest = true;
+
+	/** Distance to the goal below which the owner is considered settled, and distance the reference must move to wake the component. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = FollowParameters, meta = (EditCondition = "bSleepAtRest", ClampMin = "0.0"))
+	float RestPositionTolerance = 0.1f;
+
+	/** Angle to the goal below which the owner is considered settled, and angle the reference must rotate to wake the component. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = FollowParameters, meta = (EditCondition = "bSleepAtRest", ClampMin = "0.0"))
+	float RestAngleToleranceDegrees = 0.1f;
+
 protected:
 	virtual void BeginPlay() override;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void RegisterComponentTickFunctions(bool bRegister) override;
 
 private:
+
+	friend class UUxtFollowSubsystem;
+
+	/**
+	 * Run the leash solver against the given reference transform and compute the new working transform.
+	 * Does not modify the owner, so it can run in parallel for many components.
+	 * Returns false if the owner should not be moved this frame.
+	 */
+	bool UpdateGoal(float DeltaTime, const FTransform& FollowTransform);
+
+	/** Move the owner to the working transform. */
+	void ApplyWorkingTransform();
+
+	/** Returns true if the resting component should wake up. */
+	bool ShouldWake(const FTransform& FollowTransform) const;
+
 	void UpdateTransformToGoal(float DeltaTime);
 
 private:
@@ -136,6 +177,14 @@ private:
 	FVector PreviousReferencePosition;
 	FQuat PreviousReferenceRotation;
 
+	/** Follow subsystem updating this component. */
+	UPROPERTY(Transient)
+	UUxtFollowSubsystem* FollowSubsystem = nullptr;
+
+	/** Reference transform when the component came to rest. */
+	FTransform RestReferenceTransform;
+
+	bool bAtRest = false;
 	bool bRecenterNextUpdate = true;
 	bool bSkipInterpolation = false;
 	bool bHaveValidCamera = false;
@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "UxtFollowSubsystem.generated.h"
+
+class AActor;
+class UUxtFollowComponent;
+class UUxtFollowSubsystem;
+
+/** Tick function updating all follow components of a world in one batch. */
+USTRUCT()
+struct FUxtFollowTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UUxtFollowSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FUxtFollowTickFunction> : public TStructOpsTypeTraitsBase2<FUxtFollowTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Updates all follow components of a world in one batch.
+ *
+ * Components following the same actor share a reference, so the reference transform (usually the head pose)
+ * is queried once per frame for all of them. The leash solver only reads the reference and the owner transform
+ * and writes the component's own state, so large batches are solved in parallel. Owner transforms are then
+ * written back on the game thread in one pass.
+ *
+ * Follow components register themselves on BeginPlay.
+ */
+UCLASS()
+class UXTOOLS_API UUxtFollowSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//
+	// USubsystem interface
+
+	virtual void Deinitialize() override;
+
+	/** Add a follow component to the batch. */
+	void RegisterFollowComponent(UUxtFollowComponent* Follow);
+
+	/** Remove a follow component from the batch. */
+	void UnregisterFollowComponent(UUxtFollowComponent* Follow);
+
+	/** Number of registered follow components. */
+	int32 GetNumFollowComponents() const { return FollowComponents.Num(); }
+
+	/** Number of distinct references followed in the last update. */
+	int32 GetNumReferences() const { return References.Num(); }
+
+	/** Solve and move all active follow components. */
+	void UpdateFollowComponents(float DeltaTime);
+
+private:
+
+	/** Transform of an actor followed by one or more components, null for the head. */
+	struct FReference
+	{
+		const AActor* Actor;
+		FTransform Transform;
+	};
+
+	/** Returns the index of the reference for the actor, adding it if needed. */
+	int32 FindOrAddReference(const AActor* Actor);
+
+	void UpdateTickEnabled();
+
+	UPROPERTY(Transient)
+	TArray<UUxtFollowComponent*> FollowComponents;
+
+	/** Scratch buffers for the current update. */
+	TArray<FReference> References;
+	TArray<int32> ReferenceIndices;
+	TArray<uint8> Moved;
+
+	FUxtFollowTickFunction TickFunction;
+};
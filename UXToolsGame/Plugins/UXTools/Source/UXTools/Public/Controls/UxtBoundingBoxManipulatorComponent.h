@@ -11,6 +11,9 @@
 
 
 class UUxtBoundingBoxManipulatorComponent;
+class FUxtBoundsCache;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
 
 /** Defines the kind of actor that should be spawned for an affordance. */
 UENUM()
@@ -23,6 +26,20 @@ enum class EUxtBoundingBoxAffordanceKind : uint8
 };
 
 
+/** Defines how affordances are represented in the world. */
+UENUM()
+enum class EUxtBoundingBoxAffordanceMode : uint8
+{
+	/** Spawn an actor for each affordance. */
+	Actors,
+	/**
+	 * Render all affordances as instanced static meshes in a single actor.
+	 * Grabbed instances are resolved from the grab point, affordance actor classes are not used.
+	 */
+	Instanced,
+};
+
+
 /** Defines which effect moving an affordance has on the bounding box. */
 UENUM()
 enum class EUxtBoundingBoxAffordanceAction : uint8
@@ -106,6 +123,7 @@ class UXTOOLS_API UUxtBoundingBoxManipulatorComponent : public UActorComponent
 public:
 
 	UUxtBoundingBoxManipulatorComponent();
+	~UUxtBoundingBoxManipulatorComponent();
 
 	UFUNCTION(BlueprintGetter, Category = "Bounding Box")
 	const TArray<FUxtBoundingBoxAffordanceInfo>& GetCustomAffordances() const;
@@ -125,6 +143,13 @@ public:
 	UFUNCTION(BlueprintGetter, Category = "Bounding Box")
 	bool UseCustomAffordances() const;
 
+	UFUNCTION(BlueprintGetter, Category = "Bounding Box")
+	EUxtBoundingBoxAffordanceMode GetAffordanceMode() const;
+
+	/** Set how affordances are represented, only takes effect before the component begins play. */
+	UFUNCTION(BlueprintSetter, Category = "Bounding Box")
+	void SetAffordanceMode(EUxtBoundingBoxAffordanceMode Mode);
+
 	UFUNCTION(BlueprintGetter, Category = "Bounding Box")
 	EUxtBoundingBoxManipulatorPreset GetPreset() const;
 
@@ -134,6 +159,12 @@ public:
 	UFUNCTION(BlueprintGetter, Category = "Bounding Box")
 	const FBox& GetBounds() const;
 
+	UFUNCTION(BlueprintGetter, Category = "Bounding Box")
+	bool GetKeepBoundsFitted() const;
+
+	UFUNCTION(BlueprintSetter, Category = "Bounding Box")
+	void SetKeepBoundsFitted(bool bEnable);
+
 	/**
 	 * Get the list of affordances that will be used for the bounding box.
 	 * This can be a based on a preset or a custom set of affordances.
@@ -145,7 +176,20 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Bounding Box")
 	TSubclassOf<class AActor> GetAffordanceKindActorClass(EUxtBoundingBoxAffordanceKind Kind) const;
 
-	/** Compute the bounding box based on the components of the bounding box actor. */
+	/** Static mesh that will be instanced for the given kind of affordance when using instanced affordances. */
+	UFUNCTION(BlueprintPure, Category = "Bounding Box")
+	UStaticMesh* GetAffordanceKindMesh(EUxtBoundingBoxAffordanceKind Kind) const;
+
+	/** Instanced mesh components of instanced affordances, one per affordance mesh. */
+	const TArray<UInstancedStaticMeshComponent*>& GetAffordanceInstancers() const;
+
+	/** Affordance of the mesh instance closest to the location. Returns null if there are no affordance instances. */
+	const FUxtBoundingBoxAffordanceInfo* FindInstancedAffordance(const FVector& Location) const;
+
+	/**
+	 * Compute the bounding box based on the components of the bounding box actor.
+	 * All component bounds are recomputed, which also picks up shape changes that keeping bounds fitted does not detect.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "Bounding Box")
 	void ComputeBoundsFromComponents();
 
@@ -159,6 +203,7 @@ public:
 
 protected:
 
+	virtual void OnRegister() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
@@ -195,6 +240,30 @@ protected:
 	/** Update the world transforms of affordance actors to match the current bounding box. */
 	void UpdateAffordanceTransforms();
 
+	/** Spawn an actor for each affordance. */
+	void CreateAffordanceActors();
+
+	/** Spawn a single actor rendering all affordances as mesh instances. */
+	void CreateInstancedAffordances();
+
+	/** Add mesh instances of all affordances to the instanced affordance actor, replacing existing instances. */
+	void CreateAffordanceInstances();
+
+	/** Set default meshes for affordance kinds without a mesh, returns true if any mesh has been set. */
+	bool ApplyDefaultAffordanceMeshes();
+
+	/** World transform of the mesh instance of an affordance. */
+	FTransform GetAffordanceInstanceTransform(const FUxtBoundingBoxAffordanceInfo& Affordance, const FTransform& ActorTransform) const;
+
+	/**
+	 * Look up the affordance represented by a grabbed component.
+	 * For instanced affordances this is the active affordance of the pointer, or the instance closest to the grab point.
+	 */
+	const FUxtBoundingBoxAffordanceInfo* FindGrabbedAffordance(UUxtGrabTargetComponent* Grabbable, const FUxtGrabPointerData& GrabPointer) const;
+
+	/** Only tick while grabbed or while keeping bounds fitted. */
+	void UpdateComponentTickEnabled();
+
 	/**
 	 * Compute the relative translation and scale between two boxes.
 	 * Returns false if relative scale can not be computed.
@@ -223,6 +292,30 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintGetter = "UseCustomAffordances", Category = "Bounding Box")
 	bool bUseCustomAffordances = false;
 
+	/** How affordances are represented in the world. */
+	UPROPERTY(EditAnywhere, BlueprintGetter = "GetAffordanceMode", BlueprintSetter = "SetAffordanceMode", Category = "Bounding Box")
+	EUxtBoundingBoxAffordanceMode AffordanceMode = EUxtBoundingBoxAffordanceMode::Actors;
+
+	/** Mesh to instance for center affordances. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "AffordanceMode == EUxtBoundingBoxAffordanceMode::Instanced"), Category = "Bounding Box")
+	UStaticMesh* CenterAffordanceMesh;
+
+	/** Mesh to instance for face affordances. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "AffordanceMode == EUxtBoundingBoxAffordanceMode::Instanced"), Category = "Bounding Box")
+	UStaticMesh* FaceAffordanceMesh;
+
+	/** Mesh to instance for edge affordances. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "AffordanceMode == EUxtBoundingBoxAffordanceMode::Instanced"), Category = "Bounding Box")
+	UStaticMesh* EdgeAffordanceMesh;
+
+	/** Mesh to instance for corner affordances. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "AffordanceMode == EUxtBoundingBoxAffordanceMode::Instanced"), Category = "Bounding Box")
+	UStaticMesh* CornerAffordanceMesh;
+
+	/** Scale of affordance mesh instances. The default meshes are engine basic shapes with a size of 100 units. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "AffordanceMode == EUxtBoundingBoxAffordanceMode::Instanced", ClampMin = "0.0"), Category = "Bounding Box")
+	float AffordanceMeshScale = 0.03f;
+
 	/**
 	 * Preset to use for the bounding box.
 	 * When set to Custom the list of affordances must be created by the user.
@@ -241,6 +334,14 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintGetter = "GetInitBoundsFromActor", Category = "Bounding Box")
 	bool bInitBoundsFromActor = true;
 
+	/**
+	 * Keep the bounding box fitted to the actor components while it is not being manipulated.
+	 * Component bounds are cached and only recomputed for components that moved, were added or removed.
+	 * If bounds are not initialized from the actor they are fitted on the first tick.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintGetter = "GetKeepBoundsFitted", BlueprintSetter = "SetKeepBoundsFitted", Category = "Bounding Box")
+	bool bKeepBoundsFitted = false;
+
 	/** Current bounding box in the local space of the actor. */
 	UPROPERTY(Transient, BlueprintGetter = "GetBounds", Category = "Bounding Box")
 	FBox Bounds;
@@ -251,6 +352,30 @@ private:
 	 */
 	TMap<AActor*, const FUxtBoundingBoxAffordanceInfo*> ActorAffordanceMap;
 
+	/**
+	 * Actor holding the affordance mesh instances and a single grab target for all of them.
+	 * It is attached to the bounding box actor, so instances only need updating when the bounds change.
+	 */
+	UPROPERTY(Transient)
+	AActor* InstancedAffordanceActor = nullptr;
+
+	/** Grab target forwarding grab events of all affordance instances. */
+	UPROPERTY(Transient)
+	UUxtGrabTargetComponent* InstancedAffordanceGrabTarget = nullptr;
+
+	/** One instanced mesh component per affordance mesh. */
+	UPROPERTY(Transient)
+	TArray<UInstancedStaticMeshComponent*> AffordanceInstancers;
+
+	/** Affordance represented by a mesh instance. */
+	struct FAffordanceInstance
+	{
+		const FUxtBoundingBoxAffordanceInfo* Affordance;
+		int32 InstancerIndex;
+		int32 InstanceIndex;
+	};
+	TArray<FAffordanceInstance> AffordanceInstances;
+
 	/**
 	 * Contains the currently active affordances being moved by grab pointers.
 	 * 
@@ -260,6 +385,9 @@ private:
 	 */
 	TArray<TPair<const FUxtBoundingBoxAffordanceInfo*, FUxtGrabPointerData>> ActiveAffordanceGrabPointers;
 
+	/** Cached component bounds, used for keeping the bounding box fitted. */
+	TUniquePtr<FUxtBoundsCache> BoundsCache;
+
 	/** Initial bounding box at the start of interaction. */
 	FBox InitialBounds;
 	/** Initial transform at the start of interaction. */
@@ -13,6 +13,11 @@ class APlayerCameraManager;
 
 /**
  * When added to an actor with a far pointer, this component displays a beam from the pointer ray start to the current hit point.
+ *
+ * While the pointer focus is locked the hit point can leave the pointer ray. With Curved enabled the beam then bends from the
+ * pointer direction towards the hit point. The curve is a quadratic Bezier evaluated in the material: custom primitive data 0-2
+ * hold the world space offset D of the control point from the beam midpoint, and the material offsets each vertex
+ * by 2 * X * (1 - X) * D, where X is the vertex position along the unit length beam mesh.
  */
 UCLASS(ClassGroup = UXTools, meta=(BlueprintSpawnableComponent))
 class UXTOOLS_API UUxtFarBeamComponent : public UStaticMeshComponent
@@ -26,14 +31,31 @@ public:
 	//
 	// UActorComponent interface
 
+	virtual void OnRegister() override;
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+	//
+	// USceneComponent interface
+
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+
 	/** Distance over the hit surface to place beam end at. */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Far Beam")
 	float HoverDistance = 0.5f;
 
+	/**
+	 * Bend the beam from the pointer direction towards the hit point while the pointer is locked.
+	 * Requires a beam material that applies the curve offset from custom primitive data, see class description.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Far Beam")
+	bool bCurved = false;
+
+	/** Control point offset of the curved beam in world space. Zero for a straight beam. */
+	UFUNCTION(BlueprintPure, Category = "Far Beam")
+	FVector GetCurveOffset() const { return CurveOffset; }
+
 private:
 
 	UFUNCTION()
@@ -46,4 +68,7 @@ private:
 
 	/** Far pointer in use. */	
 	TWeakObjectPtr<UUxtFarPointerComponent> FarPointerWeak;
+
+	/** Offset of the Bezier control point from the beam midpoint, last written to custom primitive data. */
+	FVector CurveOffset = FVector::ZeroVector;
 };
@@ -22,8 +22,10 @@ namespace Microsoft
 }
 
 class UUxtPressableButtonComponent;
+class UUxtPressableButtonSubsystem;
 class UUxtFarPointerComponent;
 class UBoxComponent;
+class UStaticMesh;
 class UShapeComponent;
 
 //
@@ -39,8 +41,25 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUxtButtonPressedDelegate, UUxtPress
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FUxtButtonReleasedDelegate, UUxtPressableButtonComponent*, Button);
 
 
+/** How the push of a button is applied to its visuals. */
+UENUM(BlueprintType)
+enum class EUxtPushVisualsMode : uint8
+{
+	/** Move the visuals component to the pushed location. */
+	Transform,
+	/**
+	 * Write the push distance to the custom primitive data of the visuals and leave the transform untouched.
+	 * The visuals material must apply the push as world position offset along the button's local X axis.
+	 */
+	CustomPrimitiveData,
+};
+
+
 /**
  * Component that turns the actor it is attached to into a pressable rectangular button.
+ *
+ * Buttons do not tick individually. Push state is stored and updated by the world's UUxtPressableButtonSubsystem,
+ * which only advances buttons while pointers interact with them or while they recover to their rest position.
  */
 UCLASS( ClassGroup = UXTools, meta=(BlueprintSpawnableComponent) )
 class UXTOOLS_API UUxtPressableButtonComponent : public USceneComponent, public IUxtPokeTarget, public IUxtFarTarget
@@ -71,6 +90,32 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Pressable Button")
 	float GetScaleAdjustedMaxPushDistance() const;
 
+	/**
+	 * Time at which the button last crossed the pressed distance, in seconds on the hand sample clock of IUxtHandTracker::GetSampleTime,
+	 * which is the FApp::GetCurrentTime clock. Poke presses are interpolated between hand samples, so this is more precise than the frame time.
+	 * While the button recovers without a pointer its time advances by the frame time from the last hand sample.
+	 * Use it in OnButtonPressed handlers.
+	 */
+	double GetLastPressedTime() const;
+
+	/** Time at which the button was last released, see GetLastPressedTime. Use it in OnButtonReleased handlers. */
+	double GetLastReleasedTime() const;
+
+	/** Blueprint version of GetLastPressedTime, blueprints do not support double. */
+	UFUNCTION(BlueprintPure, Category = "Pressable Button", meta = (DisplayName = "Get Last Pressed Time"))
+	float K2_GetLastPressedTime() const { return static_cast<float>(GetLastPressedTime()); }
+
+	/** Blueprint version of GetLastReleasedTime, blueprints do not support double. */
+	UFUNCTION(BlueprintPure, Category = "Pressable Button", meta = (DisplayName = "Get Last Released Time"))
+	float K2_GetLastReleasedTime() const { return static_cast<float>(GetLastReleasedTime()); }
+
+	/**
+	 * Compute the collider extents and rest position from the visuals and store them with the component.
+	 * This happens in the editor and when the visuals are set, so that BeginPlay does not need to query the visuals mesh.
+	 * Call it after moving the visuals of a button that has not begun play yet.
+	 */
+	void UpdateColliderData();
+
 
 	/** The maximum distance the button can be pushed */
 	UPROPERTY(EditAnywhere, Category = "Pressable Button")
@@ -88,6 +133,14 @@ public:
     UPROPERTY(EditAnywhere, Category = "Pressable Button")
     float RecoverySpeed;
 
+	/** How the push is applied to the visuals. */
+	UPROPERTY(EditAnywhere, Category = "Pressable Button")
+	EUxtPushVisualsMode PushVisualsMode = EUxtPushVisualsMode::Transform;
+
+	/** Custom primitive data index receiving the push distance in world units. */
+	UPROPERTY(EditAnywhere, meta = (EditCondition = "PushVisualsMode == EUxtPushVisualsMode::CustomPrimitiveData", ClampMin = "0"), Category = "Pressable Button")
+	int32 PushCustomDataIndex = 0;
+
 	//
 	// Events
 
@@ -128,8 +181,14 @@ protected:
 	//
 	// UActorComponent interface
 
+	virtual void OnRegister() override;
 	virtual void BeginPlay() override;
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	//
+	// UObject interface
+
+	virtual void PreSave(const class ITargetPlatform* TargetPlatform) override;
 
 	//
 	// IUxtPokeTarget interface
@@ -155,6 +214,8 @@ protected:
 
 private:
 
+	friend class UUxtPressableButtonSubsystem;
+
 	/** Generic handler for enter focus events. */
 	void OnEnterFocus(UObject* Pointer);
 
@@ -167,8 +228,11 @@ private:
 	/** The distance at which the button will fire a released event */
 	float GetReleasedDistance() const;
 
-	/** Use the given mesh to adjust the box component extents. */
-	void ConfigureBoxComponent(const UStaticMeshComponent* Mesh);
+	/** Returns true if the stored collider data was computed for the current visuals mesh and placement. */
+	bool HasValidColliderData(const USceneComponent* Visuals) const;
+
+	/** Apply the stored collider data to the box component. */
+	void ConfigureBoxComponent();
 
 	/** Visual representation of the button face. This component's transform will be updated as the button is pressed/released. */
 	UPROPERTY(EditAnywhere, DisplayName = "Visuals", meta = (UseComponentPicker, AllowedClasses = "StaticMeshComponent"), Category = "Pressable Button")
@@ -181,6 +245,34 @@ private:
 	/** Returns the distance a given pointer is pushing the button to. */
 	float CalculatePushDistance(const UUxtNearPointerComponent* pointer) const;
 
+	/** Returns the distance a pointer at the given location is pushing the button to. */
+	float CalculatePushDistanceAt(const FVector& PointerPos) const;
+
+	/** Signed distance of the pointer location behind the rest position, without clamping. */
+	float GetUnclampedPushDistanceAt(const FVector& PointerPos) const;
+
+	/** Returns the largest push distance of all poking pointers and the pointer pushing the furthest. */
+	float GetTargetPushDistance(UUxtNearPointerComponent*& OutPointer) const;
+
+	/**
+	 * Interpolate between the previous and current hand samples of a poking pointer to find the times at which
+	 * it crossed the pressed or released distance. Pointers may update before or after the button set,
+	 * so crossings are recorded as they happen and used by the next button set update.
+	 */
+	void RecordPokeCrossings(const UUxtNearPointerComponent* Pointer);
+
+	/** Raise the pressed event for a press at the given time. */
+	void BroadcastPressed(double Time);
+
+	/** Raise the released event for a release at the given time. */
+	void BroadcastReleased(double Time);
+
+	/** Move visuals and collider to the current push distance. */
+	void UpdateVisuals();
+
+	/** Move the collider to the given push distance. */
+	void SetColliderPushDistance(float PushDistance);
+
 	/** Get the current pushed position of the button */
 	FVector GetCurrentButtonLocation() const;
 
@@ -197,20 +289,63 @@ private:
 	TWeakObjectPtr<UUxtFarPointerComponent> FarPointerWeak;
 
 	/** Collision volume used for determining poke events */
+	UPROPERTY()
 	UBoxComponent* BoxComponent;
 
-	/** Visuals offset in this component's space */
-	FVector VisualsOffsetLocal;
+	/** True if the collider data below has been computed. */
+	UPROPERTY()
+	bool bHasColliderData = false;
+
+	/** Visuals mesh the collider data was computed for. */
+	UPROPERTY()
+	UStaticMesh* ColliderDataMesh = nullptr;
+
+	/** Transform of the visuals relative to this component when the collider data was computed. */
+	UPROPERTY()
+	FTransform ColliderDataVisualsTransform;
+
+	/** Unscaled extents of the collider */
+	UPROPERTY()
+	FVector ColliderExtent = FVector::ZeroVector;
+
+	/** Collider transform in this component's space */
+	UPROPERTY()
+	FTransform ColliderTransformLocal;
 
 	/** Visuals offset in this component's space */
-	FVector ColliderOffsetLocal;
+	UPROPERTY()
+	FVector VisualsOffsetLocal = FVector::ZeroVector;
 
-	/** True if the button is currently pressed */
-	bool bIsPressed = false;
+	/** Collider offset in this component's space */
+	UPROPERTY()
+	FVector ColliderOffsetLocal = FVector::ZeroVector;
 
-	/** Local position of the button front face while not being poked by any pointer */
-	FVector RestPositionLocal;
+	/** Button set storing the push state of this button. */
+	UPROPERTY(Transient)
+	UUxtPressableButtonSubsystem* ButtonSet = nullptr;
+
+	/** Index of this button in the button set arrays. */
+	int32 ButtonSetIndex = INDEX_NONE;
+
+	/** Time of the last press. */
+	double LastPressedTime = 0;
+
+	/** Time of the last release. */
+	double LastReleasedTime = 0;
+
+	/** Time at which a poking pointer crossed the pressed distance since the last update, negative if it did not. */
+	double PokePressedTime = -1;
 
-	/** The current pushed distance of from poking pointers */
-	float CurrentPushDistance;
+	/** Time at which a poking pointer crossed the released distance since the last update, negative if it did not. */
+	double PokeReleasedTime = -1;
+
+	/** Push distance last written to the visuals custom primitive data. */
+	float VisualsPushDistance = 0;
+
+	/** Push distance the collider was last moved to when using custom primitive data. */
+	float ColliderPushDistance = 0;
+
+	/** Local position of the button front face while not being poked by any pointer */
+	UPROPERTY()
+	FVector RestPositionLocal = FVector::ZeroVector;
 };
@@ -0,0 +1,138 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "UxtPressableButtonSubsystem.generated.h"
+
+class UUxtNearPointerComponent;
+class UUxtPressableButtonComponent;
+class UUxtPressableButtonSubsystem;
+
+/** Tick function updating all awake buttons of a world in one batch. */
+USTRUCT()
+struct FUxtPressableButtonTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UUxtPressableButtonSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FUxtPressableButtonTickFunction> : public TStructOpsTypeTraitsBase2<FUxtPressableButtonTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Stores the push state of all pressable buttons in a world and updates them in one batch.
+ *
+ * State, thresholds and recovery speed of each button are kept in contiguous arrays.
+ * Only awake buttons are updated: buttons that are focused, being poked, pressed by a far pointer
+ * or still recovering to their rest position. Idle buttons cost nothing per frame, which matters
+ * for keyboards and large button grids.
+ *
+ * Buttons register themselves on BeginPlay and wake themselves when a pointer starts interacting.
+ * Events are still raised by the individual button components.
+ */
+UCLASS()
+class UXTOOLS_API UUxtPressableButtonSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	//
+	// USubsystem interface
+
+	virtual void Deinitialize() override;
+
+	/** Add a button to the set. The button starts asleep at its rest position. */
+	void RegisterButton(UUxtPressableButtonComponent* Button);
+
+	/** Remove a button from the set. */
+	void UnregisterButton(UUxtPressableButtonComponent* Button);
+
+	/** Update the button every frame until it comes to rest. Refreshes thresholds from the button settings. */
+	void WakeButton(UUxtPressableButtonComponent* Button);
+
+	/** Current push distance of the button. */
+	float GetPushDistance(const UUxtPressableButtonComponent* Button) const;
+
+	/** Set the push distance of the button, e.g. when pressed by a far pointer. */
+	void SetPushDistance(const UUxtPressableButtonComponent* Button, float PushDistance);
+
+	/** True if the button has been pushed past the pressed distance and not yet released. */
+	bool IsPressed(const UUxtPressableButtonComponent* Button) const;
+
+	/** Set the pressed state without raising events. */
+	void SetPressed(const UUxtPressableButtonComponent* Button, bool bPressed);
+
+	/** Buttons pressed by a far pointer keep their push distance until released. */
+	void SetFarPressed(const UUxtPressableButtonComponent* Button, bool bFarPressed);
+
+	/** Number of registered buttons. */
+	int32 GetNumButtons() const { return Buttons.Num(); }
+
+	/** Number of buttons currently being updated. */
+	int32 GetNumAwakeButtons() const { return AwakeIndices.Num(); }
+
+	/** Advance all awake buttons. */
+	void UpdateButtons(float DeltaTime);
+
+private:
+
+	enum EButtonFlags : uint8
+	{
+		Pressed = 1 << 0,
+		FarPressed = 1 << 1,
+		Awake = 1 << 2,
+	};
+
+	int32 GetIndex(const UUxtPressableButtonComponent* Button) const;
+
+	void UpdateTickEnabled();
+
+	//
+	// Per-button state, all arrays are indexed by the button's set index.
+
+	UPROPERTY(Transient)
+	TArray<UUxtPressableButtonComponent*> Buttons;
+
+	TArray<float> PushDistances;
+	TArray<float> PressedDistances;
+	TArray<float> ReleasedDistances;
+	TArray<float> RecoverySpeeds;
+	TArray<uint8> Flags;
+
+	/** Time of the last update on the hand sample clock, used to time releases while recovering. */
+	TArray<double> UpdateTimes;
+
+	/** Set indices of awake buttons. */
+	TArray<int32> AwakeIndices;
+
+	/** Scratch buffers for target push distances and the pointers causing them, indexed like AwakeIndices. */
+	TArray<float> TargetDistances;
+	TArray<UUxtNearPointerComponent*> TargetPointers;
+
+	/** Button crossing the pressed or released distance during an update. */
+	struct FPendingEvent
+	{
+		TWeakObjectPtr<UUxtPressableButtonComponent> Button;
+		bool bPressed;
+		double Time;
+	};
+	TArray<FPendingEvent> PendingEvents;
+
+	FUxtPressableButtonTickFunction TickFunction;
+};
@@ -11,6 +11,11 @@ class UMaterialInstanceDynamic;
 
 /**
  * Displays a flat ring facing -X. The ring radius can be set directly or via the component scale.
+ *
+ * Ring parameters are passed to the material either through a dynamic material instance or, when Use Custom Primitive Data
+ * is enabled, through custom primitive data. The latter needs no per-cursor material instance, so all cursors share the
+ * same material. The material parameters must then read from the custom primitive data indices below, the default
+ * ring cursor material does not. Scalar parameters are only written when their value changes by more than 0.1%.
  */
 UCLASS( ClassGroup = UXTools, HideCategories = (StaticMesh, Materials), meta=(BlueprintSpawnableComponent) )
 class UXTOOLS_API UUxtRingCursorComponent : public UStaticMeshComponent
@@ -76,10 +81,35 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintGetter = "GetBorderColor", BlueprintSetter = "SetBorderColor", Category = "Ring Cursor")
 	FColor BorderColor = FColor::Black;
 
+public:
+
+	/**
+	 * Pass ring parameters to the material through custom primitive data instead of a dynamic material instance.
+	 * The material parameters must be set to use custom primitive data: InvRadius at index 0, InnerRadius at 1,
+	 * BorderThickness at 2, RingColor at 3-6 and BorderColor at 7-10.
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ring Cursor")
+	bool bUseCustomPrimitiveData = false;
+
 private:
 
 	void SetRadius(float Radius, bool bUpdateScale);
 
+	/** Set the default mesh and material where none have been set. Returns true if anything changed. */
+	bool ApplyDefaultAssets();
+
+	/** Create the material instance if needed and write all parameters. */
+	void InitializeMaterialParameters();
+
+	/** Update material parameters derived from the radius and thicknesses. */
+	void UpdateThicknessParameters();
+
+	/** Write a scalar material parameter if it has changed. */
+	void SetScalarParameter(int32 DataIndex, FName ParameterName, float Value, float& CurrentValue);
+
+	/** Write a color material parameter. */
+	void SetColorParameter(int32 DataIndex, FName ParameterName, FColor Color);
+
 	/** Dynamic instance of the ring material. */
 	UPROPERTY(Transient)
 	UMaterialInstanceDynamic* MaterialInstance;
@@ -89,4 +119,9 @@ private:
 
 	/** Used to ignore transform changes triggered from SetRadius(). */
 	bool bSettingRadius = false;
+
+	/** Material parameter values last written. */
+	float InvRadiusValue = MAX_flt;
+	float InnerRadiusValue = MAX_flt;
+	float BorderThicknessValue = MAX_flt;
 };
@@ -52,7 +52,7 @@ public:
 
 	static FName GetModularFeatureName();
 
-	/** Returns the currently registered hand tracker or nullptr if none */
+	/** Returns the hand tracker of the current scope in test builds, otherwise the currently registered hand tracker or nullptr if none */
 	static IUxtHandTracker* GetHandTracker();
 
 	virtual ~IUxtHandTracker() {}
@@ -68,4 +68,34 @@ public:
 
 	/** Obtain current selection state. Returns false if the hand is not tracked this frame, in which case the value of the output parameter is unchanged. */
 	virtual bool GetIsSelectPressed(EControllerHand Hand, bool& OutIsSelectPressed) const = 0;
-};
\ No newline at end of file
+
+	/**
+	 * Obtain the time at which the current hand sample was captured, in seconds on the same clock as FApp::GetCurrentTime.
+	 * Returns false if the hand is not tracked this frame or the tracker does not provide sample times.
+	 */
+	virtual bool GetSampleTime(EControllerHand Hand, double& OutTime) const { return false; }
+};
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Overrides the registered hand tracker on the current thread while in scope.
+ * Used to give worlds their own hand tracker, e.g. test worlds that are ticked one after another.
+ * Only available in builds with automation tests, so hand tracker lookups in other builds don't pay for it.
+ */
+class UXTOOLS_API FUxtHandTrackerScope
+{
+public:
+
+	explicit FUxtHandTrackerScope(IUxtHandTracker* HandTracker);
+	~FUxtHandTrackerScope();
+
+	FUxtHandTrackerScope(const FUxtHandTrackerScope&) = delete;
+	FUxtHandTrackerScope& operator=(const FUxtHandTrackerScope&) = delete;
+
+private:
+
+	IUxtHandTracker* PreviousHandTracker;
+};
+
+#endif // WITH_DEV_AUTOMATION_TESTS
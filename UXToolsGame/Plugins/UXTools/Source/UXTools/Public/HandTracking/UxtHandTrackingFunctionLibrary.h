@@ -38,4 +38,10 @@ public:
 	/** Returns whether the given hand is tracked. */
 	UFUNCTION(BlueprintCallable, Category = "HandTracking|UXTools")
 	static bool IsHandTracked(EControllerHand Hand);
+
+	/**
+	 * Time at which the current hand sample was captured, in seconds on the FApp::GetCurrentTime clock.
+	 * Falls back to the frame start time if the hand tracker does not provide sample times.
+	 */
+	static double GetHandSampleTime(EControllerHand Hand);
 };
@@ -9,7 +9,7 @@
 
 class UUxtNearPointerComponent;
 class UUxtFarPointerComponent;
-class UMaterialParameterCollection;
+class UUxtPointerDataSubsystem;
 
 
 /**
@@ -32,6 +32,7 @@ public:
 	// UActorComponent interface
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
 
 	UFUNCTION(BlueprintGetter)
@@ -103,9 +104,13 @@ private:
 	UPROPERTY(Transient)
 	UUxtFarPointerComponent* FarPointer;
 
+	/** Publishes the finger tip to materials. */
 	UPROPERTY(Transient)
-	UMaterialParameterCollection* ParameterCollection;
-	
+	UUxtPointerDataSubsystem* PointerData;
+
+	/** Slot of this hand in the pointer data buffer. */
+	int32 PointerDataSlot = INDEX_NONE;
+
 	bool bHadTracking = false;
 	FVector PrevQueryPosition;
 };
@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//
+// State machines of near pointer focus, grab and poke interactions.
+//
+// They work on plain target IDs and report transitions to listeners, geometry is queried through callbacks.
+// The near pointer component adapts them to UObject targets and scene queries, while tests can drive them
+// directly with simulated geometry.
+//
+
+/** Identifier of a target or primitive, 0 means none. The near pointer uses object addresses. */
+typedef uint64 FUxtTargetId;
+
+/** Receives focus and grab transitions, in the order in which they happen. */
+class UXTOOLS_API IUxtFocusListener
+{
+public:
+
+	virtual ~IUxtFocusListener() {}
+
+	/** The target has been focused, called after the focus state has changed. */
+	virtual void OnEnterFocus(FUxtTargetId Target) = 0;
+
+	/** The target has lost focus, called before the focus state changes. */
+	virtual void OnExitFocus(FUxtTargetId Target) = 0;
+
+	/** The focused target or primitive has changed, called between exit and enter. */
+	virtual void OnFocusChanged(FUxtTargetId NewTarget, FUxtTargetId NewPrimitive) {}
+
+	/** Grab started on the focused target, called before the grab state changes. */
+	virtual void OnBeginGrab(FUxtTargetId Target) {}
+
+	/** Grab ended on the focused target, called after the grab state has changed. */
+	virtual void OnEndGrab(FUxtTargetId Target) {}
+};
+
+/** Focus of a pointer on a target and one of its primitives, and the grab state for grab pointers. */
+class UXTOOLS_API FUxtFocusCore
+{
+public:
+
+	FUxtTargetId GetTarget() const { return Target; }
+	FUxtTargetId GetPrimitive() const { return Primitive; }
+	const FVector& GetClosestPoint() const { return ClosestPoint; }
+	bool IsGrabbing() const { return bIsGrabbing; }
+
+	/** Focus the target and primitive. Only the closest point is updated if neither has changed. */
+	void SetFocus(FUxtTargetId NewTarget, FUxtTargetId NewPrimitive, const FVector& NewClosestPoint, IUxtFocusListener& Listener);
+
+	/** Update the closest point on the focused target without changing focus. */
+	void SetClosestPoint(const FVector& NewClosestPoint) { ClosestPoint = NewClosestPoint; }
+
+	/** Remove focus from the target. */
+	void ClearFocus(IUxtFocusListener& Listener);
+
+	/** Drop the target without events, e.g. when it has been destroyed. */
+	void ForgetTarget() { Target = 0; }
+
+	/** Drop the primitive without events, e.g. when it has been destroyed. */
+	void ForgetPrimitive() { Primitive = 0; }
+
+	/** Start grabbing, the focused target receives the grab. */
+	void BeginGrab(IUxtFocusListener& Listener);
+
+	/** Stop grabbing. */
+	void EndGrab(IUxtFocusListener& Listener);
+
+private:
+
+	FUxtTargetId Target = 0;
+	FUxtTargetId Primitive = 0;
+	FVector ClosestPoint = FVector::ZeroVector;
+	bool bIsGrabbing = false;
+};
+
+/** Scene queries used by the poke state machine. */
+class UXTOOLS_API IUxtPokeGeometry
+{
+public:
+
+	virtual ~IUxtPokeGeometry() {}
+
+	/** Returns true if the target is poked through the front face of its box, false if it is poked anywhere in its volume. */
+	virtual bool IsFrontFacePokable(FUxtTargetId Target) const = 0;
+
+	/** Returns true if the sphere is behind the front face of the primitive's box. */
+	virtual bool IsBehindFrontFace(FUxtTargetId Primitive, const FVector& Location, float Radius) const = 0;
+
+	/** Returns true if the sphere has left the front face poke region of the primitive's box. */
+	virtual bool IsFrontFacePokeEnded(FUxtTargetId Primitive, const FVector& Location, float Radius, float Depth) const = 0;
+
+	/** Returns true if the sphere overlaps the primitive. */
+	virtual bool IsOverlapping(FUxtTargetId Primitive, const FVector& Location, float Radius) const = 0;
+
+	/** Returns the first primitive hit by a sphere moving from start to end, 0 if none. */
+	virtual FUxtTargetId Sweep(const FVector& Start, const FVector& End, float Radius) const = 0;
+};
+
+/** Receives poke transitions. */
+class UXTOOLS_API IUxtPokeListener
+{
+public:
+
+	virtual ~IUxtPokeListener() {}
+
+	virtual void OnBeginPoke(FUxtTargetId Target) = 0;
+	virtual void OnUpdatePoke(FUxtTargetId Target) = 0;
+	virtual void OnEndPoke(FUxtTargetId Target) = 0;
+
+	/** Poking ended because the target or its primitive is gone, no end event is raised on the target. */
+	virtual void OnPokeTargetLost(FUxtTargetId Target) = 0;
+};
+
+/** Poke state of a pointer against its focused poke target. */
+class UXTOOLS_API FUxtPokeCore
+{
+public:
+
+	struct FInput
+	{
+		/** Focused poke target and primitive. */
+		FUxtTargetId Target = 0;
+		FUxtTargetId Primitive = 0;
+
+		/** Poke sphere. */
+		FVector Location = FVector::ZeroVector;
+		float Radius = 0.0f;
+
+		/** Depth beyond the front face at which front face pokes end. */
+		float Depth = 0.0f;
+	};
+
+	bool IsPoking() const { return bIsPoking; }
+
+	/** Begin, update or end poking for the new pointer location. */
+	void Update(const FInput& Input, const IUxtPokeGeometry& Geometry, IUxtPokeListener& Listener);
+
+private:
+
+	bool bIsPoking = false;
+	bool bWasBehindFrontFace = false;
+	FVector PreviousLocation = FVector::ZeroVector;
+};
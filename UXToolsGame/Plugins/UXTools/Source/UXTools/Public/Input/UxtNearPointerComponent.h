@@ -6,6 +6,7 @@
 #include "CoreMinimal.h"
 #include "InputCoreTypes.h"
 #include "Components/ActorComponent.h"
+#include "Input/UxtNearInteractionCore.h"
 #include "UxtNearPointerComponent.generated.h"
 
 struct FUxtGrabPointerFocus;
@@ -78,6 +79,15 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Hand Pointer")
 	float GetPokePointerRadius() const;
 
+	/** Time at which the hand sample of the current poke pointer transform was captured. */
+	double GetPokePointerSampleTime() const;
+
+	/** Poke pointer location of the previous hand sample, used to interpolate between samples. */
+	FVector GetPreviousPokePointerSampleLocation() const;
+
+	/** Time at which the previous hand sample was captured, zero if there is none. */
+	double GetPreviousPokePointerSampleTime() const;
+
 	/** The hand that this component represents.
 	 *  Determines the position of touch and grab pointers.
 	 */
@@ -123,9 +133,12 @@ private:
 
 	FTransform PokePointerTransform;
 
-	bool bIsPoking = false;
+	double PokePointerSampleTime = 0;
+
+	FVector PreviousPokePointerSampleLocation = FVector::ZeroVector;
 
-	FVector PreviousPokePointerLocation;
+	double PreviousPokePointerSampleTime = 0;
 
-	bool bWasBehindFrontFace = false;
+	/** Poke state against the focused poke target. */
+	FUxtPokeCore PokeCore;
 };
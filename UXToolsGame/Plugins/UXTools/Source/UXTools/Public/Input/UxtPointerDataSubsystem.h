@@ -0,0 +1,145 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "InputCoreTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+
+#include "UxtPointerDataSubsystem.generated.h"
+
+class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+class UTexture2D;
+class UUxtPointerDataSubsystem;
+
+/** State flags of a pointer in the pointer data buffer. */
+enum class EUxtPointerDataFlags : uint8
+{
+	None = 0,
+	/** The pointer is tracked this frame. */
+	Tracked = 1 << 0,
+	/** The pointer is in near interaction mode. */
+	Near = 1 << 1,
+	/** The pointer is in far interaction mode. */
+	Far = 1 << 2,
+};
+ENUM_CLASS_FLAGS(EUxtPointerDataFlags);
+
+/** Tick function publishing the pointer data buffer once all pointers have updated. */
+USTRUCT()
+struct FUxtPointerDataTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	UUxtPointerDataSubsystem* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FUxtPointerDataTickFunction> : public TStructOpsTypeTraitsBase2<FUxtPointerDataTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
+/**
+ * Collects position, radius and state of all pointers in a world and publishes them to materials once per frame.
+ *
+ * Pointer data is written to a float texture of MaxPointers x 2 texels, one column per pointer:
+ * - Row 0: world position in RGB, radius in A. Unused slots have a radius of zero.
+ * - Row 1: EUxtPointerDataFlags in R, hand in G (0 left, 1 right, 2 other).
+ * Materials sample it with nearest filtering, e.g. for proximity highlights from any number of pointers.
+ * The texture is only uploaded when the data has changed.
+ * Material instances passed to BindMaterial get it as the PointerData texture parameter, the ring cursor binds its material instance.
+ *
+ * For existing materials the first left and right tracked pointers are also written to the
+ * LeftPointerPosition and RightPointerPosition parameters of the PointerPositions parameter collection.
+ */
+UCLASS()
+class UXTOOLS_API UUxtPointerDataSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/** Number of pointer slots in the buffer. */
+	static const int32 MaxPointers = 16;
+
+	//
+	// USubsystem interface
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Reserve a slot in the buffer. Returns INDEX_NONE if all slots are in use. */
+	int32 AddPointer();
+
+	/** Release a slot. */
+	void RemovePointer(int32 Slot);
+
+	/** Set the data of a pointer for this frame. */
+	void UpdatePointer(int32 Slot, EControllerHand Hand, const FVector& Position, float Radius, EUxtPointerDataFlags Flags);
+
+	/** Change the state of a pointer and keep its last position, e.g. when tracking is lost. */
+	void SetPointerFlags(int32 Slot, EUxtPointerDataFlags Flags);
+
+	/** Texture holding the data of all pointers, see class description for the layout. */
+	UFUNCTION(BlueprintPure, Category = "UXTools|Pointer Data")
+	UTexture2D* GetPointerDataTexture() const { return Texture; }
+
+	/**
+	 * Set the pointer data texture as the PointerData texture parameter of a material instance.
+	 * The parameter is set again if the texture is created later, materials without the parameter are not affected.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "UXTools|Pointer Data")
+	void BindMaterial(UMaterialInstanceDynamic* Material);
+
+	/** Name of the texture parameter set by BindMaterial. */
+	static const FName PointerDataParameter;
+
+	/** Write the data of all pointers to the texture and the parameter collection. */
+	void PublishPointerData();
+
+private:
+
+	struct FPointerSlot
+	{
+		FVector Position = FVector::ZeroVector;
+		float Radius = 0;
+		EUxtPointerDataFlags Flags = EUxtPointerDataFlags::None;
+		EControllerHand Hand = EControllerHand::AnyHand;
+		bool bInUse = false;
+	};
+
+	/** Write the first tracked left and right pointers to the legacy parameter collection. */
+	void PublishParameterCollection();
+
+	void UpdateTickEnabled();
+
+	TArray<FPointerSlot> Slots;
+
+	/** Texel data last uploaded to the texture. */
+	TArray<FLinearColor> TexelData;
+
+	/** Material instances that get the texture once it is created. */
+	TArray<TWeakObjectPtr<UMaterialInstanceDynamic>> BoundMaterials;
+
+	UPROPERTY(Transient)
+	UTexture2D* Texture = nullptr;
+
+	UPROPERTY(Transient)
+	UMaterialParameterCollection* ParameterCollection = nullptr;
+
+	/** Positions last written to the parameter collection. */
+	FVector LeftPointerPosition = FVector::ZeroVector;
+	FVector RightPointerPosition = FVector::ZeroVector;
+
+	FUxtPointerDataTickFunction TickFunction;
+};
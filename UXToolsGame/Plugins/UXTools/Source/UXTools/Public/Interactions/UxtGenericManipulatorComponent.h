@@ -78,7 +78,15 @@ public:
 
 protected:
 
+	/**
+	 * Compute the target transform using the pipeline specialized for the current settings and number of grab pointers.
+	 * Returns false if the actor should not be moved.
+	 */
+	bool ComputeTargetTransform(float DeltaSeconds, FTransform& OutTargetTransform);
+
+	/** Move the actor with the one-handed pipeline for the current settings. */
 	void UpdateOneHandManipulation(float DeltaSeconds);
+	/** Move the actor with the two-handed pipeline for the current settings. */
 	void UpdateTwoHandManipulation(float DeltaSeconds);
 
 	bool GetOneHandRotation(const FTransform& InSourceTransform, FTransform& OutTargetTransform) const;
@@ -88,6 +96,32 @@ protected:
 	/** Compute orientation that invariant in camera space. */
 	FQuat GetViewInvariantRotation() const;
 
+	virtual void BeginPlay() override;
+
+private:
+
+	/** Throw the actor with the released pointer's velocity if enabled. */
+	UFUNCTION()
+	void OnManipulationReleased(UUxtGrabTargetComponent* Grabbable, FUxtGrabPointerData GrabPointer);
+
+	/** Manipulation update specialized for one combination of settings, modifies the transform in place. */
+	typedef void (UUxtGenericManipulatorComponent::*FManipulationPipeline)(float DeltaSeconds, FTransform& InOutTransform) const;
+
+	template <EUxtOneHandRotationMode RotationMode>
+	void RunOneHandPipeline(float DeltaSeconds, FTransform& InOutTransform) const;
+
+	template <bool bScale, bool bRotate, bool bTranslate>
+	void RunTwoHandPipeline(float DeltaSeconds, FTransform& InOutTransform) const;
+
+	/** Pipeline for the given number of grab pointers, selected again if the settings have changed. Null if not supported. */
+	FManipulationPipeline GetPipeline(int32 NumPointers);
+
+	/** Packs all settings that affect pipeline selection, used for detecting changes. */
+	uint32 GetPipelineSettingsKey() const;
+
+	/** Select the specialized pipelines matching the current settings. */
+	void UpdatePipelines();
+
 public:
 
 	/** Enabled manipulation modes. */
@@ -102,6 +136,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = GenericManipulator, meta = (Bitmask, BitmaskEnum = EUxtTwoHandTransformMode))
 	uint8 TwoHandTransformModes;
 
+	/**
+	 * If true the actor keeps moving with the estimated velocity of the grab point when the last pointer releases it.
+	 * Requires the actor root component to simulate physics.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = GenericManipulator)
+	bool bThrowOnRelease = false;
+
 private:
 
 	/** Motion smoothing factor to apply while manipulating the object.
@@ -113,4 +154,13 @@ private:
 	 */
 	UPROPERTY(EditAnywhere, BlueprintGetter = GetSmoothing, BlueprintSetter = SetSmoothing, Category = GenericManipulator, meta = (ClampMin = "0.0"))
 	float Smoothing;
+
+	/** Pipeline used while grabbed with one hand, null if one-handed manipulation is disabled. */
+	FManipulationPipeline OneHandPipeline = nullptr;
+
+	/** Pipeline used while grabbed with two hands, null if two-handed manipulation is disabled. */
+	FManipulationPipeline TwoHandPipeline = nullptr;
+
+	/** Settings the current pipelines were selected for. */
+	uint32 PipelineSettingsKey = MAX_uint32;
 };
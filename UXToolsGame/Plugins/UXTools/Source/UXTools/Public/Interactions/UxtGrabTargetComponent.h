@@ -8,6 +8,7 @@
 #include "Components/SceneComponent.h"
 #include "Interactions/UxtGrabTarget.h"
 #include "Interactions/UxtFarTarget.h"
+#include "Interactions/UxtPointerKinematics.h"
 
 #include "UxtGrabTargetComponent.generated.h"
 
@@ -162,6 +163,17 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Grabbable")
 	const TArray<FUxtGrabPointerData>& GetGrabPointers() const;
 
+	/**
+	 * Estimate the world space velocity of a grabbing pointer's grab point.
+	 * Angular velocity is a rotation axis scaled by radians per second.
+	 * Success is false if the pointer is not grabbing or there is not enough history yet.
+	 */
+	UFUNCTION(BlueprintPure, Category = "Grabbable")
+	void GetGrabPointerVelocity(UUxtNearPointerComponent* NearPointer, UUxtFarPointerComponent* FarPointer, bool &Success, FVector &LinearVelocity, FVector &AngularVelocity) const;
+
+	/** Returns the grab point history of the pointer at the given index in the grab pointers list. */
+	const FUxtPointerKinematics& GetGrabPointerKinematics(int Index) const;
+
 protected:
 
 	virtual void BeginPlay() override;
@@ -194,6 +206,12 @@ private:
 
 	void InitGrabTransform(FUxtGrabPointerData& GrabData) const;
 
+	/** Add a new grab pointer and start recording its history. */
+	void AddGrabPointer(const FUxtGrabPointerData& GrabData);
+
+	/** Record the current grab point of the pointer at the given index. */
+	void RecordGrabPointerSample(int Index);
+
 public:
 
 	/** Event raised when grab starts. */
@@ -208,12 +226,22 @@ public:
 	UPROPERTY(BlueprintAssignable)
 	FUxtEndGrabDelegate OnEndGrab;
 
+	/**
+	 * Time window in seconds over which grab pointer velocities are estimated.
+	 * Longer windows are less sensitive to tracking noise but respond slower to changes in motion.
+	 */
+	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintReadWrite, Category = "Grabbable", meta = (ClampMin = "0.0"))
+	float VelocityWindow = 0.1f;
+
 private:
 
 	/** List of currently grabbing pointers. */
 	UPROPERTY(BlueprintGetter = "GetGrabPointers", Category = "Grabbable")
 	TArray<FUxtGrabPointerData> GrabPointers;
 
+	/** Grab point history of each grabbing pointer, in the same order as GrabPointers. */
+	TArray<FUxtPointerKinematics> GrabPointerKinematics;
+
 	/** If true the component tick is only enabled while the actor is being grabbed. */
 	UPROPERTY(EditAnywhere, AdvancedDisplay, BlueprintGetter = "GetTickOnlyWhileGrabbed", BlueprintSetter = "SetTickOnlyWhileGrabbed", Category = "Grabbable")
 	uint8 bTickOnlyWhileGrabbed : 1;
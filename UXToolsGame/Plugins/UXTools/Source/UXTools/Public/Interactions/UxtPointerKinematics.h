@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Fixed-size history of timestamped pointer poses.
+ *
+ * Samples are stored in a ring buffer, so recording a sample never allocates.
+ * Velocities are estimated by a least-squares line fit over the samples inside a time window,
+ * which is far less sensitive to tracking jitter than differencing the last two samples.
+ *
+ * Usage:
+ * Call Reset when a pointer starts interacting, then AddSample every time the pointer pose is updated.
+ * Query GetLinearVelocity/GetAngularVelocity at any time, e.g. when the pointer is released.
+ */
+class UXTOOLS_API FUxtPointerKinematics
+{
+public:
+
+	/** Maximum number of samples kept in the history. */
+	static constexpr int32 Capacity = 16;
+
+	/** Remove all samples. */
+	void Reset();
+
+	/** Record a new pointer pose. Samples with a timestamp older than the latest sample are ignored. */
+	void AddSample(float Time, const FTransform& Transform);
+
+	/** Number of samples currently stored. */
+	int32 Num() const { return NumSamples; }
+
+	/** Time of the most recent sample, or zero if there are no samples. */
+	float GetLatestTime() const;
+
+	/** Pose of the most recent sample, or identity if there are no samples. */
+	FTransform GetLatestTransform() const;
+
+	/**
+	 * Estimate the linear velocity from samples no older than Window seconds before the latest sample.
+	 * Returns false and a zero velocity if there are not enough samples in the window.
+	 */
+	bool GetLinearVelocity(float Window, FVector& OutVelocity) const;
+
+	/**
+	 * Estimate the angular velocity, as a world space rotation axis scaled by radians per second,
+	 * from samples no older than Window seconds before the latest sample.
+	 * Returns false and a zero velocity if there are not enough samples in the window.
+	 */
+	bool GetAngularVelocity(float Window, FVector& OutVelocity) const;
+
+private:
+
+	struct FSample
+	{
+		float Time;
+		FVector Location;
+		FQuat Rotation;
+	};
+
+	/** Returns the i-th most recent sample, 0 being the latest. */
+	const FSample& GetSample(int32 Age) const;
+
+	/** Number of most recent samples that lie within the time window. */
+	int32 GetNumSamplesInWindow(float Window) const;
+
+	FSample Samples[Capacity];
+
+	/** Index of the next sample to be written. */
+	int32 Head = 0;
+
+	int32 NumSamples = 0;
+};
@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPtr.h"
+
+class UMaterialInterface;
+class UMaterialParameterCollection;
+class UStaticMesh;
+struct FStreamableHandle;
+
+/**
+ * Default assets of UX Tools components, loaded asynchronously instead of in component constructors.
+ *
+ * Loading starts once the engine has initialized, or on first use. Components that need the assets register a callback
+ * with CallWhenLoaded and apply them once they are available. Assets that can not be found are reported in the log
+ * and left null, components then keep whatever mesh or material they have been given.
+ *
+ * The streamable handle keeps the assets loaded until Reset. The assets are only referenced through soft paths,
+ * the UXToolsEditor module adds them to the cook so projects do not have to.
+ */
+class UXTOOLS_API FUxtDefaultAssets
+{
+public:
+
+	static FUxtDefaultAssets& Get();
+
+	/** Start loading the default assets, unless they are already loaded or loading. */
+	void Preload();
+
+	/** True once loading has completed, also if some assets could not be found. */
+	bool IsLoaded() const;
+
+	/**
+	 * Call the function once the default assets are loaded, immediately if they are loaded already.
+	 * The function is dropped if the owner has been destroyed by then.
+	 */
+	void CallWhenLoaded(const UObject* Owner, TFunction<void()> Callback);
+
+	/** Block until the default assets are loaded, e.g. in tests. Returns at once if there is no asset manager yet. */
+	void WaitUntilLoaded();
+
+	/** Time from the start of the last load until it completed, 0 if no load has completed. */
+	double GetLoadTimeMs() const;
+
+	/** Release the assets, e.g. to measure loading in tests. Pending callbacks are kept and run after the next load. */
+	void Reset();
+
+	UStaticMesh* GetRingCursorMesh() const;
+	UMaterialInterface* GetRingCursorMaterial() const;
+	UStaticMesh* GetBeamMesh() const;
+	UMaterialInterface* GetBeamMaterial() const;
+	UMaterialParameterCollection* GetPointerPositions() const;
+	UStaticMesh* GetAffordanceCubeMesh() const;
+	UStaticMesh* GetAffordanceSphereMesh() const;
+
+	/** Paths of all default assets, e.g. to add them to the cook. */
+	TArray<FSoftObjectPath> GetAssetPaths() const;
+
+private:
+
+	FUxtDefaultAssets();
+
+	void OnLoadCompleted();
+
+	TSoftObjectPtr<UStaticMesh> RingCursorMesh;
+	TSoftObjectPtr<UMaterialInterface> RingCursorMaterial;
+	TSoftObjectPtr<UStaticMesh> BeamMesh;
+	TSoftObjectPtr<UMaterialInterface> BeamMaterial;
+	TSoftObjectPtr<UMaterialParameterCollection> PointerPositions;
+	TSoftObjectPtr<UStaticMesh> AffordanceCubeMesh;
+	TSoftObjectPtr<UStaticMesh> AffordanceSphereMesh;
+
+	/** Keeps the assets loaded. */
+	TSharedPtr<FStreamableHandle> Handle;
+
+	struct FPendingCallback
+	{
+		FWeakObjectPtr Owner;
+		TFunction<void()> Callback;
+	};
+	TArray<FPendingCallback> PendingCallbacks;
+
+	bool bLoadCompleted = false;
+
+	uint64 LoadStartCycles = 0;
+	uint64 LoadCycles = 0;
+};
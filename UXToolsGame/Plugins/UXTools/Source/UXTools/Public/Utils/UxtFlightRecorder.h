@@ -0,0 +1,143 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Atomic.h"
+
+/** Type of an interaction event in the flight recorder. */
+enum class EUxtFlightEventType : uint8
+{
+	PointerSample,
+	FocusEnter,
+	FocusExit,
+	GrabBegin,
+	GrabEnd,
+	PokeBegin,
+	PokeEnd,
+	FarPressed,
+	FarReleased,
+	ButtonPressed,
+	ButtonReleased,
+
+	Count
+};
+
+/** Interaction an event belongs to. */
+enum class EUxtFlightInteraction : uint8
+{
+	None,
+	Grab,
+	Poke,
+	Far
+};
+
+/** A single recorded event, kept small so recording is a handful of stores. */
+struct FUxtFlightEvent
+{
+	/** FPlatformTime::Cycles64() when the event was recorded. */
+	uint64 Cycles = 0;
+
+	/** Engine frame counter when the event was recorded. */
+	uint32 Frame = 0;
+
+	/** Unique ID of the pointer object, 0 if there is none. */
+	uint32 PointerId = 0;
+
+	/** Unique ID of the target object, 0 if there is none. */
+	uint32 TargetId = 0;
+
+	EUxtFlightEventType Type = EUxtFlightEventType::PointerSample;
+	EUxtFlightInteraction Interaction = EUxtFlightInteraction::None;
+
+	/** Pointer location for pointer samples, otherwise the location the event refers to if any. */
+	FVector Location = FVector::ZeroVector;
+
+	friend FArchive& operator<<(FArchive& Ar, FUxtFlightEvent& Event);
+};
+
+/** Contents of a flight recorder dump file. */
+struct UXTOOLS_API FUxtFlightDump
+{
+	/** Conversion from event cycles to seconds. */
+	double SecondsPerCycle = 0;
+
+	/** Total number of events recorded, including events overwritten before the dump. */
+	uint64 NumRecorded = 0;
+
+	/** Events in the order they were recorded. */
+	TArray<FUxtFlightEvent> Events;
+
+	/** Names of pointers and targets that still existed when the dump was written. */
+	TMap<uint32, FString> Names;
+
+	bool Save(const FString& Filename) const;
+	bool Load(const FString& Filename);
+
+	/** Name of an object ID in the dump, or the ID if the name is unknown. */
+	FString GetName(uint32 Id) const;
+};
+
+/**
+ * Always-on recorder for pointer and interaction events, used to investigate interaction issues after the fact.
+ * Events are written to a fixed-size ring buffer without locks, so the latest events are always available.
+ *
+ * The buffer is written to Saved/UXTools/FlightRecorder with the UXTools.FlightRecorder.Dump console command
+ * and when the application crashes. Dumps can be analyzed with the UxtFlightAnalyzer commandlet.
+ */
+class UXTOOLS_API FUxtFlightRecorder
+{
+public:
+
+	/** Recorder used by UX Tools components, its capacity can be set with -UxtFlightRecorderCapacity=<Events>. */
+	static FUxtFlightRecorder& Get();
+
+	/** Create a separate recorder, e.g. for tests. The capacity is rounded up to a power of two. */
+	explicit FUxtFlightRecorder(uint32 InCapacity);
+
+	/** Number of events kept in the buffer. */
+	uint64 GetCapacity() const { return Capacity; }
+
+	/** Record an event if recording is enabled, safe to call from any thread. */
+	void Record(EUxtFlightEventType Type, EUxtFlightInteraction Interaction, const UObject* Pointer, const UObject* Target, const FVector& Location = FVector::ZeroVector);
+
+	/** Copy the events currently in the buffer. Object names are only resolved if requested, this must be done on the game thread. */
+	void Snapshot(FUxtFlightDump& OutDump, bool bResolveNames) const;
+
+	/** Write the buffer to a file, a default name in the flight recorder directory is used if the filename is empty. Returns the filename. */
+	FString Dump(const FString& Filename = FString(), bool bResolveNames = true) const;
+
+	/**
+	 * Write the buffer to a file in the dump format without allocating memory, e.g. in a crash handler.
+	 * Events are serialized into the given buffer, which must hold GetRawDumpSize() bytes, and written with the platform file API.
+	 */
+	bool DumpRaw(const TCHAR* Filename, uint8* Buffer, uint64 BufferSize) const;
+
+	/** Size of the buffer needed by DumpRaw. */
+	uint64 GetRawDumpSize() const;
+
+	/** Dump the buffer when the application crashes. */
+	static void RegisterCrashHandler();
+	static void UnregisterCrashHandler();
+
+private:
+
+	/** Sequence of a slot while a writer owns it. */
+	static constexpr uint64 WritingSequence = MAX_uint64;
+
+	struct FSlot
+	{
+		/** Index of the event in the slot plus one, 0 if the slot is empty and WritingSequence while it is being written. */
+		TAtomic<uint64> Sequence { 0 };
+		FUxtFlightEvent Event;
+	};
+
+	/** Power of two number of slots, so indices wrap with a mask. */
+	TUniquePtr<FSlot[]> Slots;
+	uint64 Capacity = 0;
+	TAtomic<uint64> WriteIndex { 0 };
+
+	static FDelegateHandle SystemErrorHandle;
+};
+
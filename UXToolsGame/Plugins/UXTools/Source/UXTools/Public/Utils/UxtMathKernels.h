@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EUxtBoundingBoxAffordanceAction : uint8;
+
+/**
+ * Math used by interaction components every frame.
+ * The functions only depend on their inputs, so they can be tested and benchmarked without a world.
+ */
+class UXTOOLS_API FUxtMathKernels
+{
+public:
+
+	//
+	// Follow
+
+	/** Signed angle in radians between two vectors, after projecting them onto the plane with the given normal. */
+	static float AngleBetweenOnPlane(FVector From, FVector To, FVector Normal);
+
+	/** Clamps the direction from the reference to the current position to the horizontal and vertical view angles.
+	 *  Returns true if the direction was clamped.
+	 */
+	static bool AngularClamp(
+		FVector RefPosition,
+		FQuat RefRotation,
+		FVector CurrentPosition,
+		bool bIgnoreVertical,
+		float MaxHorizontalDegrees,
+		float MaxVerticalDegrees,
+		FVector& RefForward);
+
+	/** Clamps the distance of the current position from the reference along the reference forward direction.
+	 *  Returns true if the position was moved.
+	 */
+	static bool DistanceClamp(
+		float DeltaTime,
+		float MinDistance,
+		float DefaultDistanceIn,
+		float MaxDistance,
+		bool bMaintainPitch,
+		FVector CurrentPosition,
+		FVector RefPosition,
+		FVector RefForward,
+		bool bInterpolateToDefaultDistance,
+		float MoveToDefaultDistanceLerpTime,
+		FVector& ClampedPosition);
+
+	//
+	// Manipulation
+
+	/** Distance of the pointer centroid from the body, which is treated as a vertical ray down from the head. */
+	static float GetDistanceToBody(const FVector& PointerCentroidPosition, const FVector& HeadPosition);
+
+	/** Object position for a grab point that is fixed relative to the pointer, scaled by the ratio of current to initial body distance. */
+	static FVector ManipulationMove(const FTransform& PointerCentroidPose, const FQuat& ObjectRotation, const FVector& ObjectScale, bool UsePointerRotation,
+		float DistanceRatio, const FVector& PointerLocalGrabPoint, const FVector& ObjectLocalGrabPoint, const FVector& GrabToObject);
+
+	/** Object rotation for two hands, rotating the start rotation by the change of the handle bar between the hands. */
+	static FQuat TwoHandRotate(const FVector& StartHandleBar, const FVector& HandleBar, const FQuat& StartRotation);
+
+	/** Smallest distance between any two of the points, used for two hand scaling. */
+	static float GetMinDistanceBetweenPoints(TArrayView<const FVector> Points);
+
+	//
+	// Bounding box
+
+	/** Bounds in the initial actor space and rotation change when moving an affordance from the local grab point to the target location. */
+	static void ComputeModifiedBounds(EUxtBoundingBoxAffordanceAction Action, const FVector& AffordanceLocation, const FMatrix& ConstraintMatrix,
+		const FTransform& InitialTransform, const FBox& InitialBounds, const FVector& LocalGrabPoint, const FVector& TargetLocation, FBox& OutBounds, FQuat& OutDeltaRotation);
+
+	//
+	// Poke
+
+	/** True if the pointer sphere touches or is behind the front face (-X) of a box collider. */
+	static bool IsBehindFrontFace(const FTransform& ColliderTransform, const FVector& Extents, const FVector& PointerPosition, float Radius);
+
+	/** True if the pointer sphere has left the poke volume of a box collider, which extends from the front face to the given depth. */
+	static bool IsFrontFacePokeEnded(const FTransform& ColliderTransform, const FVector& Extents, const FVector& PointerPosition, float Radius, float Depth);
+};
@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+#include "Templates/Atomic.h"
+#include "Trace/Trace.h"
+
+//
+// Profiling instrumentation for UX Tools.
+//
+// Each timer is reported to three profilers:
+// - Stats: "stat UXTools" in the console.
+// - CSV profiler: "UXTools" category, e.g. "csvprofile start".
+// - Unreal Insights: CPU events on the "UXTools" trace channel, e.g. -trace=cpu,uxtools on the command line.
+//
+// Counters are reset every frame.
+//
+
+DECLARE_STATS_GROUP(TEXT("UXTools"), STATGROUP_UXTools, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Near Pointer Tick"), STAT_UxtNearPointerTick, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Near Pointer Query"), STAT_UxtNearPointerQuery, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Far Pointer Tick"), STAT_UxtFarPointerTick, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Far Pointer Query"), STAT_UxtFarPointerQuery, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hand Proximity Query"), STAT_UxtHandProximityQuery, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Focus Resolution"), STAT_UxtFocusResolution, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Event Dispatch"), STAT_UxtEventDispatch, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Manipulation Solve"), STAT_UxtManipulationSolve, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bounding Box Update"), STAT_UxtBoundingBoxUpdate, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Follow Solve"), STAT_UxtFollowSolve, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Button Update"), STAT_UxtButtonUpdate, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Cursor Update"), STAT_UxtCursorUpdate, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Button Begin Play"), STAT_UxtButtonBeginPlay, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Bounding Box Begin Play"), STAT_UxtBoundingBoxBeginPlay, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Hand Interaction Begin Play"), STAT_UxtHandInteractionBeginPlay, STATGROUP_UXTools, UXTOOLS_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Scene Queries"), STAT_UxtSceneQueries, STATGROUP_UXTools, UXTOOLS_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Targets Evaluated"), STAT_UxtTargetsEvaluated, STATGROUP_UXTools, UXTOOLS_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(UXTOOLS_API, UXTools);
+
+UE_TRACE_CHANNEL_EXTERN(UXToolsChannel, UXTOOLS_API);
+
+/** Emits a CPU event to Unreal Insights if both the CPU and the UXTools trace channels are enabled. */
+#define UXT_TRACE_SCOPE(Name) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(#Name, UXToolsChannel)
+
+/** Time the enclosing scope, Name is one of the STAT_Uxt<Name> cycle stats above. */
+#define UXT_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Uxt##Name); \
+	CSV_SCOPED_TIMING_STAT(UXTools, Name); \
+	UXT_TRACE_SCOPE(Uxt##Name)
+
+/** Instrumentation for benchmarks is only compiled into builds that run automation tests or have stats enabled. */
+#define UXT_BENCHMARK_INSTRUMENTATION (WITH_DEV_AUTOMATION_TESTS || STATS)
+
+#if UXT_BENCHMARK_INSTRUMENTATION
+
+/**
+ * Time spent in BeginPlay of UX Tools actors and components, accumulated per timer until reset.
+ * Unlike the stats above this is not reset every frame, e.g. to measure the cost of loading a map. Game thread only.
+ */
+class UXTOOLS_API FUxtBeginPlayCost
+{
+public:
+
+	struct FEntry
+	{
+		uint64 Cycles = 0;
+		int32 Calls = 0;
+	};
+
+	static void Reset();
+	static void Add(FName Name, uint64 Cycles);
+
+	/** Accumulated time per timer name, timers are inclusive. */
+	static const TMap<FName, FEntry>& GetEntries();
+};
+
+class FUxtBeginPlayCostScope
+{
+public:
+
+	explicit FUxtBeginPlayCostScope(FName InName)
+		: Name(InName), StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FUxtBeginPlayCostScope()
+	{
+		FUxtBeginPlayCost::Add(Name, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+
+	FName Name;
+	uint64 StartCycles;
+};
+
+/** Time the enclosing BeginPlay scope with one of the STAT_Uxt<Name> cycle stats above, and add it to FUxtBeginPlayCost. */
+#define UXT_SCOPE_BEGIN_PLAY_COST(Name) \
+	UXT_SCOPE_CYCLE_COUNTER(Name); \
+	FUxtBeginPlayCostScope PREPROCESSOR_JOIN(UxtBeginPlayCostScope_, __LINE__)(TEXT(#Name))
+
+/**
+ * Running totals of the STAT_Uxt<Name> counters above, which are never reset.
+ * Benchmarks read these to record counters per frame without going through the stats system.
+ */
+struct UXTOOLS_API FUxtCounterTotals
+{
+	static TAtomic<uint64> SceneQueries;
+	static TAtomic<uint64> TargetsEvaluated;
+};
+
+#define UXT_INC_COUNTER_TOTAL(Name, Amount) \
+	FUxtCounterTotals::Name += (Amount)
+
+#else
+
+#define UXT_SCOPE_BEGIN_PLAY_COST(Name) \
+	UXT_SCOPE_CYCLE_COUNTER(Name)
+
+#define UXT_INC_COUNTER_TOTAL(Name, Amount)
+
+#endif
+
+/** Add to one of the STAT_Uxt<Name> counters above for the current frame. */
+#define UXT_INC_COUNTER(Name, Amount) \
+	INC_DWORD_STAT_BY(STAT_Uxt##Name, Amount); \
+	CSV_CUSTOM_STAT(UXTools, Name, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+	UXT_INC_COUNTER_TOTAL(Name, Amount)
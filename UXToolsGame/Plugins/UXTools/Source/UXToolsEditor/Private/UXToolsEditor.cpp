@@ -7,6 +7,8 @@
 #include "Editor/UnrealEdEngine.h"
 #include "ISettingsModule.h"
 #include "UxtRuntimeSettings.h"
+#include "Misc/PackageName.h"
+#include "Utils/UxtDefaultAssets.h"
 
 IMPLEMENT_GAME_MODULE(FUXToolsEditorModule, UXToolsEditor);
 
@@ -40,6 +42,11 @@ void FUXToolsEditorModule::StartupModule()
 			);
 		}
 	}
+
+	// The cook modification is a single delegate, keep calling one the project may have bound
+	FCookModificationDelegate& CookModification = FGameDelegates::Get().GetCookModificationDelegate();
+	PreviousCookModification = CookModification;
+	CookModification.BindRaw(this, &FUXToolsEditorModule::AddDefaultAssetsToCook);
 }
 
 void FUXToolsEditorModule::ShutdownModule()
@@ -55,6 +62,19 @@ void FUXToolsEditorModule::ShutdownModule()
 	{
 		SettingsModule->UnregisterSettings("Project", "Plugins", "UXTools");
 	}
+
+	FGameDelegates::Get().GetCookModificationDelegate() = PreviousCookModification;
+	PreviousCookModification.Unbind();
+}
+
+void FUXToolsEditorModule::AddDefaultAssetsToCook(TArray<FString>& ExtraFilesToCook)
+{
+	PreviousCookModification.ExecuteIfBound(ExtraFilesToCook);
+
+	for (const FSoftObjectPath& Path : FUxtDefaultAssets::Get().GetAssetPaths())
+	{
+		ExtraFilesToCook.Add(FPackageName::LongPackageNameToFilename(Path.GetLongPackageName(), FPackageName::GetAssetPackageExtension()));
+	}
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,310 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "UxtFlightAnalyzerCommandlet.h"
+#include "UXToolsEditor.h"
+#include "Utils/UxtFlightRecorder.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	const TCHAR* GetEventTypeName(EUxtFlightEventType Type)
+	{
+		switch (Type)
+		{
+		case EUxtFlightEventType::PointerSample: return TEXT("PointerSample");
+		case EUxtFlightEventType::FocusEnter: return TEXT("FocusEnter");
+		case EUxtFlightEventType::FocusExit: return TEXT("FocusExit");
+		case EUxtFlightEventType::GrabBegin: return TEXT("GrabBegin");
+		case EUxtFlightEventType::GrabEnd: return TEXT("GrabEnd");
+		case EUxtFlightEventType::PokeBegin: return TEXT("PokeBegin");
+		case EUxtFlightEventType::PokeEnd: return TEXT("PokeEnd");
+		case EUxtFlightEventType::FarPressed: return TEXT("FarPressed");
+		case EUxtFlightEventType::FarReleased: return TEXT("FarReleased");
+		case EUxtFlightEventType::ButtonPressed: return TEXT("ButtonPressed");
+		case EUxtFlightEventType::ButtonReleased: return TEXT("ButtonReleased");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	const TCHAR* GetInteractionName(EUxtFlightInteraction Interaction)
+	{
+		switch (Interaction)
+		{
+		case EUxtFlightInteraction::Grab: return TEXT("Grab");
+		case EUxtFlightInteraction::Poke: return TEXT("Poke");
+		case EUxtFlightInteraction::Far: return TEXT("Far");
+		default: return TEXT("-");
+		}
+	}
+
+	/** Events that are caused by a pointer moving into a target. */
+	bool IsMotionEvent(EUxtFlightEventType Type)
+	{
+		return Type == EUxtFlightEventType::FocusEnter || Type == EUxtFlightEventType::GrabBegin || Type == EUxtFlightEventType::PokeBegin ||
+			Type == EUxtFlightEventType::FarPressed || Type == EUxtFlightEventType::ButtonPressed;
+	}
+
+	FString FindLatestDump()
+	{
+		const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("UXTools"), TEXT("FlightRecorder"));
+
+		TArray<FString> Filenames;
+		IFileManager::Get().FindFiles(Filenames, *FPaths::Combine(Directory, TEXT("*.uxtflight")), true, false);
+
+		FString Latest;
+		FDateTime LatestTime = FDateTime::MinValue();
+		for (const FString& Filename : Filenames)
+		{
+			const FString Path = FPaths::Combine(Directory, Filename);
+			const FDateTime Time = IFileManager::Get().GetTimeStamp(*Path);
+			if (Time > LatestTime)
+			{
+				LatestTime = Time;
+				Latest = Path;
+			}
+		}
+		return Latest;
+	}
+
+	/** Value at the given fraction of sorted values. */
+	double GetPercentile(const TArray<double>& SortedValues, double Fraction)
+	{
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(Fraction * SortedValues.Num()) - 1, 0, SortedValues.Num() - 1);
+		return SortedValues[Index];
+	}
+}
+
+UUxtFlightAnalyzerCommandlet::UUxtFlightAnalyzerCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UUxtFlightAnalyzerCommandlet::Main(const FString& Params)
+{
+	FString Filename;
+	if (!FParse::Value(*Params, TEXT("File="), Filename))
+	{
+		Filename = FindLatestDump();
+	}
+
+	FUxtFlightDump Dump;
+	if (Filename.IsEmpty() || !Dump.Load(Filename))
+	{
+		UE_LOG(UXToolsEditor, Error, TEXT("Could not read flight recorder dump '%s'"), *Filename);
+		return 1;
+	}
+
+	float MotionThreshold = 10.0f;
+	FParse::Value(*Params, TEXT("MotionThreshold="), MotionThreshold);
+	float FlickerMs = 100.0f;
+	FParse::Value(*Params, TEXT("FlickerMs="), FlickerMs);
+
+	UE_LOG(UXToolsEditor, Display, TEXT("Flight recorder dump %s"), *Filename);
+
+	PrintSummary(Dump);
+	if (FParse::Param(*Params, TEXT("Timeline")))
+	{
+		PrintTimeline(Dump, FParse::Param(*Params, TEXT("Samples")));
+	}
+	PrintLatencies(Dump, MotionThreshold);
+	PrintFocusFlicker(Dump, FlickerMs);
+
+	return 0;
+}
+
+void UUxtFlightAnalyzerCommandlet::PrintSummary(const FUxtFlightDump& Dump) const
+{
+	const int32 NumEvents = Dump.Events.Num();
+	const double DurationMs = NumEvents > 1 ? (Dump.Events.Last().Cycles - Dump.Events[0].Cycles) * Dump.SecondsPerCycle * 1000.0 : 0;
+
+	UE_LOG(UXToolsEditor, Display, TEXT("%d events over %.1f ms, %llu recorded in total, %llu overwritten or incomplete"), NumEvents, DurationMs,
+		Dump.NumRecorded, Dump.NumRecorded - NumEvents);
+
+	int32 Counts[static_cast<int32>(EUxtFlightEventType::Count)] = {};
+	for (const FUxtFlightEvent& Event : Dump.Events)
+	{
+		if (Event.Type < EUxtFlightEventType::Count)
+		{
+			++Counts[static_cast<int32>(Event.Type)];
+		}
+	}
+
+	for (int32 Type = 0; Type < static_cast<int32>(EUxtFlightEventType::Count); ++Type)
+	{
+		UE_LOG(UXToolsEditor, Display, TEXT("  %-16s %d"), GetEventTypeName(static_cast<EUxtFlightEventType>(Type)), Counts[Type]);
+	}
+}
+
+void UUxtFlightAnalyzerCommandlet::PrintTimeline(const FUxtFlightDump& Dump, bool bIncludeSamples) const
+{
+	if (Dump.Events.Num() == 0)
+	{
+		return;
+	}
+
+	UE_LOG(UXToolsEditor, Display, TEXT("Timeline:"));
+
+	const uint64 StartCycles = Dump.Events[0].Cycles;
+	for (const FUxtFlightEvent& Event : Dump.Events)
+	{
+		if (Event.Type == EUxtFlightEventType::PointerSample && !bIncludeSamples)
+		{
+			continue;
+		}
+
+		UE_LOG(UXToolsEditor, Display, TEXT("  %10.3f ms  frame %-8u %-16s %-5s pointer %s  target %s  at %s"),
+			(Event.Cycles - StartCycles) * Dump.SecondsPerCycle * 1000.0, Event.Frame, GetEventTypeName(Event.Type), GetInteractionName(Event.Interaction),
+			Event.PointerId ? *Dump.GetName(Event.PointerId) : TEXT("-"), Event.TargetId ? *Dump.GetName(Event.TargetId) : TEXT("-"),
+			*Event.Location.ToCompactString());
+	}
+}
+
+TMap<FString, TArray<double>> UUxtFlightAnalyzerCommandlet::ComputeLatencies(const FUxtFlightDump& Dump, float MotionThreshold)
+{
+	// Motion onset is the last pointer sample before the pointer speed rose above the threshold.
+	// Latency is measured from the latest onset of a pointer to events it causes.
+	struct FPointerMotion
+	{
+		uint64 LastCycles = 0;
+		FVector LastLocation = FVector::ZeroVector;
+		uint64 OnsetCycles = 0;
+		bool bMoving = false;
+	};
+
+	TMap<uint32, FPointerMotion> Pointers;
+
+	// Buttons do not know the pointer that pressed them, use the last pointer that poked or far pressed them.
+	TMap<uint32, uint32> TargetPointers;
+
+	TMap<FString, TArray<double>> Latencies;
+
+	for (const FUxtFlightEvent& Event : Dump.Events)
+	{
+		if (Event.Type == EUxtFlightEventType::PointerSample)
+		{
+			FPointerMotion& Motion = Pointers.FindOrAdd(Event.PointerId);
+			if (Motion.LastCycles != 0 && Event.Cycles > Motion.LastCycles)
+			{
+				const double DeltaSeconds = (Event.Cycles - Motion.LastCycles) * Dump.SecondsPerCycle;
+				const bool bMoving = FVector::Dist(Event.Location, Motion.LastLocation) / DeltaSeconds >= MotionThreshold;
+				if (bMoving && !Motion.bMoving)
+				{
+					Motion.OnsetCycles = Motion.LastCycles;
+				}
+				Motion.bMoving = bMoving;
+			}
+			Motion.LastCycles = Event.Cycles;
+			Motion.LastLocation = Event.Location;
+			continue;
+		}
+
+		if (Event.Type == EUxtFlightEventType::PokeBegin || Event.Type == EUxtFlightEventType::FarPressed)
+		{
+			TargetPointers.Add(Event.TargetId, Event.PointerId);
+		}
+
+		if (!IsMotionEvent(Event.Type))
+		{
+			continue;
+		}
+
+		uint32 PointerId = Event.PointerId;
+		if (Event.Type == EUxtFlightEventType::ButtonPressed)
+		{
+			const uint32* TargetPointer = TargetPointers.Find(Event.TargetId);
+			PointerId = TargetPointer ? *TargetPointer : 0;
+		}
+
+		const FPointerMotion* Motion = Pointers.Find(PointerId);
+		if (Motion && Motion->OnsetCycles != 0 && Motion->OnsetCycles <= Event.Cycles)
+		{
+			const FString Key = FString::Printf(TEXT("%s %s"), GetEventTypeName(Event.Type), GetInteractionName(Event.Interaction));
+			Latencies.FindOrAdd(Key).Add((Event.Cycles - Motion->OnsetCycles) * Dump.SecondsPerCycle * 1000.0);
+		}
+	}
+
+	return Latencies;
+}
+
+void UUxtFlightAnalyzerCommandlet::PrintLatencies(const FUxtFlightDump& Dump, float MotionThreshold) const
+{
+	TMap<FString, TArray<double>> Latencies = ComputeLatencies(Dump, MotionThreshold);
+
+	UE_LOG(UXToolsEditor, Display, TEXT("Motion-to-event latency (ms), motion threshold %.1f cm/s:"), MotionThreshold);
+	UE_LOG(UXToolsEditor, Display, TEXT("  %-22s %6s %9s %9s %9s %9s %9s"), TEXT("Event"), TEXT("Count"), TEXT("Mean"), TEXT("P50"), TEXT("P90"), TEXT("P99"),
+		TEXT("Max"));
+
+	Latencies.KeySort(TLess<FString>());
+	for (TPair<FString, TArray<double>>& Pair : Latencies)
+	{
+		TArray<double>& Values = Pair.Value;
+		Values.Sort();
+
+		double Sum = 0;
+		for (double Value : Values)
+		{
+			Sum += Value;
+		}
+
+		UE_LOG(UXToolsEditor, Display, TEXT("  %-22s %6d %9.2f %9.2f %9.2f %9.2f %9.2f"), *Pair.Key, Values.Num(), Sum / Values.Num(), GetPercentile(Values, 0.5),
+			GetPercentile(Values, 0.9), GetPercentile(Values, 0.99), Values.Last());
+	}
+}
+
+TMap<uint32, int32> UUxtFlightAnalyzerCommandlet::ComputeFocusFlicker(const FUxtFlightDump& Dump, float FlickerMs, int32& OutNumFocusIntervals)
+{
+	// Focus of a pointer that ends shortly after it started, usually a pointer at the edge of a target.
+	// Pointers have separate focus for each interaction
+	TMap<uint64, const FUxtFlightEvent*> FocusStarts;
+	TMap<uint32, int32> FlickersPerTarget;
+	OutNumFocusIntervals = 0;
+
+	for (const FUxtFlightEvent& Event : Dump.Events)
+	{
+		const uint64 Key = (static_cast<uint64>(Event.PointerId) << 8) | static_cast<uint8>(Event.Interaction);
+		if (Event.Type == EUxtFlightEventType::FocusEnter)
+		{
+			FocusStarts.Add(Key, &Event);
+		}
+		else if (Event.Type == EUxtFlightEventType::FocusExit)
+		{
+			const FUxtFlightEvent* Start = nullptr;
+			if (FocusStarts.RemoveAndCopyValue(Key, Start) && Start->TargetId == Event.TargetId)
+			{
+				++OutNumFocusIntervals;
+				if ((Event.Cycles - Start->Cycles) * Dump.SecondsPerCycle * 1000.0 < FlickerMs)
+				{
+					++FlickersPerTarget.FindOrAdd(Event.TargetId);
+				}
+			}
+		}
+	}
+
+	return FlickersPerTarget;
+}
+
+void UUxtFlightAnalyzerCommandlet::PrintFocusFlicker(const FUxtFlightDump& Dump, float FlickerMs) const
+{
+	int32 NumFocusIntervals = 0;
+	TMap<uint32, int32> FlickersPerTarget = ComputeFocusFlicker(Dump, FlickerMs, NumFocusIntervals);
+
+	int32 NumFlickers = 0;
+	for (const TPair<uint32, int32>& Pair : FlickersPerTarget)
+	{
+		NumFlickers += Pair.Value;
+	}
+
+	UE_LOG(UXToolsEditor, Display, TEXT("Focus flicker: %d of %d focus intervals shorter than %.0f ms"), NumFlickers, NumFocusIntervals, FlickerMs);
+
+	FlickersPerTarget.ValueSort(TGreater<int32>());
+	for (const TPair<uint32, int32>& Pair : FlickersPerTarget)
+	{
+		UE_LOG(UXToolsEditor, Display, TEXT("  %5d  %s"), Pair.Value, *Dump.GetName(Pair.Key));
+	}
+}
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "GameDelegates.h"
 #include "Modules/ModuleInterface.h"
 #include "Modules/ModuleManager.h"
 
@@ -15,4 +16,12 @@ public:
 
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+
+	/** Add the default assets of UX Tools components to the cook, they are only referenced by path. */
+	void AddDefaultAssetsToCook(TArray<FString>& ExtraFilesToCook);
+
+	/** Cook modification of the project, if it has bound one before this module. */
+	FCookModificationDelegate PreviousCookModification;
 };
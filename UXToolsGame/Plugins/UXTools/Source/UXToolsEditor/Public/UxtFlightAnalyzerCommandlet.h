@@ -0,0 +1,47 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+
+#include "UxtFlightAnalyzerCommandlet.generated.h"
+
+struct FUxtFlightDump;
+
+/**
+ * Prints a summary of a flight recorder dump: event counts, motion-to-event latency distributions and focus flicker.
+ *
+ * UE4Editor-Cmd UXToolsGame.uproject -run=UxtFlightAnalyzer [-File=<Dump>] [-Timeline] [-Samples] [-MotionThreshold=<cm/s>] [-FlickerMs=<ms>]
+ *
+ * Without -File the latest dump in Saved/UXTools/FlightRecorder is used.
+ * -Timeline prints every event, -Samples also includes pointer samples in the timeline.
+ */
+UCLASS()
+class UXTOOLSEDITOR_API UUxtFlightAnalyzerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UUxtFlightAnalyzerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+	/**
+	 * Motion-to-event latencies in milliseconds, keyed by event type and interaction, e.g. "PokeBegin Poke".
+	 * Motion onset is the last pointer sample before the pointer speed rose above MotionThreshold in cm/s.
+	 */
+	static TMap<FString, TArray<double>> ComputeLatencies(const FUxtFlightDump& Dump, float MotionThreshold);
+
+	/** Number of focus intervals shorter than FlickerMs per target, and the total number of focus intervals. */
+	static TMap<uint32, int32> ComputeFocusFlicker(const FUxtFlightDump& Dump, float FlickerMs, int32& OutNumFocusIntervals);
+
+private:
+
+	void PrintSummary(const FUxtFlightDump& Dump) const;
+	void PrintTimeline(const FUxtFlightDump& Dump, bool bIncludeSamples) const;
+	void PrintLatencies(const FUxtFlightDump& Dump, float MotionThreshold) const;
+	void PrintFocusFlicker(const FUxtFlightDump& Dump, float FlickerMs) const;
+};
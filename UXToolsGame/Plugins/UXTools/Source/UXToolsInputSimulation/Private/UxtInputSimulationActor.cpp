@@ -10,6 +10,7 @@
 #include "Components/InputComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Engine/Engine.h"
+#include "EngineUtils.h"
 #include "GameFramework/PlayerInput.h"
 #include "Misc/RuntimeErrors.h"
 #include "Kismet/GameplayStatics.h"
@@ -77,16 +78,8 @@ void AUxtInputSimulationActor::SetupHandComponents()
 	AddTickPrerequisiteComponent(RightHand);
 
 	// Link the skeletal mesh components to animation assets.
-	if (Settings->HandMesh)
-	{
-		LeftHand->SetSkeletalMesh(Settings->HandMesh.Get());
-		RightHand->SetSkeletalMesh(Settings->HandMesh.Get());
-	}
-	if (Settings->HandAnimInstance)
-	{
-		LeftHand->SetAnimInstanceClass(Settings->HandAnimInstance.Get());
-		RightHand->SetAnimInstanceClass(Settings->HandAnimInstance.Get());
-	}
+	// Hand assets are preloaded by the input simulation subsystem, if they are not loaded yet they are assigned once they are.
+	UpdateHandAssets();
 
 	// Disable shadows
 	LeftHand->SetCastShadow(false);
@@ -129,6 +122,20 @@ namespace
 	const FName Axis_LookUpRate = TEXT("InputSimulation_LookUpRate");
 }
 
+static void BakeHandPoseCommand(const TArray<FString>& Args, UWorld* World)
+{
+	const EControllerHand Hand = (Args.Num() > 0 && Args[0] == TEXT("Left")) ? EControllerHand::Left : EControllerHand::Right;
+	for (TActorIterator<AUxtInputSimulationActor> It(World); It; ++It)
+	{
+		It->BakeHandPose(Hand);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BakeHandPoseConsoleCommand(
+	TEXT("UXTools.InputSimulation.BakeHandPose"),
+	TEXT("Store the current joints of the simulated hand (Left or Right, default Right) as the joint table of its target pose."),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&BakeHandPoseCommand));
+
 static void InitializeDefaultInputSimulationMappings()
 {
 	static bool bMappingsAdded = false;
@@ -229,6 +236,22 @@ void AUxtInputSimulationActor::BeginPlay()
 			InputComponent->BindAxis(Axis_Scroll, this, &AUxtInputSimulationActor::AddInputScroll);
 		}
 	}
+
+	UpdateHandAnimTickOption();
+
+#if WITH_EDITOR
+	// Button mappings can be edited in the project settings while playing.
+	UUxtRuntimeSettings::Get()->OnSettingsChanged.AddUObject(this, &AUxtInputSimulationActor::OnRuntimeSettingsChanged);
+#endif
+}
+
+void AUxtInputSimulationActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+#if WITH_EDITOR
+	UUxtRuntimeSettings::Get()->OnSettingsChanged.RemoveAll(this);
+#endif
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AUxtInputSimulationActor::Tick(float DeltaSeconds)
@@ -249,6 +272,9 @@ void AUxtInputSimulationActor::Tick(float DeltaSeconds)
 	FQuat HeadRotation = GetActorRotation().Quaternion();
 	FVector HeadLocation = GetActorLocation();
 
+	UpdateProceduralHandPose(EControllerHand::Left, DeltaSeconds);
+	UpdateProceduralHandPose(EControllerHand::Right, DeltaSeconds);
+
 	FWindowsMixedRealityInputSimulationHandState LeftHandState, RightHandState;
 	UpdateSimulatedHandState(EControllerHand::Left, LeftHandState);
 	UpdateSimulatedHandState(EControllerHand::Right, RightHandState);
@@ -302,10 +328,111 @@ bool AUxtInputSimulationActor::IsHandControlled(EControllerHand Hand) const
 	return ControlledHands.Contains(Hand);
 }
 
-void AUxtInputSimulationActor::UpdateSimulatedHandState(EControllerHand Hand, FWindowsMixedRealityInputSimulationHandState& HandState) const
+void AUxtInputSimulationActor::UpdateHandAssets()
 {
-	typedef FWindowsMixedRealityInputSimulationHandState::ButtonStateArray ButtonStateArray;
+	const auto* Settings = UUxtRuntimeSettings::Get();
+	check(Settings);
+
+	for (USkeletalMeshComponent* HandMesh : { LeftHand, RightHand })
+	{
+		if (USkeletalMesh* Mesh = Settings->HandMesh.Get())
+		{
+			if (HandMesh->SkeletalMesh != Mesh)
+			{
+				HandMesh->SetSkeletalMesh(Mesh);
+			}
+		}
+		if (UClass* AnimClass = Settings->HandAnimInstance.Get())
+		{
+			if (HandMesh->AnimClass != AnimClass)
+			{
+				HandMesh->SetAnimInstanceClass(AnimClass);
+			}
+		}
+	}
+}
+
+bool AUxtInputSimulationActor::IsHandPoseProcedural(EControllerHand Hand) const
+{
+	return GetProceduralHandPose(Hand) != nullptr;
+}
+
+bool AUxtInputSimulationActor::BakeHandPose(EControllerHand Hand)
+{
+	USkeletalMeshComponent* MeshComp = GetHandMesh(Hand);
+	if (!MeshComp || MeshComp->GetComponentSpaceTransforms().Num() == 0)
+	{
+		return false;
+	}
+
+	auto* Settings = UUxtRuntimeSettings::Get();
+	check(Settings);
+
+	const FKeypointBoneIndices& KeypointBones = GetKeypointBoneIndices(Hand, MeshComp);
+	const TArray<FTransform>& ComponentSpaceTMs = MeshComp->GetComponentSpaceTransforms();
+
+	TArray<FTransform>& JointTransforms = Settings->HandPoseJoints.FindOrAdd(GetTargetPose(Hand)).JointTransforms;
+	JointTransforms.SetNum(EWMRHandKeypointCount);
+	for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
+	{
+		const int32 BoneIndex = KeypointBones.BoneIndices[iKeypoint];
+		JointTransforms[iKeypoint] = ComponentSpaceTMs.IsValidIndex(BoneIndex) ? ComponentSpaceTMs[BoneIndex] : FTransform::Identity;
+	}
+
+	Settings->SaveConfig();
+
+	UpdateHandAnimTickOption();
+	return true;
+}
+
+void AUxtInputSimulationActor::UpdateProceduralHandPose(EControllerHand Hand, float DeltaSeconds)
+{
+	const auto* Settings = UUxtRuntimeSettings::Get();
+	check(Settings);
+
+	TArray<FTransform>& Joints = (Hand == EControllerHand::Left ? LeftProceduralJoints : RightProceduralJoints);
+
+	const FUxtRuntimeSettingsHandPoseJoints* TargetJoints = Settings->bUseProceduralHandPoses ? Settings->HandPoseJoints.Find(GetTargetPose(Hand)) : nullptr;
+	if (!TargetJoints || TargetJoints->JointTransforms.Num() != EWMRHandKeypointCount)
+	{
+		// Fall back to the hand mesh
+		Joints.Reset();
+		return;
+	}
+
+	// Start from the target pose, e.g. when procedural posing has just been enabled.
+	if (Joints.Num() != EWMRHandKeypointCount || Settings->HandPoseBlendTime <= 0)
+	{
+		Joints = TargetJoints->JointTransforms;
+		return;
+	}
+
+	const float Alpha = 1.0f - FMath::Exp(-DeltaSeconds / Settings->HandPoseBlendTime);
+	for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
+	{
+		Joints[iKeypoint].BlendWith(TargetJoints->JointTransforms[iKeypoint], Alpha);
+	}
+}
+
+const TArray<FTransform>* AUxtInputSimulationActor::GetProceduralHandPose(EControllerHand Hand) const
+{
+	const TArray<FTransform>& Joints = (Hand == EControllerHand::Left ? LeftProceduralJoints : RightProceduralJoints);
+	return Joints.Num() == EWMRHandKeypointCount ? &Joints : nullptr;
+}
+
+void AUxtInputSimulationActor::UpdateHandAnimTickOption()
+{
+	// Procedural joints do not need the animated mesh, only animate it while it can be seen.
+	// A pose without a joint table reads the mesh, which then has to be animated even when it is not rendered.
+	const EVisibilityBasedAnimTickOption TickOption = UUxtRuntimeSettings::Get()->CanUseProceduralHandPoses() ?
+		EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered : EVisibilityBasedAnimTickOption::AlwaysTickPose;
 
+	LeftHand->VisibilityBasedAnimTickOption = TickOption;
+	RightHand->VisibilityBasedAnimTickOption = TickOption;
+}
+
+void AUxtInputSimulationActor::UpdateSimulatedHandState(EControllerHand Hand, FWindowsMixedRealityInputSimulationHandState& HandState)
+{
 	const auto* Settings = UUxtRuntimeSettings::Get();
 	check(Settings);
 	USkeletalMeshComponent* MeshComp = GetHandMesh(Hand);
@@ -331,50 +458,38 @@ void AUxtInputSimulationActor::UpdateSimulatedHandState(EControllerHand Hand, FW
 	{
 		HandState.bHasJointPoses = true;
 
-		const UEnum* KeypointEnum = FindObject<UEnum>(ANY_PACKAGE, TEXT("EWMRHandKeypoint"), true);
-		check(KeypointEnum);
-		TArray<FName> BoneNames;
-		MeshComp->GetBoneNames(BoneNames);
-
-		// Transforms for pointer pose
-		FTransform WristTransform = FTransform::Identity;
-		FTransform IndexKnuckleTransform = FTransform::Identity;
+		const FTransform& ComponentTransform = MeshComp->GetComponentTransform();
 
-		const TArray<FTransform>& ComponentSpaceTMs = MeshComp->GetComponentSpaceTransforms();
-		for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
+		if (const TArray<FTransform>* ProceduralJoints = GetProceduralHandPose(Hand))
 		{
-			EWMRHandKeypoint Keypoint = (EWMRHandKeypoint)iKeypoint;
-			FName KeypointName = FName(*KeypointEnum->GetNameStringByValue(iKeypoint));
-
-			int32 KeypointPoseIndex;
-			FTransform KeypointTransform;
-			if (BoneNames.Find(KeypointName, KeypointPoseIndex))
+			for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
 			{
-				KeypointTransform = ComponentSpaceTMs[KeypointPoseIndex];
+				FTransform::Multiply(&HandState.KeypointTransforms[iKeypoint], &(*ProceduralJoints)[iKeypoint], &ComponentTransform);
 			}
-			else
+		}
+		else
+		{
+			const FKeypointBoneIndices& KeypointBones = GetKeypointBoneIndices(Hand, MeshComp);
+			const TArray<FTransform>& ComponentSpaceTMs = MeshComp->GetComponentSpaceTransforms();
+
+			for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
 			{
-				KeypointTransform.SetIdentity();
+				const int32 BoneIndex = KeypointBones.BoneIndices[iKeypoint];
+				const FTransform& BoneTransform = ComponentSpaceTMs.IsValidIndex(BoneIndex) ? ComponentSpaceTMs[BoneIndex] : FTransform::Identity;
+				FTransform::Multiply(&HandState.KeypointTransforms[iKeypoint], &BoneTransform, &ComponentTransform);
 			}
+		}
 
-			FTransform::Multiply(&KeypointTransform, &KeypointTransform, &MeshComp->GetComponentTransform());
-
+		for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
+		{
 			// TODO What skeletal mesh property could be used for the radius?
-			float KeypointRadius = 1.0f;
-
-			HandState.KeypointTransforms[(uint32)Keypoint] = KeypointTransform;
-			HandState.KeypointRadii[(uint32)Keypoint] = KeypointRadius;
-
-			if (Keypoint == EWMRHandKeypoint::Wrist)
-			{
-				WristTransform = KeypointTransform;
-			}
-			if (Keypoint == EWMRHandKeypoint::IndexProximal)
-			{
-				IndexKnuckleTransform = KeypointTransform;
-			}
+			HandState.KeypointRadii[iKeypoint] = 1.0f;
 		}
 
+		// Transforms for pointer pose
+		const FTransform& WristTransform = HandState.KeypointTransforms[(uint32)EWMRHandKeypoint::Wrist];
+		const FTransform& IndexKnuckleTransform = HandState.KeypointTransforms[(uint32)EWMRHandKeypoint::IndexProximal];
+
 		// Build pointer pose from bones
 		{
 			HandState.bHasPointerPose = true;
@@ -403,21 +518,15 @@ void AUxtInputSimulationActor::UpdateSimulatedHandState(EControllerHand Hand, FW
 	//
 	// Update the button press states
 
-	HandState.IsButtonPressed = 0;
+	if (!bPoseButtonMasksValid)
+	{
+		UpdatePoseButtonMasks();
+	}
 
-	FName TargetPose = GetTargetPose(Hand);
-	const FUxtRuntimeSettingsButtonSet* pTargetActions = Settings->HandPoseButtonMappings.Find(TargetPose);
-	if (pTargetActions)
+	const FWindowsMixedRealityInputSimulationHandState::ButtonStateArray* PoseButtonMask = PoseButtonMasks.Find(GetTargetPose(Hand));
+	if (PoseButtonMask)
 	{
-		for (uint32 iButton = 0; iButton < (uint32)EHMDInputControllerButtons::Count; ++iButton)
-		{
-			EHMDInputControllerButtons Button = (EHMDInputControllerButtons)iButton;
-			ButtonStateArray ButtonMask(true, iButton);
-			if (pTargetActions->Buttons.Contains(Button))
-			{
-				HandState.IsButtonPressed |= ButtonMask;
-			}
-		}
+		HandState.IsButtonPressed = *PoseButtonMask;
 	}
 	else
 	{
@@ -425,6 +534,55 @@ void AUxtInputSimulationActor::UpdateSimulatedHandState(EControllerHand Hand, FW
 	}
 }
 
+const AUxtInputSimulationActor::FKeypointBoneIndices& AUxtInputSimulationActor::GetKeypointBoneIndices(EControllerHand Hand, const USkeletalMeshComponent* MeshComp)
+{
+	FKeypointBoneIndices& KeypointBones = (Hand == EControllerHand::Left ? LeftKeypointBones : RightKeypointBones);
+	if (KeypointBones.Mesh.Get() != MeshComp->SkeletalMesh)
+	{
+		KeypointBones.Mesh = MeshComp->SkeletalMesh;
+
+		// Bones are matched to keypoints by name.
+		const UEnum* KeypointEnum = StaticEnum<EWMRHandKeypoint>();
+		for (int32 iKeypoint = 0; iKeypoint < EWMRHandKeypointCount; ++iKeypoint)
+		{
+			const FName KeypointName = FName(*KeypointEnum->GetNameStringByValue(iKeypoint));
+			KeypointBones.BoneIndices[iKeypoint] = MeshComp->GetBoneIndex(KeypointName);
+		}
+	}
+	return KeypointBones;
+}
+
+void AUxtInputSimulationActor::UpdatePoseButtonMasks()
+{
+	typedef FWindowsMixedRealityInputSimulationHandState::ButtonStateArray ButtonStateArray;
+
+	const auto* Settings = UUxtRuntimeSettings::Get();
+	check(Settings);
+
+	PoseButtonMasks.Reset();
+	for (const auto& Mapping : Settings->HandPoseButtonMappings)
+	{
+		ButtonStateArray& PoseMask = PoseButtonMasks.Add(Mapping.Key);
+		PoseMask = 0;
+		for (EHMDInputControllerButtons Button : Mapping.Value.Buttons)
+		{
+			if ((uint32)Button < (uint32)EHMDInputControllerButtons::Count)
+			{
+				PoseMask |= ButtonStateArray(true, (uint32)Button);
+			}
+		}
+	}
+	bPoseButtonMasksValid = true;
+}
+
+#if WITH_EDITOR
+void AUxtInputSimulationActor::OnRuntimeSettingsChanged()
+{
+	bPoseButtonMasksValid = false;
+	UpdateHandAnimTickOption();
+}
+#endif
+
 void AUxtInputSimulationActor::OnToggleLeftHandPressed()
 {
 	SetHandVisibility(EControllerHand::Left, !IsHandVisible(EControllerHand::Left));
@@ -3,11 +3,13 @@
 
 #include "UxtInputSimulationLocalPlayerSubsystem.h"
 #include "UxtInputSimulationActor.h"
+#include "UxtRuntimeSettings.h"
 
 #include "WindowsMixedRealityInputSimulationEngineSubsystem.h"
 
 #include "IHeadMountedDisplay.h"
 #include "Camera/CameraComponent.h"
+#include "Engine/AssetManager.h"
 #include "Engine/Engine.h"
 #include "Engine/LocalPlayer.h"
 #include "Engine/World.h"
@@ -24,6 +26,8 @@ bool UUxtInputSimulationLocalPlayerSubsystem::ShouldCreateSubsystem(UObject* Out
 
 void UUxtInputSimulationLocalPlayerSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	PreloadHandAssets();
+
 	// Subscribe to PostLoadMap event to recreate the actors after a map has been destroyed.
 	FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UUxtInputSimulationLocalPlayerSubsystem::OnPostLoadMapWithWorld);
 
@@ -40,6 +44,43 @@ void UUxtInputSimulationLocalPlayerSubsystem::Deinitialize()
 {
 	DestroyInputSimActor();
 	DestroyHmdCameraActor();
+
+	if (HandAssetsHandle.IsValid())
+	{
+		HandAssetsHandle->CancelHandle();
+		HandAssetsHandle.Reset();
+	}
+}
+
+void UUxtInputSimulationLocalPlayerSubsystem::PreloadHandAssets()
+{
+	const auto* Settings = UUxtRuntimeSettings::Get();
+	check(Settings);
+
+	TArray<FSoftObjectPath> HandAssets;
+	if (!Settings->HandMesh.IsNull())
+	{
+		HandAssets.Add(Settings->HandMesh.ToSoftObjectPath());
+	}
+	if (!Settings->HandAnimInstance.IsNull())
+	{
+		HandAssets.Add(Settings->HandAnimInstance.ToSoftObjectPath());
+	}
+
+	if (HandAssets.Num() > 0 && !HandAssetsHandle.IsValid())
+	{
+		HandAssetsHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(HandAssets,
+			FStreamableDelegate::CreateUObject(this, &UUxtInputSimulationLocalPlayerSubsystem::OnHandAssetsLoaded));
+	}
+}
+
+void UUxtInputSimulationLocalPlayerSubsystem::OnHandAssetsLoaded()
+{
+	// The actor may have been spawned before the assets were available.
+	if (AUxtInputSimulationActor* InputSimActor = Cast<AUxtInputSimulationActor>(InputSimActorWeak.Get()))
+	{
+		InputSimActor->UpdateHandAssets();
+	}
 }
 
 void UUxtInputSimulationLocalPlayerSubsystem::CreateActors(UWorld* World)
@@ -63,6 +104,12 @@ void UUxtInputSimulationLocalPlayerSubsystem::CreateActors(UWorld* World)
 
 void UUxtInputSimulationLocalPlayerSubsystem::CreateInputSimActor(UWorld* World)
 {
+	// Keep the actor if the map load did not replace its world, e.g. when the map was streamed into the same world.
+	if (InputSimActorWeak.IsValid() && InputSimActorWeak->GetWorld() != World)
+	{
+		DestroyInputSimActor();
+	}
+
 	if (!InputSimActorWeak.IsValid())
 	{
 		FActorSpawnParameters p;
@@ -76,6 +123,11 @@ void UUxtInputSimulationLocalPlayerSubsystem::CreateInputSimActor(UWorld* World)
 
 void UUxtInputSimulationLocalPlayerSubsystem::CreateHmdCameraActor(UWorld* World)
 {
+	if (HmdCameraActorWeak.IsValid() && HmdCameraActorWeak->GetWorld() != World)
+	{
+		DestroyHmdCameraActor();
+	}
+
 	if (!HmdCameraActorWeak.IsValid())
 	{
 		FActorSpawnParameters p;
@@ -5,10 +5,11 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "WindowsMixedRealityInputSimulationEngineSubsystem.h"
 
 #include "UxtInputSimulationActor.generated.h"
 
-struct FWindowsMixedRealityInputSimulationHandState;
+class USkeletalMesh;
 class UUxtInputSimulationHeadMovementComponent;
 
 /** Actor that produces head pose and hand animations for the input simulation subsystem. */
@@ -21,6 +22,7 @@ class UXTOOLSINPUTSIMULATION_API AUxtInputSimulationActor
 public:
 
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaSeconds) override;
 
 	/** Get the current animation pose of a hand.
@@ -55,6 +57,30 @@ public:
 	UFUNCTION(BlueprintPure, Category = InputSimulation)
 	bool IsHandControlled(EControllerHand Hand) const;
 
+	/** True if the joints of the hand are currently produced from procedural hand poses. */
+	UFUNCTION(BlueprintPure, Category = InputSimulation)
+	bool IsHandPoseProcedural(EControllerHand Hand) const;
+
+	/** Store the current joints of the animated hand mesh as the joint table of the hand's target pose.
+	 *  The table is saved in the runtime settings and used for procedural hand posing.
+	 *  Returns false if the hand mesh has no pose.
+	 */
+	UFUNCTION(BlueprintCallable, Category = InputSimulation)
+	bool BakeHandPose(EControllerHand Hand);
+
+	/** Blend the procedural joints of a hand towards the joint table of the target pose.
+	 *  Called on tick, joints are cleared if the target pose has no joint table.
+	 */
+	void UpdateProceduralHandPose(EControllerHand Hand, float DeltaSeconds);
+
+	/** Returns the procedural joints of the hand in mesh space, or null if the hand mesh pose should be used. */
+	const TArray<FTransform>* GetProceduralHandPose(EControllerHand Hand) const;
+
+	/** Assign the hand mesh and animation from the runtime settings to hands that do not use them yet.
+	 *  Called when the hand assets have finished loading.
+	 */
+	void UpdateHandAssets();
+
 private:
 
 	void OnToggleLeftHandPressed();
@@ -119,8 +145,38 @@ private:
 	/** Returns the skeletal mesh for the given hand. */
 	USkeletalMeshComponent* GetHandMesh(EControllerHand Hand) const;
 
+	/** Only animate the hand meshes while rendered if no pose needs to read joints from the animated mesh. */
+	void UpdateHandAnimTickOption();
+
 	/** Copy results of hand animation into the hand state. */
-	void UpdateSimulatedHandState(EControllerHand Hand, FWindowsMixedRealityInputSimulationHandState& HandState) const;
+	void UpdateSimulatedHandState(EControllerHand Hand, FWindowsMixedRealityInputSimulationHandState& HandState);
+
+	/** Bone index of each hand keypoint in a hand mesh. */
+	struct FKeypointBoneIndices
+	{
+		FKeypointBoneIndices()
+		{
+			for (int32& BoneIndex : BoneIndices)
+			{
+				BoneIndex = INDEX_NONE;
+			}
+		}
+
+		/** Mesh the indices were computed for. */
+		TWeakObjectPtr<USkeletalMesh> Mesh;
+		/** Bone index per keypoint, INDEX_NONE if the mesh has no bone with the keypoint name. */
+		int32 BoneIndices[EWMRHandKeypointCount];
+	};
+
+	/** Returns the keypoint bone indices for the hand mesh, looking them up again if the mesh has changed. */
+	const FKeypointBoneIndices& GetKeypointBoneIndices(EControllerHand Hand, const USkeletalMeshComponent* MeshComp);
+
+	/** Build the button mask of each hand pose from the runtime settings. */
+	void UpdatePoseButtonMasks();
+
+#if WITH_EDITOR
+	void OnRuntimeSettingsChanged();
+#endif
 
 public:
 
@@ -154,4 +210,18 @@ private:
 	/** Rotation offset for each hand. */
 	TMap<EControllerHand, FRotator> HandRotations;
 
+	/** Keypoint bone indices for each hand mesh. */
+	FKeypointBoneIndices LeftKeypointBones;
+	FKeypointBoneIndices RightKeypointBones;
+
+	/** Pressed buttons for each hand pose with button mappings. */
+	TMap<FName, FWindowsMixedRealityInputSimulationHandState::ButtonStateArray> PoseButtonMasks;
+
+	/** True if the pose button masks match the runtime settings. */
+	bool bPoseButtonMasksValid = false;
+
+	/** Procedural joints for each hand in mesh space, empty if the hand mesh pose is used. */
+	TArray<FTransform> LeftProceduralJoints;
+	TArray<FTransform> RightProceduralJoints;
+
 };
@@ -12,6 +12,7 @@
 class AGameModeBase;
 class APlayerController;
 class UCameraComponent;
+struct FStreamableHandle;
 
 /** Subsystem that creates an actor for simulation when a game is started. */
 UCLASS(ClassGroup = UXTools)
@@ -44,8 +45,16 @@ private:
 
 	void OnPostLoadMapWithWorld(UWorld* LoadedWorld);
 
+	/** Start loading the hand assets in the background so actors do not have to wait for them. */
+	void PreloadHandAssets();
+
+	void OnHandAssetsLoaded();
+
 private:
 
+	/** Keeps the preloaded hand assets in memory. */
+	TSharedPtr<FStreamableHandle> HandAssetsHandle;
+
 	/** Primary actor that performs input simulation and stores resulting data in the input simulation engine subsystem. */
 	TWeakObjectPtr<AActor> InputSimActorWeak;
 
@@ -5,7 +5,8 @@
 #include "Misc/ConfigCacheIni.h"
 #include "CoreGlobals.h"
 #include "UObject/Package.h"
-#include "UObject/ConstructorHelpers.h"
+#include "UObject/SoftObjectPtr.h"
+#include "WindowsMixedRealityHandTrackingTypes.h"
 
 UUxtRuntimeSettings* UUxtRuntimeSettings::UXToolsSettingsSingleton = nullptr;
 
@@ -16,11 +17,10 @@ UUxtRuntimeSettings::UUxtRuntimeSettings(const FObjectInitializer& ObjectInitial
 
 	// Input simulation assets are only available on certain platforms, avoid errors trying to find content on unsupported platforms.
 #if WITH_INPUT_SIMULATION
-	// Default hand mesh and animation assets
-	static ConstructorHelpers::FObjectFinder<USkeletalMesh> HandMeshFinder(TEXT("/UXTools/InputSimulation/InputSimulationHands"));
-	HandMesh = HandMeshFinder.Object;
-	static ConstructorHelpers::FClassFinder<UAnimInstance> HandAnimFinder(TEXT("/UXTools/InputSimulation/InputSimulationHands_AnimInstance"));
-	HandAnimInstance = HandAnimFinder.Class;
+	// Default hand mesh and animation assets.
+	// Only the paths are set here, the input simulation subsystem loads the assets asynchronously.
+	HandMesh = TSoftObjectPtr<USkeletalMesh>(FSoftObjectPath(TEXT("/UXTools/InputSimulation/InputSimulationHands.InputSimulationHands")));
+	HandAnimInstance = TSoftClassPtr<UAnimInstance>(FSoftObjectPath(TEXT("/UXTools/InputSimulation/InputSimulationHands_AnimInstance.InputSimulationHands_AnimInstance_C")));
 #endif
 }
 
@@ -29,6 +29,8 @@ UUxtRuntimeSettings::UUxtRuntimeSettings(const FObjectInitializer& ObjectInitial
 void UUxtRuntimeSettings::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
 {
 	GConfig->Flush(false);
+
+	OnSettingsChanged.Broadcast();
 }
 
 #endif
@@ -48,4 +50,32 @@ UUxtRuntimeSettings* UUxtRuntimeSettings::Get()
 		}
 	}
 	return UXToolsSettingsSingleton;
-}
\ No newline at end of file
+}
+
+bool UUxtRuntimeSettings::HasHandPoseJoints(FName PoseName) const
+{
+	const FUxtRuntimeSettingsHandPoseJoints* PoseJoints = HandPoseJoints.Find(PoseName);
+	return PoseJoints && PoseJoints->JointTransforms.Num() == EWMRHandKeypointCount;
+}
+
+bool UUxtRuntimeSettings::CanUseProceduralHandPoses() const
+{
+	if (!bUseProceduralHandPoses)
+	{
+		return false;
+	}
+
+	if (!HasHandPoseJoints(DefaultHandPose) || !HasHandPoseJoints(PrimaryHandPose) || !HasHandPoseJoints(SecondaryHandPose))
+	{
+		return false;
+	}
+
+	for (const auto& Mapping : HandPoseButtonMappings)
+	{
+		if (!HasHandPoseJoints(Mapping.Key))
+		{
+			return false;
+		}
+	}
+	return true;
+}
@@ -22,6 +22,15 @@ struct UXTOOLSRUNTIMESETTINGS_API FUxtRuntimeSettingsButtonSet
 	TSet<EHMDInputControllerButtons> Buttons;
 };
 
+USTRUCT()
+struct UXTOOLSRUNTIMESETTINGS_API FUxtRuntimeSettingsHandPoseJoints
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Input Simulation", Meta = (DisplayName = "Joint Transforms", Tooltip = "Joint transforms in hand mesh space, in the order of the EWMRHandKeypoint enum."))
+	TArray<FTransform> JointTransforms;
+};
+
 /**
  * Settings for UXTools.
  */
@@ -35,8 +44,17 @@ public:
 
 	static UUxtRuntimeSettings* Get();
 
+	/** True if the pose has a joint table with a transform for every hand keypoint. */
+	bool HasHandPoseJoints(FName PoseName) const;
+
+	/** True if procedural hand poses are enabled and the default, primary, secondary and button mapped poses all have joint tables. */
+	bool CanUseProceduralHandPoses() const;
+
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+
+	/** Broadcast when a setting has been changed in the editor. */
+	FSimpleMulticastDelegate OnSettingsChanged;
 #endif // WITH_EDITOR
 
 	//
@@ -91,9 +109,28 @@ public:
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Input Simulation", Meta = (DisplayName = "Hand Mesh", Tooltip = "Skeletal mesh for animating hands."))
 	TSoftObjectPtr<USkeletalMesh> HandMesh;
 
-	/** Animation instance used for animating hand meshes. */
+	/** Animation instance used for animating hand meshes.
+	 *  Loaded in the background together with the hand mesh when input simulation starts.
+	 */
 	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Input Simulation", Meta = (DisplayName = "Hand Animation", Tooltip = "Animation instance used for animating hand meshes."))
-	TSubclassOf<UAnimInstance> HandAnimInstance;
+	TSoftClassPtr<UAnimInstance> HandAnimInstance;
+
+	/** Produce simulated hand joints by blending the hand pose joint tables instead of reading the animated hand mesh.
+	 *  Opt-in: no joint tables ship with the plugin, they have to be baked into HandPoseJoints first, see the input simulation docs.
+	 *  Poses without a joint table still use the hand mesh. Once all poses have a joint table the hand mesh is only animated while it is rendered.
+	 */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Input Simulation", Meta = (DisplayName = "Use Procedural Hand Poses", Tooltip = "Blend hand pose joint tables instead of reading the animated hand mesh."))
+	bool bUseProceduralHandPoses = false;
+
+	/** Time for procedural hand joints to blend most of the way to a new pose. */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Input Simulation", Meta = (DisplayName = "Hand Pose Blend Time", Tooltip = "Time for procedural hand joints to blend most of the way to a new pose.", ClampMin = "0.0"))
+	float HandPoseBlendTime = 0.1f;
+
+	/** Joint tables of hand poses for procedural hand posing.
+	 *  Tables are baked from the animated hand mesh with the UXTools.InputSimulation.BakeHandPose console command.
+	 */
+	UPROPERTY(GlobalConfig, EditAnywhere, Category = "Input Simulation", Meta = (DisplayName = "Hand Pose Joints", Tooltip = "Joint tables of hand poses for procedural hand posing."))
+	TMap<FName, FUxtRuntimeSettingsHandPoseJoints> HandPoseJoints;
 
 private:
 
@@ -0,0 +1,360 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#include "Behaviors/UxtFollowComponent.h"
+#include "Controls/UxtBoundingBoxManipulatorComponent.h"
+#include "Controls/UxtPressableButtonComponent.h"
+#include "Controls/UxtPressableButtonSubsystem.h"
+#include "Input/UxtHandInteractionActor.h"
+#include "FrameQueue.h"
+#include "PointerTestSequence.h"
+#include "UxtBenchmarkRecorder.h"
+#include "UxtTestHandTracker.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Objects are placed on a grid in front of the hands, filling rows of this many columns. */
+	const int32 GridColumns = 20;
+
+	FVector GetGridLocation(int32 Index, float Spacing)
+	{
+		const int32 Column = Index % GridColumns;
+		const int32 Row = Index / GridColumns;
+		return FVector(100 + (Row / GridColumns) * Spacing, (Column - GridColumns / 2) * Spacing, (Row % GridColumns - GridColumns / 2) * Spacing);
+	}
+
+	int32 GetScaledCount(int32 Count)
+	{
+		return FMath::Max(1, FMath::RoundToInt(Count * FUxtBenchmarkRecorder::GetCountScale()));
+	}
+
+	AActor* CreateButton(UWorld* World, const FVector& Location, UStaticMesh* MeshAsset)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->SetWorldLocation(Location);
+		Root->RegisterComponent();
+
+		UUxtPressableButtonComponent* Button = NewObject<UUxtPressableButtonComponent>(Actor);
+		Button->SetupAttachment(Root);
+		Button->RegisterComponent();
+
+		UStaticMeshComponent* Mesh = NewObject<UStaticMeshComponent>(Actor);
+		Mesh->SetupAttachment(Root);
+		Mesh->SetStaticMesh(MeshAsset);
+		Mesh->SetRelativeScale3D(FVector::OneVector * 0.05f);
+		Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Mesh->RegisterComponent();
+
+		Button->SetVisuals(Mesh);
+		return Actor;
+	}
+
+	/** Spawn a button actor without beginning play, so that BeginPlay can be timed separately. */
+	AActor* SpawnDeferredButton(UWorld* World, const FTransform& Transform, UStaticMesh* MeshAsset)
+	{
+		AActor* Actor = World->SpawnActorDeferred<AActor>(AActor::StaticClass(), Transform);
+
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->SetWorldTransform(Transform);
+		Root->RegisterComponent();
+
+		UUxtPressableButtonComponent* Button = NewObject<UUxtPressableButtonComponent>(Actor);
+		Button->SetupAttachment(Root);
+		Button->RegisterComponent();
+
+		UStaticMeshComponent* Mesh = NewObject<UStaticMeshComponent>(Actor);
+		Mesh->SetupAttachment(Root);
+		Mesh->SetStaticMesh(MeshAsset);
+		Mesh->SetRelativeScale3D(FVector::OneVector * 0.05f);
+		Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+		Mesh->RegisterComponent();
+
+		// Computes the collider data like the editor does for placed buttons.
+		Button->SetVisuals(Mesh);
+
+		return Actor;
+	}
+
+	AActor* CreateBoundingBox(UWorld* World, const FVector& Location)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		UStaticMeshComponent* Root = UxtTestUtils::CreateBoxStaticMesh(Actor, FVector(0.05f));
+		Actor->SetRootComponent(Root);
+		Root->SetWorldLocation(Location);
+		Root->RegisterComponent();
+
+		// Instanced affordances use the default meshes, the mode has to be set before the component begins play on registration.
+		UUxtBoundingBoxManipulatorComponent* BoundingBox = NewObject<UUxtBoundingBoxManipulatorComponent>(Actor);
+		BoundingBox->SetAffordanceMode(EUxtBoundingBoxAffordanceMode::Instanced);
+		BoundingBox->RegisterComponent();
+
+		return Actor;
+	}
+
+	AActor* CreateFollow(UWorld* World, const FVector& Location)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->SetWorldLocation(Location);
+		Root->RegisterComponent();
+
+		// Follows the head, which moves along the scripted path
+		UUxtFollowComponent* Follow = NewObject<UUxtFollowComponent>(Actor);
+		Follow->RegisterComponent();
+
+		return Actor;
+	}
+}
+
+/**
+ * Measures game thread time, scene queries and the process used physical memory delta per frame for large numbers of interactive objects, driven by scripted hands.
+ * Each scenario is preceded by a baseline recording with only the hands, and fails if it costs more than its budget over that baseline.
+ * Results are written to Saved/Automation/UXTools/Benchmarks.
+ *
+ * Runs headless, e.g.:
+ *   UE4Editor UXToolsGame.uproject -nullrhi -unattended -ExecCmds="Automation RunTests UXTools.Benchmark; Quit"
+ * Object counts and budgets can be scaled with -UxtBenchmarkCountScale=<Scale> and -UxtBenchmarkBudgetScale=<Scale>.
+ */
+BEGIN_DEFINE_SPEC(BenchmarkSpec, "UXTools.Benchmark", EAutomationTestFlags::PerfFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	/** Record a baseline with only the hands, then spawn the scenario objects and record them. */
+	void EnqueueBenchmark(const FString& Scenario, TFunction<void(UWorld*)> Spawn, TFunction<void(int32)> Animate, double BudgetMs);
+
+	/** Spawn objects, let them settle and record frames, then call Recorded with the results in the recorder. */
+	void EnqueueRecording(const FString& Scenario, TFunction<void(UWorld*)> Spawn, TFunction<void(int32)> Animate, TFunction<void()> Recorded);
+
+	/** Move the hands along a deterministic path sweeping over the object grid. */
+	static void AnimateHands(int32 Frame);
+
+	FFrameQueue FrameQueue;
+	FUxtBenchmarkRecorder Recorder;
+	TArray<AActor*> Actors;
+
+	/** Average game thread time of the baseline of the current scenario, which only contains the hands. */
+	double BaselineMs = 0;
+
+	const int32 NumWarmupFrames = 30;
+	const int32 NumRecordedFrames = 300;
+
+	const int32 NumGrabTargets = 200;
+	const int32 NumButtons = 1000;
+	const int32 NumBoundingBoxes = 100;
+	const int32 NumFollowComponents = 500;
+
+END_DEFINE_SPEC(BenchmarkSpec)
+
+void BenchmarkSpec::Define()
+{
+	Describe("Interaction benchmark", [this]
+		{
+			LatentBeforeEach([this](const FDoneDelegate& Done)
+				{
+					UWorld* World = UxtTestUtils::LoadMap("/Game/UXToolsGame/Tests/Maps/TestEmpty");
+					TestNotNull("World", World);
+
+					UxtTestUtils::EnableTestHandTracker();
+					FrameQueue.Init(&World->GetTimerManager());
+
+					// Scripted hands drive all pointers
+					AUxtHandInteractionActor* LeftHand = World->SpawnActor<AUxtHandInteractionActor>();
+					LeftHand->SetHand(EControllerHand::Left);
+					AUxtHandInteractionActor* RightHand = World->SpawnActor<AUxtHandInteractionActor>();
+					RightHand->SetHand(EControllerHand::Right);
+					Actors.Add(LeftHand);
+					Actors.Add(RightHand);
+
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			AfterEach([this]
+				{
+					FrameQueue.Reset();
+					Actors.Empty();
+					UxtTestUtils::DisableTestHandTracker();
+					UxtTestUtils::ExitGame();
+				});
+
+			LatentIt("should grab and focus many grab targets within budget", [this](const FDoneDelegate& Done)
+				{
+					const int32 Count = GetScaledCount(NumGrabTargets);
+					EnqueueBenchmark(TEXT("GrabTargets"), [this, Count](UWorld* World)
+						{
+							for (int32 Index = 0; Index < Count; ++Index)
+							{
+								UTestGrabTarget* Target = UxtTestUtils::CreateNearPointerTarget(World, GetGridLocation(Index, 6), TEXT("/Engine/BasicShapes/Cube.Cube"), 0.04f);
+								Actors.Add(Target->GetOwner());
+							}
+							Recorder.SetParameter(TEXT("GrabTargets"), Count);
+						},
+						&BenchmarkSpec::AnimateHands, 2.0);
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			LatentIt("should poke many buttons within budget", [this](const FDoneDelegate& Done)
+				{
+					const int32 Count = GetScaledCount(NumButtons);
+					EnqueueBenchmark(TEXT("Buttons"), [this, Count](UWorld* World)
+						{
+							UStaticMesh* MeshAsset = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+							for (int32 Index = 0; Index < Count; ++Index)
+							{
+								Actors.Add(CreateButton(World, GetGridLocation(Index, 6), MeshAsset));
+							}
+							Recorder.SetParameter(TEXT("Buttons"), Count);
+						},
+						&BenchmarkSpec::AnimateHands, 2.0);
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			It("should begin play for many buttons", [this]
+				{
+					UWorld* World = UxtTestUtils::GetTestWorld();
+					UStaticMesh* MeshAsset = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+					const int32 Count = GetScaledCount(NumButtons);
+					TArray<AActor*> Buttons;
+					TArray<FTransform> Transforms;
+					for (int32 Index = 0; Index < Count; ++Index)
+					{
+						const FTransform Transform(GetGridLocation(Index, 6));
+						Buttons.Add(SpawnDeferredButton(World, Transform, MeshAsset));
+						Transforms.Add(Transform);
+					}
+
+					const double StartTime = FPlatformTime::Seconds();
+					for (int32 Index = 0; Index < Count; ++Index)
+					{
+						Buttons[Index]->FinishSpawning(Transforms[Index]);
+					}
+					const double Elapsed = FPlatformTime::Seconds() - StartTime;
+					AddInfo(FString::Printf(TEXT("BeginPlay of %d buttons: %.3f ms"), Count, Elapsed * 1000.0));
+
+					UUxtPressableButtonSubsystem* ButtonSet = World->GetSubsystem<UUxtPressableButtonSubsystem>();
+					TestEqual("Registered buttons", ButtonSet->GetNumButtons(), Count);
+
+					Actors.Append(Buttons);
+				});
+
+			LatentIt("should update many bounding boxes within budget", [this](const FDoneDelegate& Done)
+				{
+					const int32 Count = GetScaledCount(NumBoundingBoxes);
+					EnqueueBenchmark(TEXT("BoundingBoxes"), [this, Count](UWorld* World)
+						{
+							for (int32 Index = 0; Index < Count; ++Index)
+							{
+								Actors.Add(CreateBoundingBox(World, GetGridLocation(Index, 8)));
+							}
+							Recorder.SetParameter(TEXT("BoundingBoxes"), Count);
+						},
+						&BenchmarkSpec::AnimateHands, 2.0);
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			LatentIt("should update many follow components within budget", [this](const FDoneDelegate& Done)
+				{
+					const int32 Count = GetScaledCount(NumFollowComponents);
+					EnqueueBenchmark(TEXT("FollowComponents"), [this, Count](UWorld* World)
+						{
+							for (int32 Index = 0; Index < Count; ++Index)
+							{
+								Actors.Add(CreateFollow(World, GetGridLocation(Index, 4)));
+							}
+							Recorder.SetParameter(TEXT("FollowComponents"), Count);
+						},
+						[this](int32 Frame)
+						{
+							AnimateHands(Frame);
+
+							// Keep the followers moving by turning the player around
+							if (APlayerController* PlayerController = UGameplayStatics::GetPlayerController(UxtTestUtils::GetTestWorld(), 0))
+							{
+								PlayerController->SetControlRotation(FRotator(0, FMath::Sin(Frame * 0.05f) * 90.0f, 0));
+							}
+						},
+						2.0);
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+		});
+}
+
+void BenchmarkSpec::EnqueueBenchmark(const FString& Scenario, TFunction<void(UWorld*)> Spawn, TFunction<void(int32)> Animate, double BudgetMs)
+{
+	// Measured in the same test right before the scenario, so both run under the same conditions.
+	EnqueueRecording(Scenario + TEXT("Baseline"), [](UWorld*) {}, Animate, [this]
+		{
+			BaselineMs = Recorder.GetAverageGameThreadMs();
+		});
+
+	EnqueueRecording(Scenario, Spawn, Animate, [this, BudgetMs]
+		{
+			Recorder.CheckBudget(*this, BaselineMs, BudgetMs);
+		});
+}
+
+void BenchmarkSpec::EnqueueRecording(const FString& Scenario, TFunction<void(UWorld*)> Spawn, TFunction<void(int32)> Animate, TFunction<void()> Recorded)
+{
+	FrameQueue.Enqueue([Spawn]
+		{
+			Spawn(UxtTestUtils::GetTestWorld());
+		});
+
+	// Let spawned objects settle before recording
+	for (int32 Frame = 0; Frame < NumWarmupFrames; ++Frame)
+	{
+		FrameQueue.Enqueue([Animate, Frame] { Animate(Frame); });
+	}
+
+	// Each recorded frame measures the frame before it
+	for (int32 Frame = 0; Frame < NumRecordedFrames; ++Frame)
+	{
+		FrameQueue.Enqueue([this, Scenario, Animate, Frame]
+			{
+				if (Frame > 0)
+				{
+					Recorder.RecordFrame();
+				}
+				else
+				{
+					Recorder.Begin(Scenario);
+				}
+				Animate(NumWarmupFrames + Frame);
+			});
+	}
+
+	FrameQueue.Enqueue([this, Recorded]
+		{
+			Recorder.RecordFrame();
+			Recorder.End();
+
+			TestEqual("Recorded frames", Recorder.GetNumFrames(), NumRecordedFrames);
+			Recorded();
+		});
+}
+
+void BenchmarkSpec::AnimateHands(int32 Frame)
+{
+	// Lissajous path over the grid, the hand grabs for half a second every second at 60 frames per second.
+	FUxtTestHandTracker& HandTracker = UxtTestUtils::GetTestHandTracker();
+	HandTracker.TestPosition = FVector(95 + 10 * FMath::Sin(Frame * 0.021f), 60 * FMath::Sin(Frame * 0.037f), 60 * FMath::Sin(Frame * 0.029f));
+	HandTracker.bIsGrabbing = (Frame / 30) % 2 == 1;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,153 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#include "Controls/UxtBoundingBoxManipulatorComponent.h"
+#include "FrameQueue.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UUxtBoundingBoxManipulatorComponent* CreateTestComponent(UWorld* World, const FVector& Location, UStaticMeshComponent*& OutChildMesh)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		UStaticMeshComponent* Root = UxtTestUtils::CreateBoxStaticMesh(Actor);
+		Actor->SetRootComponent(Root);
+		Root->SetWorldLocation(Location);
+		Root->RegisterComponent();
+
+		OutChildMesh = UxtTestUtils::CreateBoxStaticMesh(Actor, FVector(0.5f));
+		OutChildMesh->SetupAttachment(Root);
+		OutChildMesh->RegisterComponent();
+
+		// No affordance classes are set, so no affordance actors are spawned.
+		UUxtBoundingBoxManipulatorComponent* BoundingBox = NewObject<UUxtBoundingBoxManipulatorComponent>(Actor);
+		BoundingBox->RegisterComponent();
+
+		return BoundingBox;
+	}
+}
+
+BEGIN_DEFINE_SPEC(BoundingBoxBoundsSpec, "UXTools.BoundingBox.Bounds", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	UUxtBoundingBoxManipulatorComponent* Target;
+	UStaticMeshComponent* ChildMesh;
+	FFrameQueue FrameQueue;
+
+END_DEFINE_SPEC(BoundingBoxBoundsSpec)
+
+void BoundingBoxBoundsSpec::Define()
+{
+	Describe("Bounding box bounds", [this]
+		{
+			BeforeEach([this]
+				{
+					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+					UWorld* World = UxtTestUtils::GetTestWorld();
+					FrameQueue.Init(World->GetGameInstance()->TimerManager);
+
+					Target = CreateTestComponent(World, FVector(150, 0, 0), ChildMesh);
+
+					// Register all new components.
+					World->UpdateWorldComponents(false, false);
+				});
+
+			AfterEach([this]
+				{
+					FrameQueue.Reset();
+					Target->GetOwner()->Destroy();
+					Target = nullptr;
+					ChildMesh = nullptr;
+
+					// Force GC so that destroyed actors are removed from the world.
+					// Running multiple tests will otherwise cause errors when creating duplicate actors.
+					GEngine->ForceGarbageCollection();
+				});
+
+			It("should compute the same bounds with and without caching", [this]
+				{
+					ChildMesh->SetRelativeLocation(FVector(0, 80, 0));
+
+					Target->SetKeepBoundsFitted(false);
+					Target->ComputeBoundsFromComponents();
+					const FBox UncachedBounds = Target->GetBounds();
+
+					Target->SetKeepBoundsFitted(true);
+					Target->ComputeBoundsFromComponents();
+					const FBox CachedBounds = Target->GetBounds();
+
+					TestEqual(TEXT("Bounds min"), CachedBounds.Min, UncachedBounds.Min);
+					TestEqual(TEXT("Bounds max"), CachedBounds.Max, UncachedBounds.Max);
+				});
+
+			LatentIt("should refit bounds when a component moves", [this](const FDoneDelegate& Done)
+				{
+					Target->SetKeepBoundsFitted(true);
+					const FBox InitialBounds = Target->GetBounds();
+
+					FrameQueue.Enqueue([this]
+						{
+							ChildMesh->SetRelativeLocation(FVector(0, 0, 100));
+						});
+
+					FrameQueue.Enqueue([this, Done, InitialBounds]
+						{
+							TestEqual(TEXT("Bounds min unchanged"), Target->GetBounds().Min, InitialBounds.Min);
+							TestTrue(TEXT("Bounds max extended"), Target->GetBounds().Max.Z > InitialBounds.Max.Z + 50.0f);
+
+							Done.Execute();
+						});
+				});
+
+			LatentIt("should not refit bounds when the actor moves", [this](const FDoneDelegate& Done)
+				{
+					Target->SetKeepBoundsFitted(true);
+					const FBox InitialBounds = Target->GetBounds();
+
+					FrameQueue.Enqueue([this]
+						{
+							Target->GetOwner()->SetActorLocationAndRotation(FVector(200, 50, 0), FRotator(0, 45, 0));
+						});
+
+					FrameQueue.Enqueue([this, Done, InitialBounds]
+						{
+							TestEqual(TEXT("Bounds min"), Target->GetBounds().Min, InitialBounds.Min);
+							TestEqual(TEXT("Bounds max"), Target->GetBounds().Max, InitialBounds.Max);
+
+							Done.Execute();
+						});
+				});
+
+			LatentIt("should refit bounds when a component is removed", [this](const FDoneDelegate& Done)
+				{
+					ChildMesh->SetRelativeLocation(FVector(0, 0, 100));
+					Target->SetKeepBoundsFitted(true);
+					const FBox InitialBounds = Target->GetBounds();
+
+					FrameQueue.Enqueue([this]
+						{
+							ChildMesh->DestroyComponent();
+						});
+
+					FrameQueue.Enqueue([this, Done, InitialBounds]
+						{
+							TestTrue(TEXT("Bounds max reduced"), Target->GetBounds().Max.Z < InitialBounds.Max.Z - 50.0f);
+
+							Done.Execute();
+						});
+				});
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
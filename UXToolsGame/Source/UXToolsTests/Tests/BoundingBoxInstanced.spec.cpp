@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "GameFramework/Actor.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#include "Controls/UxtBoundingBoxManipulatorComponent.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UUxtBoundingBoxManipulatorComponent* CreateTestComponent(UWorld* World, const FVector& Location, EUxtBoundingBoxAffordanceMode Mode)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		UStaticMeshComponent* Root = UxtTestUtils::CreateBoxStaticMesh(Actor);
+		Actor->SetRootComponent(Root);
+		Root->SetWorldLocation(Location);
+		Root->RegisterComponent();
+
+		// The mode has to be set before the component begins play on registration.
+		UUxtBoundingBoxManipulatorComponent* BoundingBox = NewObject<UUxtBoundingBoxManipulatorComponent>(Actor);
+		BoundingBox->SetAffordanceMode(Mode);
+		BoundingBox->RegisterComponent();
+
+		return BoundingBox;
+	}
+
+	int32 GetNumInstances(const UUxtBoundingBoxManipulatorComponent* BoundingBox)
+	{
+		int32 NumInstances = 0;
+		for (const UInstancedStaticMeshComponent* Instancer : BoundingBox->GetAffordanceInstancers())
+		{
+			NumInstances += Instancer->GetInstanceCount();
+		}
+		return NumInstances;
+	}
+}
+
+BEGIN_DEFINE_SPEC(BoundingBoxInstancedSpec, "UXTools.BoundingBox.Instanced", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	UUxtBoundingBoxManipulatorComponent* Target;
+
+	void TestAffordanceMapping();
+
+END_DEFINE_SPEC(BoundingBoxInstancedSpec)
+
+void BoundingBoxInstancedSpec::Define()
+{
+	Describe("Instanced affordances", [this]
+		{
+			BeforeEach([this]
+				{
+					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+					UWorld* World = UxtTestUtils::GetTestWorld();
+					Target = CreateTestComponent(World, FVector(150, 0, 0), EUxtBoundingBoxAffordanceMode::Instanced);
+
+					// Register all new components.
+					World->UpdateWorldComponents(false, false);
+				});
+
+			AfterEach([this]
+				{
+					Target->GetOwner()->Destroy();
+					Target = nullptr;
+
+					// Force GC so that destroyed actors are removed from the world.
+					// Running multiple tests will otherwise cause errors when creating duplicate actors.
+					GEngine->ForceGarbageCollection();
+				});
+
+			It("should have default meshes for all affordance kinds", [this]
+				{
+					TestNotNull(TEXT("Center mesh"), Target->GetAffordanceKindMesh(EUxtBoundingBoxAffordanceKind::Center));
+					TestNotNull(TEXT("Face mesh"), Target->GetAffordanceKindMesh(EUxtBoundingBoxAffordanceKind::Face));
+					TestNotNull(TEXT("Edge mesh"), Target->GetAffordanceKindMesh(EUxtBoundingBoxAffordanceKind::Edge));
+					TestNotNull(TEXT("Corner mesh"), Target->GetAffordanceKindMesh(EUxtBoundingBoxAffordanceKind::Corner));
+				});
+
+			It("should create one instance per affordance and one instancer per mesh", [this]
+				{
+					TSet<UStaticMesh*> Meshes;
+					for (const FUxtBoundingBoxAffordanceInfo& Affordance : Target->GetUsedAffordances())
+					{
+						Meshes.Add(Target->GetAffordanceKindMesh(Affordance.Kind));
+					}
+
+					TestEqual(TEXT("Number of instancers"), Target->GetAffordanceInstancers().Num(), Meshes.Num());
+					TestEqual(TEXT("Number of instances"), GetNumInstances(Target), Target->GetUsedAffordances().Num());
+				});
+
+			It("should map affordance locations to their affordance", [this]
+				{
+					TestAffordanceMapping();
+				});
+
+			It("should map affordance locations after the actor moved", [this]
+				{
+					Target->GetOwner()->SetActorLocationAndRotation(FVector(200, 50, 30), FRotator(0, 45, 0));
+
+					TestAffordanceMapping();
+				});
+		});
+
+	Describe("Actor affordances", [this]
+		{
+			BeforeEach([this]
+				{
+					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+					UWorld* World = UxtTestUtils::GetTestWorld();
+					Target = CreateTestComponent(World, FVector(150, 0, 0), EUxtBoundingBoxAffordanceMode::Actors);
+					World->UpdateWorldComponents(false, false);
+				});
+
+			AfterEach([this]
+				{
+					Target->GetOwner()->Destroy();
+					Target = nullptr;
+					GEngine->ForceGarbageCollection();
+				});
+
+			It("should not create instances", [this]
+				{
+					TestEqual(TEXT("Number of instancers"), Target->GetAffordanceInstancers().Num(), 0);
+					TestNull(TEXT("Affordance at the center"), Target->FindInstancedAffordance(Target->GetOwner()->GetActorLocation()));
+				});
+		});
+}
+
+void BoundingBoxInstancedSpec::TestAffordanceMapping()
+{
+	const FTransform& ActorTransform = Target->GetOwner()->GetActorTransform();
+	for (const FUxtBoundingBoxAffordanceInfo& Affordance : Target->GetUsedAffordances())
+	{
+		const FVector Location = Affordance.GetWorldTransform(Target->GetBounds(), ActorTransform).GetLocation();
+		const FUxtBoundingBoxAffordanceInfo* Found = Target->FindInstancedAffordance(Location);
+		if (!TestTrue(FString::Printf(TEXT("Affordance at %s"), *Affordance.BoundsLocation.ToString()), Found == &Affordance))
+		{
+			return;
+		}
+	}
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -25,6 +25,7 @@ BEGIN_DEFINE_SPEC(FFarPointerSpec, "UXTools.FarPointer", EAutomationTestFlags::E
 	UUxtFarPointerComponent* Pointer;
 	UFarPointerListener* PointerListener;
 	UFarTargetTestComponent* FarTarget;
+	UUxtFarBeamComponent* Beam;
 	FFrameQueue FrameQueue;
 	UPrimitiveComponent* HitPrimitive = nullptr;
 	FVector TargetLocation = FVector(200, 0, 0);
@@ -66,7 +67,7 @@ void FFarPointerSpec::Define()
 			Pointer->OnFarPointerDisabled.AddDynamic(PointerListener, &UFarPointerListener::OnFarPointerDisabled);
 
 			// Beam
-			UUxtFarBeamComponent* Beam = NewObject<UUxtFarBeamComponent>(PointerActor);
+			Beam = NewObject<UUxtFarBeamComponent>(PointerActor);
 			Beam->AttachToComponent(Root, FAttachmentTransformRules::KeepRelativeTransform);
 			Beam->RegisterComponent();
 			
@@ -231,6 +232,44 @@ void FFarPointerSpec::Define()
 		});
 	});
 
+	LatentIt("should keep the curved beam straight while unlocked", [this](const FDoneDelegate& Done)
+	{
+		Beam->bCurved = true;
+
+		// Hit the target at an angle, so that the beam end over the surface is off the pointer ray
+		HandTracker->TestOrientation = FQuat(FRotator(0, 10, 0));
+
+		FrameQueue.Enqueue([this, Done]()
+		{
+			TestFalse("FocusLocked", Pointer->GetFocusLocked());
+			TestEqual("Hit Primitive", Pointer->GetHitPrimitive(), HitPrimitive);
+			TestTrue("Curve offset is zero", Beam->GetCurveOffset().IsZero());
+			Done.Execute();
+		});
+	});
+
+	LatentIt("should curve the beam towards the locked hit point", [this](const FDoneDelegate& Done)
+	{
+		Beam->bCurved = true;
+		Pointer->SetFocusLocked(true);
+		FarTarget->GetOwner()->SetActorLocation(TargetLocation + FVector(0, 100, 0));
+
+		FrameQueue.Enqueue([this]()
+		{
+			TestTrue("FocusLocked", Pointer->GetFocusLocked());
+			TestFalse("Curve offset is zero", Beam->GetCurveOffset().IsZero());
+
+			Pointer->SetFocusLocked(false);
+			FarTarget->GetOwner()->SetActorLocation(TargetLocation);
+		});
+
+		FrameQueue.Enqueue([this, Done]()
+		{
+			TestTrue("Curve offset is zero after unlocking", Beam->GetCurveOffset().IsZero());
+			Done.Execute();
+		});
+	});
+
 	LatentIt("should release lock on tracking loss", [this](const FDoneDelegate& Done)
 	{
 		Pointer->SetFocusLocked(true);
@@ -0,0 +1,120 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine/World.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "TimerManager.h"
+
+#include "Input/UxtNearPointerComponent.h"
+#include "PointerTestSequence.h"
+#include "UxtFixedStepWorld.h"
+#include "UxtTestHandTracker.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FixedStepWorldSpec, "UXTools.FixedStepWorld", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	FUxtFixedStepWorld StepWorld;
+
+END_DEFINE_SPEC(FixedStepWorldSpec)
+
+void FixedStepWorldSpec::Define()
+{
+	Describe("Fixed step world", [this]
+		{
+			AfterEach([this]
+				{
+					StepWorld.Destroy();
+				});
+
+			It("should advance time by the fixed step", [this]
+				{
+					UWorld* World = StepWorld.Create(1.0f / 90.0f);
+					TestTrue("World has begun play", World->HasBegunPlay());
+
+					StepWorld.Step(90);
+					TestEqual("Frame count", StepWorld.GetFrameCount(), (int64)90);
+					TestEqual("World time", World->GetTimeSeconds(), 1.0f, 1.0e-3f);
+				});
+
+			It("should run timers", [this]
+				{
+					UWorld* World = StepWorld.Create(1.0f / 60.0f);
+
+					bool bTimerFired = false;
+					FTimerHandle Handle;
+					World->GetTimerManager().SetTimer(Handle, [&bTimerFired] { bTimerFired = true; }, 0.5f, false);
+
+					StepWorld.Step(25);
+					TestFalse("Timer fired before delay", bTimerFired);
+
+					TestTrue("Timer fired after delay", StepWorld.StepUntil([&bTimerFired] { return bTimerFired; }, 10));
+				});
+
+			It("should step pointer interactions", [this]
+				{
+					UWorld* World = StepWorld.Create(1.0f / 60.0f);
+
+					UUxtNearPointerComponent* Pointer = UxtTestUtils::CreateNearPointer(World, TEXT("TestPointer"), FVector::ZeroVector);
+					UTestGrabTarget* Target = UxtTestUtils::CreateNearPointerTarget(World, FVector(120, -20, -5), TEXT("/Engine/BasicShapes/Cube.Cube"), 0.3f);
+
+					const int32 NumFrames = 1000;
+					const double StartTime = FPlatformTime::Seconds();
+					for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+					{
+						// Move the pointer in and out of the target
+						StepWorld.GetHandTracker().TestPosition = FMath::Lerp(FVector(40, -50, 30), FVector(120, -20, -5), (Frame % 60) / 59.0f);
+						StepWorld.Step();
+					}
+					const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+					AddInfo(FString::Printf(TEXT("Stepped %d frames in %.1f ms, %.1f frames per ms"), NumFrames, WallSeconds * 1000.0, NumFrames / FMath::Max(WallSeconds * 1000.0, 1.0e-3)));
+					TestTrue("Target was focused", Target->BeginFocusCount > 0);
+
+					Pointer->GetOwner()->Destroy();
+					Target->GetOwner()->Destroy();
+				});
+
+			It("should isolate hand trackers of interleaved worlds", [this]
+				{
+					const FVector TargetLocation(120, -20, -5);
+					const FVector OutsideLocation(40, -50, 30);
+
+					// Both worlds contain the same scene, only the hand in the first world touches the target.
+					FUxtFixedStepWorld OtherStepWorld;
+					UTestGrabTarget* Targets[2];
+					UUxtNearPointerComponent* Pointers[2];
+					FUxtFixedStepWorld* StepWorlds[2] = { &StepWorld, &OtherStepWorld };
+					for (int32 Index = 0; Index < 2; ++Index)
+					{
+						UWorld* World = StepWorlds[Index]->Create();
+						Pointers[Index] = UxtTestUtils::CreateNearPointer(World, TEXT("TestPointer"), FVector::ZeroVector);
+						Targets[Index] = UxtTestUtils::CreateNearPointerTarget(World, TargetLocation, TEXT("/Engine/BasicShapes/Cube.Cube"), 0.3f);
+					}
+
+					StepWorld.GetHandTracker().TestPosition = TargetLocation;
+					OtherStepWorld.GetHandTracker().TestPosition = OutsideLocation;
+
+					for (int32 Frame = 0; Frame < 3; ++Frame)
+					{
+						StepWorld.Step();
+						OtherStepWorld.Step();
+					}
+
+					TestEqual("Focus count in first world", Targets[0]->BeginFocusCount, 1);
+					TestEqual("Focus count in second world", Targets[1]->BeginFocusCount, 0);
+
+					for (int32 Index = 0; Index < 2; ++Index)
+					{
+						Pointers[Index]->GetOwner()->Destroy();
+						Targets[Index]->GetOwner()->Destroy();
+					}
+					OtherStepWorld.Destroy();
+				});
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
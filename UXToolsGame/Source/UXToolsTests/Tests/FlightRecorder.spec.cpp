@@ -0,0 +1,265 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include "Utils/UxtFlightRecorder.h"
+
+#if WITH_UXTOOLS_EDITOR
+#include "UxtFlightAnalyzerCommandlet.h"
+#endif
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	FUxtFlightEvent MakeEvent(uint64 Cycles, EUxtFlightEventType Type, EUxtFlightInteraction Interaction, uint32 PointerId, uint32 TargetId,
+		const FVector& Location = FVector::ZeroVector)
+	{
+		FUxtFlightEvent Event;
+		Event.Cycles = Cycles;
+		Event.Frame = static_cast<uint32>(Cycles);
+		Event.Type = Type;
+		Event.Interaction = Interaction;
+		Event.PointerId = PointerId;
+		Event.TargetId = TargetId;
+		Event.Location = Location;
+		return Event;
+	}
+
+	/** Dump with one cycle per millisecond, so event cycles are timestamps in milliseconds. */
+	FUxtFlightDump MakeDump(const TArray<FUxtFlightEvent>& Events)
+	{
+		FUxtFlightDump Dump;
+		Dump.SecondsPerCycle = 0.001;
+		Dump.NumRecorded = Events.Num();
+		Dump.Events = Events;
+		return Dump;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FlightRecorderSpec, "UXTools.FlightRecorder", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+END_DEFINE_SPEC(FlightRecorderSpec)
+
+void FlightRecorderSpec::Define()
+{
+	Describe("Recorder", [this]
+		{
+			It("should round the capacity up to a power of two", [this]
+				{
+					FUxtFlightRecorder Recorder(5);
+					TestTrue("Capacity", Recorder.GetCapacity() == 8);
+				});
+
+			It("should keep all events before the buffer is full", [this]
+				{
+					FUxtFlightRecorder Recorder(4);
+					for (int32 Index = 0; Index < 3; ++Index)
+					{
+						Recorder.Record(EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Poke, nullptr, nullptr, FVector(Index, 0, 0));
+					}
+
+					FUxtFlightDump Dump;
+					Recorder.Snapshot(Dump, false);
+					TestTrue("Recorded events", Dump.NumRecorded == 3);
+					if (TestEqual("Events in the snapshot", Dump.Events.Num(), 3))
+					{
+						for (int32 Index = 0; Index < 3; ++Index)
+						{
+							TestEqual(*FString::Printf(TEXT("Event %d"), Index), Dump.Events[Index].Location.X, (float)Index);
+						}
+					}
+				});
+
+			It("should keep the latest events in order after wrapping around", [this]
+				{
+					FUxtFlightRecorder Recorder(4);
+					for (int32 Index = 0; Index < 10; ++Index)
+					{
+						Recorder.Record(EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Poke, nullptr, nullptr, FVector(Index, 0, 0));
+					}
+
+					FUxtFlightDump Dump;
+					Recorder.Snapshot(Dump, false);
+					TestTrue("Recorded events", Dump.NumRecorded == 10);
+					if (TestEqual("Events in the snapshot", Dump.Events.Num(), 4))
+					{
+						for (int32 Index = 0; Index < 4; ++Index)
+						{
+							TestEqual(*FString::Printf(TEXT("Event %d"), Index), Dump.Events[Index].Location.X, (float)(6 + Index));
+						}
+					}
+				});
+		});
+
+	Describe("Dump", [this]
+		{
+			It("should load the events and names it saved", [this]
+				{
+					FUxtFlightDump Dump = MakeDump({
+						MakeEvent(100, EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Far, 1, 0, FVector(1, 2, 3)),
+						MakeEvent(110, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Far, 1, 2),
+						MakeEvent(120, EUxtFlightEventType::ButtonPressed, EUxtFlightInteraction::None, 0, 2) });
+					Dump.NumRecorded = 42;
+					Dump.Names.Add(1, TEXT("Pointer"));
+					Dump.Names.Add(2, TEXT("Button"));
+
+					const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FlightRecorderTest.uxtflight"));
+					TestTrue("Saved", Dump.Save(Filename));
+
+					FUxtFlightDump Loaded;
+					TestTrue("Loaded", Loaded.Load(Filename));
+					IFileManager::Get().Delete(*Filename);
+
+					TestTrue("Seconds per cycle", Loaded.SecondsPerCycle == Dump.SecondsPerCycle);
+					TestTrue("Recorded events", Loaded.NumRecorded == Dump.NumRecorded);
+					if (TestEqual("Events", Loaded.Events.Num(), Dump.Events.Num()))
+					{
+						for (int32 Index = 0; Index < Dump.Events.Num(); ++Index)
+						{
+							const FUxtFlightEvent& Expected = Dump.Events[Index];
+							const FUxtFlightEvent& Actual = Loaded.Events[Index];
+							const FString What = FString::Printf(TEXT("Event %d"), Index);
+							TestTrue(*(What + TEXT(" cycles")), Actual.Cycles == Expected.Cycles);
+							TestTrue(*(What + TEXT(" frame")), Actual.Frame == Expected.Frame);
+							TestTrue(*(What + TEXT(" pointer")), Actual.PointerId == Expected.PointerId);
+							TestTrue(*(What + TEXT(" target")), Actual.TargetId == Expected.TargetId);
+							TestTrue(*(What + TEXT(" type")), Actual.Type == Expected.Type);
+							TestTrue(*(What + TEXT(" interaction")), Actual.Interaction == Expected.Interaction);
+							TestEqual(*(What + TEXT(" location")), Actual.Location, Expected.Location);
+						}
+					}
+					TestTrue("Pointer name", Loaded.GetName(1) == TEXT("Pointer"));
+					TestTrue("Unknown name", Loaded.GetName(3) == TEXT("#3"));
+				});
+
+			It("should write a raw dump that loads like a snapshot", [this]
+				{
+					FUxtFlightRecorder Recorder(4);
+					for (int32 Index = 0; Index < 6; ++Index)
+					{
+						Recorder.Record(EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Grab, nullptr, nullptr, FVector(Index, 1, 2));
+					}
+
+					TArray<uint8> Buffer;
+					Buffer.SetNumUninitialized(Recorder.GetRawDumpSize());
+					TestFalse("Dumped to a small buffer", Recorder.DumpRaw(TEXT("Unused.uxtflight"), Buffer.GetData(), Buffer.Num() - 1));
+
+					const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FlightRecorderRaw.uxtflight"));
+					IFileManager::Get().MakeDirectory(*FPaths::GetPath(Filename), true);
+					TestTrue("Dumped", Recorder.DumpRaw(*Filename, Buffer.GetData(), Buffer.Num()));
+
+					FUxtFlightDump Loaded;
+					TestTrue("Loaded", Loaded.Load(Filename));
+					IFileManager::Get().Delete(*Filename);
+
+					FUxtFlightDump Expected;
+					Recorder.Snapshot(Expected, false);
+					TestTrue("Seconds per cycle", Loaded.SecondsPerCycle == Expected.SecondsPerCycle);
+					TestTrue("Recorded events", Loaded.NumRecorded == Expected.NumRecorded);
+					TestEqual("Names", Loaded.Names.Num(), 0);
+					if (TestEqual("Events", Loaded.Events.Num(), Expected.Events.Num()))
+					{
+						for (int32 Index = 0; Index < Expected.Events.Num(); ++Index)
+						{
+							const FString What = FString::Printf(TEXT("Event %d"), Index);
+							TestTrue(*(What + TEXT(" cycles")), Loaded.Events[Index].Cycles == Expected.Events[Index].Cycles);
+							TestTrue(*(What + TEXT(" interaction")), Loaded.Events[Index].Interaction == Expected.Events[Index].Interaction);
+							TestEqual(*(What + TEXT(" location")), Loaded.Events[Index].Location, Expected.Events[Index].Location);
+						}
+					}
+				});
+
+			It("should not load a file that is not a dump", [this]
+				{
+					const FString Filename = FPaths::Combine(FPaths::AutomationTransientDir(), TEXT("FlightRecorderInvalid.uxtflight"));
+					FFileHelper::SaveStringToFile(TEXT("Not a dump"), *Filename);
+
+					FUxtFlightDump Loaded;
+					TestFalse("Loaded", Loaded.Load(Filename));
+					IFileManager::Get().Delete(*Filename);
+				});
+		});
+
+#if WITH_UXTOOLS_EDITOR
+	Describe("Analyzer", [this]
+		{
+			It("should measure latency from motion onset to the events a pointer causes", [this]
+				{
+					const FUxtFlightDump Dump = MakeDump({
+						// Pointer 1 is still, then starts moving after the sample at 110 ms.
+						MakeEvent(100, EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Poke, 1, 0, FVector(0, 0, 0)),
+						MakeEvent(110, EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Poke, 1, 0, FVector(0, 0, 0)),
+						MakeEvent(120, EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Poke, 1, 0, FVector(10, 0, 0)),
+						MakeEvent(150, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Poke, 1, 5),
+						MakeEvent(160, EUxtFlightEventType::PokeBegin, EUxtFlightInteraction::Poke, 1, 6),
+						// Button presses are attributed to the pointer that last poked the button.
+						MakeEvent(170, EUxtFlightEventType::ButtonPressed, EUxtFlightInteraction::None, 0, 6),
+						// Pointer 2 has no samples, so its events have no latency.
+						MakeEvent(180, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Far, 2, 7),
+						// End events are not caused by motion.
+						MakeEvent(190, EUxtFlightEventType::PokeEnd, EUxtFlightInteraction::Poke, 1, 6) });
+
+					const TMap<FString, TArray<double>> Latencies = UUxtFlightAnalyzerCommandlet::ComputeLatencies(Dump, 10.0f);
+					TestEqual("Event kinds with latency", Latencies.Num(), 3);
+
+					const TArray<double>* Focus = Latencies.Find(TEXT("FocusEnter Poke"));
+					if (TestTrue("Focus latency", Focus && Focus->Num() == 1))
+					{
+						TestTrue("Focus latency", FMath::IsNearlyEqual((*Focus)[0], 40.0, 1.0e-6));
+					}
+					const TArray<double>* Poke = Latencies.Find(TEXT("PokeBegin Poke"));
+					if (TestTrue("Poke latency", Poke && Poke->Num() == 1))
+					{
+						TestTrue("Poke latency", FMath::IsNearlyEqual((*Poke)[0], 50.0, 1.0e-6));
+					}
+					const TArray<double>* Button = Latencies.Find(TEXT("ButtonPressed -"));
+					if (TestTrue("Button latency", Button && Button->Num() == 1))
+					{
+						TestTrue("Button latency", FMath::IsNearlyEqual((*Button)[0], 60.0, 1.0e-6));
+					}
+				});
+
+			It("should not start motion below the threshold", [this]
+				{
+					const FUxtFlightDump Dump = MakeDump({
+						MakeEvent(100, EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Grab, 1, 0, FVector(0, 0, 0)),
+						MakeEvent(200, EUxtFlightEventType::PointerSample, EUxtFlightInteraction::Grab, 1, 0, FVector(0.5f, 0, 0)),
+						MakeEvent(250, EUxtFlightEventType::GrabBegin, EUxtFlightInteraction::Grab, 1, 5) });
+
+					// 0.5 cm in 100 ms is 5 cm/s
+					TestEqual("Event kinds with latency", UUxtFlightAnalyzerCommandlet::ComputeLatencies(Dump, 10.0f).Num(), 0);
+				});
+
+			It("should count short focus intervals per target", [this]
+				{
+					const FUxtFlightDump Dump = MakeDump({
+						// Pointer 1 grab focus: 50 ms flicker, then 300 ms of stable focus.
+						MakeEvent(100, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Grab, 1, 5),
+						MakeEvent(150, EUxtFlightEventType::FocusExit, EUxtFlightInteraction::Grab, 1, 5),
+						MakeEvent(200, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Grab, 1, 5),
+						MakeEvent(500, EUxtFlightEventType::FocusExit, EUxtFlightInteraction::Grab, 1, 5),
+						// Pointer 2 far focus: 20 ms flicker.
+						MakeEvent(100, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Far, 2, 7),
+						MakeEvent(120, EUxtFlightEventType::FocusExit, EUxtFlightInteraction::Far, 2, 7),
+						// Pointer 1 poke focus is separate from its grab focus, and exits a different target.
+						MakeEvent(100, EUxtFlightEventType::FocusEnter, EUxtFlightInteraction::Poke, 1, 6),
+						MakeEvent(110, EUxtFlightEventType::FocusExit, EUxtFlightInteraction::Poke, 1, 8) });
+
+					int32 NumFocusIntervals = 0;
+					const TMap<uint32, int32> Flickers = UUxtFlightAnalyzerCommandlet::ComputeFocusFlicker(Dump, 100.0f, NumFocusIntervals);
+
+					TestEqual("Focus intervals", NumFocusIntervals, 3);
+					TestEqual("Targets with flicker", Flickers.Num(), 2);
+					TestEqual("Flickers of target 5", Flickers.FindRef(5), 1);
+					TestEqual("Flickers of target 7", Flickers.FindRef(7), 1);
+				});
+		});
+#endif // WITH_UXTOOLS_EDITOR
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
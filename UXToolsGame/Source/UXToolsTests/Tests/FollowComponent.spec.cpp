@@ -9,6 +9,7 @@
 #include "Tests/AutomationCommon.h"
 
 #include "Behaviors/UxtFollowComponent.h"
+#include "Behaviors/UxtFollowSubsystem.h"
 #include "Utils/UxtFunctionLibrary.h"
 #include "FrameQueue.h"
 #include "UxtTestUtils.h"
@@ -84,8 +85,11 @@ BEGIN_DEFINE_SPEC(FollowComponentSpec, "UXTools.FollowComponent", EAutomationTes
 	void EnqueueDistanceTest();
 	void EnqueueAngleTest();
 	void EnqueueOrientationTest();
+	void EnqueueBatchTest();
+	void EnqueueRestTest();
 
 	UUxtFollowComponent* Follow;
+	TArray<UUxtFollowComponent*> BatchFollows;
 	FFrameQueue FrameQueue;
 
 END_DEFINE_SPEC(FollowComponentSpec)
@@ -114,6 +118,12 @@ void FollowComponentSpec::Define()
 					Follow->GetOwner()->Destroy();
 					Follow = nullptr;
 
+					for (UUxtFollowComponent* BatchFollow : BatchFollows)
+					{
+						BatchFollow->GetOwner()->Destroy();
+					}
+					BatchFollows.Empty();
+
 					// Force GC so that destroyed actors are removed from the world.
 					// Running multiple tests will otherwise cause errors when creating duplicate actors.
 					GEngine->ForceGarbageCollection();
@@ -164,6 +174,47 @@ void FollowComponentSpec::Define()
 					EnqueueOrientationTest();
 					FrameQueue.Enqueue([Done] { Done.Execute(); });
 				});
+
+			LatentIt("updates components following the same actor in one batch", [this](const FDoneDelegate& Done)
+				{
+					EnqueueBatchTest();
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			LatentIt("comes to rest while the reference is still", [this](const FDoneDelegate& Done)
+				{
+					EnqueueRestTest();
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			LatentIt("does not move while tick is disabled", [this](const FDoneDelegate& Done)
+				{
+					Follow->SetComponentTickEnabled(false);
+
+					// Move the target far away
+					FrameQueue.Enqueue([this]
+						{
+							Follow->ActorToFollow->SetActorLocation(Follow->ActorToFollow->GetActorLocation() + FVector::BackwardVector * 1000);
+						});
+					FrameQueue.Skip();
+
+					FrameQueue.Enqueue([this]
+						{
+							TestTrue("Tick disabled", !Follow->IsComponentTickEnabled());
+							const float Distance = FVector::Distance(Follow->GetOwner()->GetActorLocation(), Follow->ActorToFollow->GetActorLocation());
+							TestTrue("Follow component did not move", Distance > Follow->MaximumDistance + 0.1f);
+
+							Follow->SetComponentTickEnabled(true);
+						});
+					FrameQueue.Skip();
+
+					FrameQueue.Enqueue([this]
+						{
+							const float Distance = FVector::Distance(Follow->GetOwner()->GetActorLocation(), Follow->ActorToFollow->GetActorLocation());
+							TestTrue("Follow component moved after tick was enabled", Distance <= Follow->MaximumDistance + 0.1f);
+						});
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
 		});
 }
 
@@ -348,4 +399,82 @@ void FollowComponentSpec::EnqueueOrientationTest()
 		});
 }
 
+void FollowComponentSpec::EnqueueBatchTest()
+{
+	// Enough components to run the solver in parallel
+	const int NumBatchFollows = 32;
+
+	FrameQueue.Enqueue([this, NumBatchFollows]
+		{
+			UWorld* World = UxtTestUtils::GetTestWorld();
+			for (int i = 0; i < NumBatchFollows; ++i)
+			{
+				UUxtFollowComponent* BatchFollow = CreateTestComponent(World, FVector(50, (i - NumBatchFollows / 2) * 10, 0));
+				BatchFollow->MoveToDefaultDistanceLerpTime = 0;
+				BatchFollow->bInterpolatePose = false;
+
+				// Share the reference of the main component
+				BatchFollow->ActorToFollow->Destroy();
+				BatchFollow->ActorToFollow = Follow->ActorToFollow;
+				BatchFollows.Add(BatchFollow);
+			}
+		});
+	FrameQueue.Skip();
+
+	// Move the target far away
+	FrameQueue.Enqueue([this]
+		{
+			Follow->ActorToFollow->SetActorLocation(Follow->ActorToFollow->GetActorLocation() + FVector::BackwardVector * 1000);
+		});
+
+	// Check all components share the reference and stay within distance limits
+	FrameQueue.Enqueue([this, NumBatchFollows]
+		{
+			UUxtFollowSubsystem* FollowSubsystem = UxtTestUtils::GetTestWorld()->GetSubsystem<UUxtFollowSubsystem>();
+			TestEqual("Follow components", FollowSubsystem->GetNumFollowComponents(), NumBatchFollows + 1);
+			TestEqual("References", FollowSubsystem->GetNumReferences(), 1);
+
+			const FVector TargetLocation = Follow->ActorToFollow->GetActorLocation();
+			for (const UUxtFollowComponent* BatchFollow : BatchFollows)
+			{
+				const float Distance = FVector::Distance(BatchFollow->GetOwner()->GetActorLocation(), TargetLocation);
+				TestTrue("Follow component does not exceed maximum bounds", Distance <= BatchFollow->MaximumDistance + 0.1f);
+			}
+		});
+}
+
+void FollowComponentSpec::EnqueueRestTest()
+{
+	// Let the component settle
+	FrameQueue.Skip();
+	FrameQueue.Skip();
+	FrameQueue.Skip();
+
+	// Check it is at rest and move the target sideways past the angle limits
+	FrameQueue.Enqueue([this]
+		{
+			TestTrue("Follow component is at rest", Follow->IsAtRest());
+
+			Follow->ActorToFollow->SetActorLocation(Follow->ActorToFollow->GetActorLocation() + FVector::RightVector * 100);
+		});
+
+	// Check it woke up and followed
+	FrameQueue.Enqueue([this]
+		{
+			TestFalse("Follow component is at rest", Follow->IsAtRest());
+		});
+	FrameQueue.Skip();
+	FrameQueue.Skip();
+
+	// Check it is at rest again and does not move
+	FrameQueue.Enqueue([this]
+		{
+			TestTrue("Follow component is at rest", Follow->IsAtRest());
+
+			const FVector TargetLocation = Follow->ActorToFollow->GetActorLocation();
+			const FVector FollowLocation = Follow->GetOwner()->GetActorLocation();
+			TestTrue("Follow component followed the target", FVector::Distance(TargetLocation, FollowLocation) <= Follow->MaximumDistance + 0.1f);
+		});
+}
+
 #endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#include "GenericManipulatorTestComponent.h"
+#include "Input/UxtNearPointerComponent.h"
+#include "Interactions/UxtGrabTarget.h"
+#include "UxtTestHandTracker.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const float DeltaSeconds = 1.0f / 60.0f;
+	const int NumBenchmarkIterations = 10000;
+
+	UGenericManipulatorTestComponent* CreateTestComponent(UWorld* World, const FVector& Location)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		USceneComponent* Root = NewObject<USceneComponent>(Actor);
+		Actor->SetRootComponent(Root);
+		Root->SetWorldLocation(Location);
+		Root->RegisterComponent();
+
+		UGenericManipulatorTestComponent* Manipulator = NewObject<UGenericManipulatorTestComponent>(Actor);
+		Manipulator->SetupAttachment(Root);
+		Manipulator->RegisterComponent();
+
+		return Manipulator;
+	}
+
+	/** Update the cached pointer transform by ticking the pointer with the given hand pose. */
+	void MovePointer(UUxtNearPointerComponent* Pointer, const FVector& Location, const FQuat& Orientation)
+	{
+		FUxtTestHandTracker& HandTracker = UxtTestUtils::GetTestHandTracker();
+		HandTracker.TestPosition = Location;
+		HandTracker.TestOrientation = Orientation;
+		Pointer->TickComponent(DeltaSeconds, ELevelTick::LEVELTICK_All, nullptr);
+	}
+
+	/** Average time in microseconds of the given update function. */
+	template <typename Func>
+	double MeasureMicroseconds(Func Update)
+	{
+		FTransform Result;
+		const double StartTime = FPlatformTime::Seconds();
+		for (int i = 0; i < NumBenchmarkIterations; ++i)
+		{
+			Update(Result);
+		}
+		return (FPlatformTime::Seconds() - StartTime) * 1.0e6 / NumBenchmarkIterations;
+	}
+}
+
+BEGIN_DEFINE_SPEC(GenericManipulatorPipelineSpec, "UXTools.GenericManipulator.Pipeline", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	/** Compare specialized and unspecialized results for the current settings and log their cost. */
+	void CompareAndBenchmark(const FString& Description)
+	{
+		FTransform Unspecialized, Specialized;
+		const bool bUnspecializedValid = Target->ComputeUnspecialized(DeltaSeconds, Unspecialized);
+		const bool bSpecializedValid = Target->ComputeSpecialized(DeltaSeconds, Specialized);
+
+		TestEqual(FString::Printf(TEXT("%s: valid"), *Description), bSpecializedValid, bUnspecializedValid);
+		if (bSpecializedValid && bUnspecializedValid)
+		{
+			TestTrue(FString::Printf(TEXT("%s: transform"), *Description), Specialized.Equals(Unspecialized, 1.0e-3f));
+		}
+
+		const double UnspecializedTime = MeasureMicroseconds([this](FTransform& Result) { Target->ComputeUnspecialized(DeltaSeconds, Result); });
+		const double SpecializedTime = MeasureMicroseconds([this](FTransform& Result) { Target->ComputeSpecialized(DeltaSeconds, Result); });
+		AddInfo(FString::Printf(TEXT("%s: unspecialized %.3f us, specialized %.3f us"), *Description, UnspecializedTime, SpecializedTime));
+	}
+
+	UUxtNearPointerComponent* Pointers[2];
+	UGenericManipulatorTestComponent* Target;
+
+END_DEFINE_SPEC(GenericManipulatorPipelineSpec)
+
+void GenericManipulatorPipelineSpec::Define()
+{
+	Describe("Specialized manipulation pipeline", [this]
+		{
+			BeforeEach([this]
+				{
+					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+					UWorld* World = UxtTestUtils::GetTestWorld();
+
+					UxtTestUtils::EnableTestHandTracker();
+
+					Pointers[0] = UxtTestUtils::CreateNearPointer(World, TEXT("PipelineTestPointer0"), FVector::ZeroVector);
+					Pointers[1] = UxtTestUtils::CreateNearPointer(World, TEXT("PipelineTestPointer1"), FVector::ZeroVector);
+					Target = CreateTestComponent(World, FVector(150, 0, 0));
+
+					// Register all new components.
+					World->UpdateWorldComponents(false, false);
+				});
+
+			AfterEach([this]
+				{
+					UxtTestUtils::DisableTestHandTracker();
+
+					for (UUxtNearPointerComponent*& Pointer : Pointers)
+					{
+						Pointer->GetOwner()->Destroy();
+						Pointer = nullptr;
+					}
+					Target->GetOwner()->Destroy();
+					Target = nullptr;
+
+					// Force GC so that destroyed actors are removed from the world.
+					// Running multiple tests will otherwise cause errors when creating duplicate actors.
+					GEngine->ForceGarbageCollection();
+				});
+
+			It("should match the unspecialized one-handed update", [this]
+				{
+					MovePointer(Pointers[0], FVector(130, 0, 0), FQuat::Identity);
+					IUxtGrabTarget::Execute_OnBeginGrab(Target, Pointers[0]);
+
+					MovePointer(Pointers[0], FVector(120, 30, -10), FQuat(FVector::UpVector, 0.4f) * FQuat(FVector::ForwardVector, 0.2f));
+					IUxtGrabTarget::Execute_OnUpdateGrab(Target, Pointers[0]);
+
+					const UEnum* RotationModeEnum = StaticEnum<EUxtOneHandRotationMode>();
+					for (int Mode = 0; Mode < RotationModeEnum->NumEnums() - 1; ++Mode)
+					{
+						Target->OneHandRotationMode = (EUxtOneHandRotationMode)Mode;
+						CompareAndBenchmark(RotationModeEnum->GetNameStringByIndex(Mode));
+					}
+
+					Target->ManipulationModes = 0;
+					CompareAndBenchmark(TEXT("Disabled"));
+				});
+
+			It("should match the unspecialized two-handed update", [this]
+				{
+					MovePointer(Pointers[0], FVector(130, -20, 0), FQuat::Identity);
+					IUxtGrabTarget::Execute_OnBeginGrab(Target, Pointers[0]);
+					MovePointer(Pointers[1], FVector(130, 20, 0), FQuat::Identity);
+					IUxtGrabTarget::Execute_OnBeginGrab(Target, Pointers[1]);
+
+					MovePointer(Pointers[0], FVector(120, -30, -10), FQuat::Identity);
+					IUxtGrabTarget::Execute_OnUpdateGrab(Target, Pointers[0]);
+					MovePointer(Pointers[1], FVector(135, 25, 10), FQuat::Identity);
+					IUxtGrabTarget::Execute_OnUpdateGrab(Target, Pointers[1]);
+
+					for (uint8 Modes = 0; Modes < 8; ++Modes)
+					{
+						Target->TwoHandTransformModes = Modes;
+						CompareAndBenchmark(FString::Printf(TEXT("%s%s%s"),
+							(Modes & (1 << (uint8)EUxtTwoHandTransformMode::Translation)) ? TEXT("T") : TEXT("-"),
+							(Modes & (1 << (uint8)EUxtTwoHandTransformMode::Rotation)) ? TEXT("R") : TEXT("-"),
+							(Modes & (1 << (uint8)EUxtTwoHandTransformMode::Scaling)) ? TEXT("S") : TEXT("-")));
+					}
+
+					Target->ManipulationModes = 0;
+					CompareAndBenchmark(TEXT("Disabled"));
+				});
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
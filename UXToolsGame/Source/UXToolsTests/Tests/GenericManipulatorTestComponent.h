@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "Interactions/UxtGenericManipulatorComponent.h"
+
+#include "GenericManipulatorTestComponent.generated.h"
+
+/** Exposes the specialized and unspecialized manipulation updates for comparison. */
+UCLASS()
+class UXTOOLSTESTS_API UGenericManipulatorTestComponent : public UUxtGenericManipulatorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	bool ComputeSpecialized(float DeltaSeconds, FTransform& OutTargetTransform)
+	{
+		return ComputeTargetTransform(DeltaSeconds, OutTargetTransform);
+	}
+
+	bool ComputeUnspecialized(float DeltaSeconds, FTransform& OutTargetTransform) const
+	{
+		switch (GetGrabPointers().Num())
+		{
+		case 1:
+			return ComputeOneHandTargetTransform(DeltaSeconds, OutTargetTransform);
+		case 2:
+			return ComputeTwoHandTargetTransform(DeltaSeconds, OutTargetTransform);
+		default:
+			return false;
+		}
+	}
+
+private:
+
+	/** Reference one-handed manipulation that evaluates all settings on every call. */
+	bool ComputeOneHandTargetTransform(float DeltaSeconds, FTransform& OutTargetTransform) const
+	{
+		if (!(ManipulationModes & (1 << (uint8)EUxtGenericManipulationMode::OneHanded)))
+		{
+			return false;
+		}
+
+		FTransform TargetTransform = InitialTransform;
+
+		MoveToTargets(TargetTransform, TargetTransform, OneHandRotationMode != EUxtOneHandRotationMode::RotateAboutObjectCenter);
+
+		GetOneHandRotation(TargetTransform, TargetTransform);
+
+		SmoothTransform(TargetTransform, GetSmoothing(), GetSmoothing(), DeltaSeconds, TargetTransform);
+
+		OutTargetTransform = TargetTransform;
+		return true;
+	}
+
+	/** Reference two-handed manipulation that evaluates all settings on every call. */
+	bool ComputeTwoHandTargetTransform(float DeltaSeconds, FTransform& OutTargetTransform) const
+	{
+		if (!(ManipulationModes & (1 << (uint8)EUxtGenericManipulationMode::TwoHanded)))
+		{
+			return false;
+		}
+
+		FTransform TargetTransform = InitialTransform;
+
+		if (!!(TwoHandTransformModes & (1 << (uint8)EUxtTwoHandTransformMode::Scaling)))
+		{
+			GetTwoHandScale(TargetTransform, TargetTransform);
+		}
+
+		if (!!(TwoHandTransformModes & (1 << (uint8)EUxtTwoHandTransformMode::Rotation)))
+		{
+			GetTwoHandRotation(TargetTransform, TargetTransform);
+		}
+
+		if (!!(TwoHandTransformModes & (1 << (uint8)EUxtTwoHandTransformMode::Translation)))
+		{
+			MoveToTargets(TargetTransform, TargetTransform, true);
+		}
+
+		SmoothTransform(TargetTransform, GetSmoothing(), GetSmoothing(), DeltaSeconds, TargetTransform);
+
+		OutTargetTransform = TargetTransform;
+		return true;
+	}
+};
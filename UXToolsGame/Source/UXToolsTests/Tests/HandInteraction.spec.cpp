@@ -11,6 +11,9 @@
 #include "Input/UxtHandInteractionActor.h"
 #include "Input/UxtNearPointerComponent.h"
 #include "Input/UxtFarPointerComponent.h"
+#include "Input/UxtPointerDataSubsystem.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
 #include "PointerTestSequence.h"
 #include "UxtTestHandTracker.h"
 #include "UxtTestUtils.h"
@@ -178,6 +181,28 @@ void HandInteractionSpec::Define()
 			Done.Execute();
 		});
 	});
+
+	LatentIt("should publish the finger tip to the pointer data buffer", [this](const FDoneDelegate& Done)
+	{
+		FrameQueue.Enqueue([this]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = FarPoint;
+		});
+
+		FrameQueue.Enqueue([this, Done]
+		{
+			UUxtPointerDataSubsystem* PointerData = UxtTestUtils::GetTestWorld()->GetSubsystem<UUxtPointerDataSubsystem>();
+			TestNotNull(TEXT("Pointer data texture"), PointerData->GetPointerDataTexture());
+
+			// Existing materials read the left hand from the parameter collection.
+			UMaterialParameterCollection* ParameterCollection = LoadObject<UMaterialParameterCollection>(nullptr, TEXT("/UXTools/Pointers/PointerPositions.PointerPositions"));
+			FLinearColor LeftPointerPosition;
+			UxtTestUtils::GetTestWorld()->GetParameterCollectionInstance(ParameterCollection)->GetVectorParameterValue("LeftPointerPosition", LeftPointerPosition);
+			TestEqual(TEXT("Left pointer position"), FVector(LeftPointerPosition), FarPoint);
+
+			Done.Execute();
+		});
+	});
 }
 
 #endif // WITH_DEV_AUTOMATION_TESTS
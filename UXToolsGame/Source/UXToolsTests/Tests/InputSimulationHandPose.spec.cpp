@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS && WITH_INPUT_SIMULATION
+
+#include "UxtInputSimulationActor.h"
+#include "UxtRuntimeSettings.h"
+
+namespace
+{
+	const FName PoseRelaxed = TEXT("TestRelaxed");
+	const FName PosePinch = TEXT("TestPinch");
+	const FName PosePoke = TEXT("TestPoke");
+	const FName PoseWithoutTable = TEXT("TestNoTable");
+
+	/** Joint table with all joints offset from the mesh origin. */
+	FUxtRuntimeSettingsHandPoseJoints MakeJointTable(const FVector& Offset)
+	{
+		FUxtRuntimeSettingsHandPoseJoints Table;
+		Table.JointTransforms.Init(FTransform(Offset), EWMRHandKeypointCount);
+		return Table;
+	}
+
+	FVector GetIndexTipLocation(const TArray<FTransform>* Joints)
+	{
+		return Joints ? (*Joints)[(int32)EWMRHandKeypoint::IndexTip].GetLocation() : FVector::ZeroVector;
+	}
+}
+
+BEGIN_DEFINE_SPEC(InputSimulationHandPoseSpec, "UXTools.InputSimulation.HandPose", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	AUxtInputSimulationActor* InputSimActor;
+
+	// Settings are restored after each test
+	bool bSavedUseProceduralHandPoses;
+	float SavedHandPoseBlendTime;
+	FName SavedDefaultHandPose;
+	FName SavedPrimaryHandPose;
+	FName SavedSecondaryHandPose;
+	TMap<FName, FUxtRuntimeSettingsButtonSet> SavedHandPoseButtonMappings;
+	TMap<FName, FUxtRuntimeSettingsHandPoseJoints> SavedHandPoseJoints;
+
+END_DEFINE_SPEC(InputSimulationHandPoseSpec)
+
+void InputSimulationHandPoseSpec::Define()
+{
+	BeforeEach([this]
+		{
+			TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+			UUxtRuntimeSettings* Settings = UUxtRuntimeSettings::Get();
+			bSavedUseProceduralHandPoses = Settings->bUseProceduralHandPoses;
+			SavedHandPoseBlendTime = Settings->HandPoseBlendTime;
+			SavedDefaultHandPose = Settings->DefaultHandPose;
+			SavedPrimaryHandPose = Settings->PrimaryHandPose;
+			SavedSecondaryHandPose = Settings->SecondaryHandPose;
+			SavedHandPoseButtonMappings = Settings->HandPoseButtonMappings;
+			SavedHandPoseJoints = Settings->HandPoseJoints;
+
+			Settings->bUseProceduralHandPoses = true;
+			Settings->HandPoseBlendTime = 0.1f;
+			Settings->DefaultHandPose = PoseRelaxed;
+			Settings->PrimaryHandPose = PosePinch;
+			Settings->SecondaryHandPose = PosePoke;
+			Settings->HandPoseButtonMappings.Reset();
+			Settings->HandPoseJoints.Reset();
+			Settings->HandPoseJoints.Add(PoseRelaxed, MakeJointTable(FVector::ZeroVector));
+			Settings->HandPoseJoints.Add(PosePinch, MakeJointTable(FVector(10, 0, 0)));
+			Settings->HandPoseJoints.Add(PosePoke, MakeJointTable(FVector(0, 10, 0)));
+
+			// Spawning is not finished, so the actor does not begin play and take over the local player.
+			// Procedural poses only need the pose state and the runtime settings.
+			UWorld* World = UxtTestUtils::GetTestWorld();
+			InputSimActor = World->SpawnActorDeferred<AUxtInputSimulationActor>(AUxtInputSimulationActor::StaticClass(), FTransform::Identity);
+		});
+
+	AfterEach([this]
+		{
+			InputSimActor->Destroy();
+			InputSimActor = nullptr;
+
+			UUxtRuntimeSettings* Settings = UUxtRuntimeSettings::Get();
+			Settings->bUseProceduralHandPoses = bSavedUseProceduralHandPoses;
+			Settings->HandPoseBlendTime = SavedHandPoseBlendTime;
+			Settings->DefaultHandPose = SavedDefaultHandPose;
+			Settings->PrimaryHandPose = SavedPrimaryHandPose;
+			Settings->SecondaryHandPose = SavedSecondaryHandPose;
+			Settings->HandPoseButtonMappings = SavedHandPoseButtonMappings;
+			Settings->HandPoseJoints = SavedHandPoseJoints;
+
+			// Force GC so that destroyed actors are removed from the world.
+			GEngine->ForceGarbageCollection();
+		});
+
+	It("should use the hand mesh when procedural poses are disabled", [this]
+		{
+			UUxtRuntimeSettings::Get()->bUseProceduralHandPoses = false;
+
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.1f);
+			TestNull(TEXT("Procedural pose"), InputSimActor->GetProceduralHandPose(EControllerHand::Right));
+			TestFalse(TEXT("Hand pose is procedural"), InputSimActor->IsHandPoseProcedural(EControllerHand::Right));
+		});
+
+	It("should start from the joint table of the target pose", [this]
+		{
+			InputSimActor->SetTargetPose(EControllerHand::Right, PosePinch);
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.01f);
+
+			const TArray<FTransform>* Joints = InputSimActor->GetProceduralHandPose(EControllerHand::Right);
+			if (TestNotNull(TEXT("Procedural pose"), Joints))
+			{
+				TestEqual(TEXT("Number of joints"), Joints->Num(), EWMRHandKeypointCount);
+				TestTrue(TEXT("Index tip starts at the target pose"), GetIndexTipLocation(Joints).Equals(FVector(10, 0, 0)));
+			}
+			TestNull(TEXT("Procedural pose of the other hand"), InputSimActor->GetProceduralHandPose(EControllerHand::Left));
+		});
+
+	It("should blend towards a new target pose", [this]
+		{
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.01f);
+			InputSimActor->SetTargetPose(EControllerHand::Right, PosePinch);
+
+			// One blend time moves the joints by 1 - 1/e of the distance to the target.
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.1f);
+			const float ExpectedX = 10.0f * (1.0f - FMath::Exp(-1.0f));
+			TestTrue(TEXT("Index tip partially blended"), GetIndexTipLocation(InputSimActor->GetProceduralHandPose(EControllerHand::Right)).Equals(FVector(ExpectedX, 0, 0), 0.01f));
+
+			for (int32 Frame = 0; Frame < 100; ++Frame)
+			{
+				InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.1f);
+			}
+			TestTrue(TEXT("Index tip reached the target pose"), GetIndexTipLocation(InputSimActor->GetProceduralHandPose(EControllerHand::Right)).Equals(FVector(10, 0, 0), 0.01f));
+		});
+
+	It("should switch immediately without a blend time", [this]
+		{
+			UUxtRuntimeSettings::Get()->HandPoseBlendTime = 0.0f;
+
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.01f);
+			InputSimActor->SetTargetPose(EControllerHand::Right, PosePoke);
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.01f);
+
+			TestTrue(TEXT("Index tip at the target pose"), GetIndexTipLocation(InputSimActor->GetProceduralHandPose(EControllerHand::Right)).Equals(FVector(0, 10, 0)));
+		});
+
+	It("should fall back to the hand mesh for poses without a joint table", [this]
+		{
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.01f);
+			TestTrue(TEXT("Hand pose is procedural"), InputSimActor->IsHandPoseProcedural(EControllerHand::Right));
+
+			InputSimActor->SetTargetPose(EControllerHand::Right, PoseWithoutTable);
+			InputSimActor->UpdateProceduralHandPose(EControllerHand::Right, 0.01f);
+			TestNull(TEXT("Procedural pose"), InputSimActor->GetProceduralHandPose(EControllerHand::Right));
+		});
+
+	It("should only allow skipping mesh animation when all poses have joint tables", [this]
+		{
+			UUxtRuntimeSettings* Settings = UUxtRuntimeSettings::Get();
+			TestTrue(TEXT("All poses have joint tables"), Settings->CanUseProceduralHandPoses());
+
+			Settings->HandPoseButtonMappings.Add(PoseWithoutTable);
+			TestFalse(TEXT("Button mapped pose without joint table"), Settings->CanUseProceduralHandPoses());
+			Settings->HandPoseButtonMappings.Reset();
+
+			Settings->HandPoseJoints.Remove(PosePoke);
+			TestFalse(TEXT("Secondary pose without joint table"), Settings->CanUseProceduralHandPoses());
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS && WITH_INPUT_SIMULATION
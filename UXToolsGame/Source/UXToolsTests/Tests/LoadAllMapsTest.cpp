@@ -5,18 +5,277 @@
 #include "CoreMinimal.h"
 #include "Engine.h"
 #include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
 #include "Logging/MessageLog.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "Misc/AutomationTest.h"
 #include "Misc/MapErrors.h"
 #include "Modules/ModuleManager.h"
 #include "Tests/AutomationCommon.h"
+#include "UObject/UObjectIterator.h"
+
+#include "Utils/UxtStats.h"
+#include "UxtBenchmarkRecorder.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
 
 static const FName MapsPathRoot = TEXT("/UXTools/Maps");
 static const bool LoadMapsRecursive = true;
 static const bool IncludeOnlyOnDiskAssets = true;
 static const float StreamResourceTimeout = 10.0f;
+static const double OpenMapTimeout = 120.0;
+
+/** Map loaded before each measured map, so that memory of the previous map has been released when sampling. */
+static const TCHAR* EmptyMap = TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty");
+
+/** Config section in the game ini with the default budgets and +MapBudgets=(Map=...) overrides. */
+static const TCHAR* BudgetsSection = TEXT("UXTools.LoadAllMaps");
+
+namespace
+{
+	struct FMapLoadBudgets
+	{
+		float LoadMs = 20000.0f;
+		float BeginPlayMs = 100.0f;
+		float UxtMemoryKB = 16384.0f;
+	};
+
+	/** Measurements of a single map, shared by the latent commands of its test. */
+	struct FMapLoadMeasurement
+	{
+		FString Map;
+		FMapLoadBudgets Budgets;
+
+		/** Time of the open command, the map is loaded when the world travels on the next engine tick. */
+		uint64 StartCycles = 0;
+		/** Time when LoadMap started and finished, as reported by the load map delegates. */
+		uint64 LoadMapStartCycles = 0;
+		uint64 LoadMapEndCycles = 0;
+		/** Time when the world was ready, after LoadMap and the wait for the match to start. */
+		uint64 LoadedCycles = 0;
+
+		double TravelMs = 0;
+		double LoadMs = 0;
+		double StreamMs = 0;
+		uint64 UsedPhysicalBefore = 0;
+		bool bMapOpened = false;
+
+		FDelegateHandle PreLoadMapHandle;
+		FDelegateHandle PostLoadMapHandle;
+	};
+
+	/** Read the budgets of the map from the config, per map values override the defaults. */
+	FMapLoadBudgets GetBudgets(const FString& Map)
+	{
+		FMapLoadBudgets Budgets;
+		GConfig->GetFloat(BudgetsSection, TEXT("LoadBudgetMs"), Budgets.LoadMs, GGameIni);
+		GConfig->GetFloat(BudgetsSection, TEXT("BeginPlayBudgetMs"), Budgets.BeginPlayMs, GGameIni);
+		GConfig->GetFloat(BudgetsSection, TEXT("UxtMemoryBudgetKB"), Budgets.UxtMemoryKB, GGameIni);
+
+		TArray<FString> MapBudgets;
+		GConfig->GetArray(BudgetsSection, TEXT("MapBudgets"), MapBudgets, GGameIni);
+		for (const FString& Entry : MapBudgets)
+		{
+			FString EntryMap;
+			if (FParse::Value(*Entry, TEXT("Map="), EntryMap) && EntryMap == Map)
+			{
+				FParse::Value(*Entry, TEXT("LoadBudgetMs="), Budgets.LoadMs);
+				FParse::Value(*Entry, TEXT("BeginPlayBudgetMs="), Budgets.BeginPlayMs);
+				FParse::Value(*Entry, TEXT("UxtMemoryBudgetKB="), Budgets.UxtMemoryKB);
+			}
+		}
+
+		const float BudgetScale = FUxtBenchmarkRecorder::GetBudgetScale();
+		Budgets.LoadMs *= BudgetScale;
+		Budgets.BeginPlayMs *= BudgetScale;
+		Budgets.UxtMemoryKB *= BudgetScale;
+		return Budgets;
+	}
+
+	/** True for native UX Tools classes and for Blueprint classes in the plugin content. */
+	bool IsUxtClass(const UClass* Class)
+	{
+		const FString PackageName = Class->GetOutermost()->GetName();
+		return PackageName == TEXT("/Script/UXTools") || PackageName.StartsWith(TEXT("/UXTools/"));
+	}
+
+	/** Objects are attributed to UX Tools if they or one of their outers, e.g. the component that created them, have a UX Tools class. */
+	bool IsAttributableToUxt(const UObject* Object)
+	{
+		for (const UObject* Outer = Object; Outer && !Outer->IsA<ULevel>(); Outer = Outer->GetOuter())
+		{
+			if (IsUxtClass(Outer->GetClass()))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+}
+
+/**
+ * Samples memory with only the empty map loaded, then opens the measured map.
+ * Completes once the measured map is the test world, the open command only travels on the next engine tick.
+ */
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FUxtOpenMeasuredMapCommand, TSharedRef<FMapLoadMeasurement>, Measurement, FAutomationTestBase*, Test);
+
+bool FUxtOpenMeasuredMapCommand::Update()
+{
+	UWorld* World = UxtTestUtils::GetTestWorld();
+
+	if (!Measurement->bMapOpened)
+	{
+		// The previous map has been torn down when the empty map loaded, collect what it left behind
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		Measurement->UsedPhysicalBefore = FPlatformMemory::GetStats().UsedPhysical;
+		FUxtBeginPlayCost::Reset();
+
+		// Time LoadMap itself, separately from the wait for the world to travel
+		TWeakPtr<FMapLoadMeasurement> WeakMeasurement = Measurement;
+		Measurement->PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddLambda([WeakMeasurement](const FString&)
+			{
+				if (TSharedPtr<FMapLoadMeasurement> Pinned = WeakMeasurement.Pin())
+				{
+					Pinned->LoadMapStartCycles = FPlatformTime::Cycles64();
+				}
+			});
+		Measurement->PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddLambda([WeakMeasurement](UWorld*)
+			{
+				if (TSharedPtr<FMapLoadMeasurement> Pinned = WeakMeasurement.Pin())
+				{
+					Pinned->LoadMapEndCycles = FPlatformTime::Cycles64();
+				}
+			});
+
+		Measurement->StartCycles = FPlatformTime::Cycles64();
+		GEngine->Exec(World, *FString::Printf(TEXT("Open %s"), *Measurement->Map));
+		Measurement->bMapOpened = true;
+		return false;
+	}
+
+	// Worlds in the editor are PIE worlds, their package names carry a UEDPIE_<n>_ prefix
+	if (World && UWorld::RemovePIEPrefix(World->GetOutermost()->GetName()) == Measurement->Map && World->AreActorsInitialized())
+	{
+		return true;
+	}
+
+	const double ElapsedSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Measurement->StartCycles);
+	if (ElapsedSeconds > OpenMapTimeout)
+	{
+		Test->AddError(FString::Printf(TEXT("Map %s did not load within %.0f s"), *Measurement->Map, OpenMapTimeout));
+		return true;
+	}
 
+	return false;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FUxtRecordMapLoadedCommand, TSharedRef<FMapLoadMeasurement>, Measurement);
+
+bool FUxtRecordMapLoadedCommand::Update()
+{
+	Measurement->LoadedCycles = FPlatformTime::Cycles64();
+
+	FCoreUObjectDelegates::PreLoadMap.Remove(Measurement->PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(Measurement->PostLoadMapHandle);
+
+	if (Measurement->LoadMapStartCycles && Measurement->LoadMapEndCycles)
+	{
+		Measurement->TravelMs = FPlatformTime::ToMilliseconds64(Measurement->LoadMapStartCycles - Measurement->StartCycles);
+		Measurement->LoadMs = FPlatformTime::ToMilliseconds64(Measurement->LoadMapEndCycles - Measurement->LoadMapStartCycles);
+	}
+	else
+	{
+		// No load map delegates, e.g. if the world was not loaded through LoadMap, include the travel latency
+		Measurement->LoadMs = FPlatformTime::ToMilliseconds64(Measurement->LoadedCycles - Measurement->StartCycles);
+	}
+	return true;
+}
+
+DEFINE_LATENT_AUTOMATION_COMMAND_TWO_PARAMETER(FUxtReportMapLoadCommand, TSharedRef<FMapLoadMeasurement>, Measurement, FAutomationTestBase*, Test);
+
+bool FUxtReportMapLoadCommand::Update()
+{
+	Measurement->StreamMs = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - Measurement->LoadedCycles);
+
+	const FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+	const double UsedPhysicalDeltaKB = (static_cast<double>(MemoryStats.UsedPhysical) - static_cast<double>(Measurement->UsedPhysicalBefore)) / 1024.0;
+
+	// Memory of UX Tools objects in the loaded world, as reported by the objects themselves
+	int32 NumUxtObjects = 0;
+	SIZE_T UxtBytes = 0;
+	if (UWorld* World = UxtTestUtils::GetTestWorld())
+	{
+		for (TObjectIterator<UObject> It; It; ++It)
+		{
+			if (It->IsIn(World) && IsAttributableToUxt(*It))
+			{
+				++NumUxtObjects;
+				UxtBytes += It->GetClass()->GetStructureSize() + It->GetResourceSizeBytes(EResourceSizeMode::Exclusive);
+			}
+		}
+	}
+	const double UxtMemoryKB = UxtBytes / 1024.0;
+
+	double BeginPlayMs = 0;
+	FString BeginPlayJson;
+	for (const TPair<FName, FUxtBeginPlayCost::FEntry>& Entry : FUxtBeginPlayCost::GetEntries())
+	{
+		const double EntryMs = FPlatformTime::ToMilliseconds64(Entry.Value.Cycles);
+		BeginPlayMs += EntryMs;
+		BeginPlayJson += FString::Printf(TEXT("%s\t\t\"%s\": { \"Ms\": %.4f, \"Calls\": %d }"),
+			BeginPlayJson.IsEmpty() ? TEXT("") : TEXT(",\n"), *Entry.Key.ToString(), EntryMs, Entry.Value.Calls);
+	}
+
+	const FMapLoadBudgets& Budgets = Measurement->Budgets;
+	const bool bLoadInBudget = Measurement->LoadMs <= Budgets.LoadMs;
+	const bool bBeginPlayInBudget = BeginPlayMs <= Budgets.BeginPlayMs;
+	const bool bMemoryInBudget = UxtMemoryKB <= Budgets.UxtMemoryKB;
+
+	FString Json = FString::Printf(TEXT("{\n\t\"Map\": \"%s\",\n"), *Measurement->Map);
+	Json += FString::Printf(TEXT("\t\"TravelMs\": %.3f,\n\t\"LoadMs\": %.3f,\n\t\"StreamMs\": %.3f,\n\t\"BeginPlayMs\": %.4f,\n"),
+		Measurement->TravelMs, Measurement->LoadMs, Measurement->StreamMs, BeginPlayMs);
+	Json += FString::Printf(TEXT("\t\"BeginPlay\": {\n%s\n\t},\n"), *BeginPlayJson);
+	Json += FString::Printf(TEXT("\t\"UxtObjects\": %d,\n\t\"UxtMemoryKB\": %.1f,\n\t\"UsedPhysicalDeltaKB\": %.1f,\n"), NumUxtObjects, UxtMemoryKB, UsedPhysicalDeltaKB);
+	Json += FString::Printf(TEXT("\t\"Budgets\": { \"LoadMs\": %.3f, \"BeginPlayMs\": %.4f, \"UxtMemoryKB\": %.1f },\n"), Budgets.LoadMs, Budgets.BeginPlayMs, Budgets.UxtMemoryKB);
+	Json += FString::Printf(TEXT("\t\"WithinBudget\": %s\n}\n"), (bLoadInBudget && bBeginPlayInBudget && bMemoryInBudget) ? TEXT("true") : TEXT("false"));
+
+	const FString Filename = FPaths::Combine(FPaths::AutomationDir(), TEXT("UXTools"), TEXT("Benchmarks"), TEXT("MapLoad"), FPaths::GetBaseFilename(Measurement->Map) + TEXT(".json"));
+	FFileHelper::SaveStringToFile(Json, *Filename);
+
+	Test->AddInfo(FString::Printf(TEXT("%s: travel %.1f ms, load %.1f ms, streaming %.1f ms, UXT begin play %.3f ms, %d UXT objects using %.1f KB, used physical memory %+.1f KB"),
+		*Measurement->Map, Measurement->TravelMs, Measurement->LoadMs, Measurement->StreamMs, BeginPlayMs, NumUxtObjects, UxtMemoryKB, UsedPhysicalDeltaKB));
+
+	if (!bLoadInBudget)
+	{
+		Test->AddError(FString::Printf(TEXT("Load time %.1f ms exceeds the budget of %.1f ms"), Measurement->LoadMs, Budgets.LoadMs));
+	}
+	if (!bBeginPlayInBudget)
+	{
+		Test->AddError(FString::Printf(TEXT("UXT begin play time %.3f ms exceeds the budget of %.3f ms"), BeginPlayMs, Budgets.BeginPlayMs));
+	}
+	if (!bMemoryInBudget)
+	{
+		Test->AddError(FString::Printf(TEXT("UXT memory %.1f KB exceeds the budget of %.1f KB"), UxtMemoryKB, Budgets.UxtMemoryKB));
+	}
+
+	return true;
+}
+
+/**
+ * Loads every map in the plugin and measures:
+ * - Travel time from the open command until LoadMap starts, which depends on the engine tick.
+ * - Load time spent in LoadMap, and the time until resources are streamed and shaders compiled.
+ * - Time spent in BeginPlay of UX Tools actors and components, see FUxtBeginPlayCost.
+ * - Memory of UX Tools objects in the map, and the change of used physical memory compared to an empty map.
+ * Results are written to Saved/Automation/UXTools/Benchmarks/MapLoad/<Map>.json and compared to the budgets in the
+ * [UXTools.LoadAllMaps] section of the game ini. Budgets can be scaled with -UxtBenchmarkBudgetScale=<Scale>.
+ *
+ * Runs headless, also on Linux, e.g.:
+ *   UE4Editor UXToolsGame.uproject -nullrhi -unattended -ExecCmds="Automation RunTests UXTools.LoadAllMaps; Quit"
+ */
 IMPLEMENT_COMPLEX_AUTOMATION_TEST(FLoadAllMapsTest, "UXTools.LoadAllMaps",
 	EAutomationTestFlags::EditorContext |
 	EAutomationTestFlags::ClientContext |
@@ -45,14 +304,25 @@ void FLoadAllMapsTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray <FSt
 bool FLoadAllMapsTest::RunTest(const FString& Parameters)
 {
 	FString Path = Parameters;
-	AutomationOpenMap(Path);
+
+	TSharedRef<FMapLoadMeasurement> Measurement = MakeShared<FMapLoadMeasurement>();
+	Measurement->Map = Path;
+	Measurement->Budgets = GetBudgets(Path);
+
+	// Load an empty map first, the previous map is still loaded while this test starts
+	AutomationOpenMap(EmptyMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitForMapToLoadCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FUxtOpenMeasuredMapCommand(Measurement, this));
 
 	ADD_LATENT_AUTOMATION_COMMAND(FWaitForMapToLoadCommand());
+	ADD_LATENT_AUTOMATION_COMMAND(FUxtRecordMapLoadedCommand(Measurement));
 	ADD_LATENT_AUTOMATION_COMMAND(FStreamAllResourcesLatentCommand(StreamResourceTimeout));
 	ADD_LATENT_AUTOMATION_COMMAND(FWaitForShadersToFinishCompilingInGame());
+	ADD_LATENT_AUTOMATION_COMMAND(FUxtReportMapLoadCommand(Measurement, this));
 
 	ADD_LATENT_AUTOMATION_COMMAND(FExitGameCommand());
 
 	return true;
 }
 
+#endif // WITH_DEV_AUTOMATION_TESTS
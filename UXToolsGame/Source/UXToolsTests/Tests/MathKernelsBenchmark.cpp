@@ -0,0 +1,257 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+
+#include "Controls/UxtBoundingBoxManipulatorComponent.h"
+#include "Utils/UxtMathKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Number of precomputed inputs, kernels cycle through them to avoid measuring constant folded results. */
+	const int32 NumInputs = 1024;
+
+	const int32 NumSamples = 20;
+	const int32 DefaultIterations = 100000;
+
+	/** Deterministic random inputs shared by all kernels. */
+	struct FKernelInputs
+	{
+		FKernelInputs()
+		{
+			FRandomStream Stream(0x5578);
+			for (int32 Index = 0; Index < NumInputs; ++Index)
+			{
+				Positions.Add(Stream.GetUnitVector() * Stream.FRandRange(10, 200));
+				Directions.Add(Stream.GetUnitVector());
+				Rotations.Add(FQuat(Stream.GetUnitVector(), Stream.FRandRange(-PI, PI)));
+				Scales.Add(FVector(Stream.FRandRange(0.5f, 2.0f)));
+			}
+		}
+
+		TArray<FVector> Positions;
+		TArray<FVector> Directions;
+		TArray<FQuat> Rotations;
+		TArray<FVector> Scales;
+	};
+
+	struct FKernelStats
+	{
+		double MeanNs = 0;
+		double StdDevNs = 0;
+		double MinNs = 0;
+		double MedianNs = 0;
+	};
+
+	int32 GetIterations()
+	{
+		int32 Iterations = DefaultIterations;
+		FParse::Value(FCommandLine::Get(), TEXT("UxtBenchmarkIterations="), Iterations);
+		return FMath::Max(Iterations, 1);
+	}
+
+	/**
+	 * Time a kernel over several samples and return the time per call.
+	 * The kernel returns a float that is accumulated into the sink, so the calls can not be optimized away.
+	 */
+	template <typename KernelType>
+	FKernelStats MeasureKernel(KernelType Kernel, int32 Iterations, float& Sink)
+	{
+		TArray<double> Samples;
+		Samples.Reserve(NumSamples);
+
+		// Warm up caches and branch predictors
+		for (int32 Iteration = 0; Iteration < Iterations / 10; ++Iteration)
+		{
+			Sink += Kernel(Iteration & (NumInputs - 1));
+		}
+
+		for (int32 Sample = 0; Sample < NumSamples; ++Sample)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				Sink += Kernel(Iteration & (NumInputs - 1));
+			}
+			const uint64 EndCycles = FPlatformTime::Cycles64();
+
+			Samples.Add(FPlatformTime::ToSeconds64(EndCycles - StartCycles) * 1e9 / Iterations);
+		}
+
+		Samples.Sort();
+
+		FKernelStats Stats;
+		for (double Value : Samples)
+		{
+			Stats.MeanNs += Value;
+		}
+		Stats.MeanNs /= Samples.Num();
+
+		for (double Value : Samples)
+		{
+			Stats.StdDevNs += FMath::Square(Value - Stats.MeanNs);
+		}
+		Stats.StdDevNs = FMath::Sqrt(Stats.StdDevNs / Samples.Num());
+
+		Stats.MinNs = Samples[0];
+		Stats.MedianNs = Samples[Samples.Num() / 2];
+		return Stats;
+	}
+}
+
+/**
+ * Runs the interaction math kernels many times without a world and reports the time per call.
+ * Each kernel is a separate test, e.g.:
+ *   UE4Editor UXToolsGame.uproject -nullrhi -unattended -ExecCmds="Automation RunTests UXTools.Benchmark.MathKernels; Quit"
+ * The number of calls per sample can be set with -UxtBenchmarkIterations=<Count>.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMathKernelsBenchmark, "UXTools.Benchmark.MathKernels",
+	EAutomationTestFlags::EditorContext |
+	EAutomationTestFlags::ClientContext |
+	EAutomationTestFlags::PerfFilter)
+
+void FMathKernelsBenchmark::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	static const TCHAR* KernelNames[] = {
+		TEXT("AngularClamp"),
+		TEXT("DistanceClamp"),
+		TEXT("ManipulationMove"),
+		TEXT("TwoHandRotate"),
+		TEXT("MinDistanceBetweenPoints"),
+		TEXT("ComputeModifiedBounds"),
+		TEXT("FrontFacePoke"),
+	};
+
+	for (const TCHAR* Name : KernelNames)
+	{
+		OutBeautifiedNames.Add(Name);
+		OutTestCommands.Add(Name);
+	}
+}
+
+bool FMathKernelsBenchmark::RunTest(const FString& Parameters)
+{
+	const FKernelInputs Inputs;
+	const int32 Iterations = GetIterations();
+	float Sink = 0;
+	FKernelStats Stats;
+
+	if (Parameters == TEXT("AngularClamp"))
+	{
+		// Looking straight at the target must not clamp
+		FVector Forward;
+		TestFalse("Target in view is not clamped", FUxtMathKernels::AngularClamp(FVector::ZeroVector, FQuat::Identity, FVector(100, 0, 0), false, 30, 20, Forward));
+
+		Stats = MeasureKernel([&Inputs](int32 Index)
+			{
+				FVector RefForward;
+				FUxtMathKernels::AngularClamp(FVector::ZeroVector, Inputs.Rotations[Index], Inputs.Positions[Index], false, 30, 20, RefForward);
+				return RefForward.X;
+			}, Iterations, Sink);
+	}
+	else if (Parameters == TEXT("DistanceClamp"))
+	{
+		FVector Clamped;
+		FUxtMathKernels::DistanceClamp(0.016f, 50, 100, 150, false, FVector(300, 0, 0), FVector::ZeroVector, FVector::ForwardVector, false, 6, Clamped);
+		TestEqual("Position is clamped to max distance", Clamped, FVector(150, 0, 0));
+
+		Stats = MeasureKernel([&Inputs](int32 Index)
+			{
+				FVector Clamped;
+				FUxtMathKernels::DistanceClamp(
+					0.016f, 50, 100, 150, true, Inputs.Positions[Index], FVector::ZeroVector, Inputs.Directions[Index], true, 6, Clamped);
+				return Clamped.X;
+			}, Iterations, Sink);
+	}
+	else if (Parameters == TEXT("ManipulationMove"))
+	{
+		const FVector Moved = FUxtMathKernels::ManipulationMove(
+			FTransform(FVector(10, 0, 0)), FQuat::Identity, FVector::OneVector, false, 1, FVector(5, 0, 0), FVector::ZeroVector, FVector(0, 0, 1));
+		TestEqual("Object follows the pointer", Moved, FVector(15, 0, 1));
+
+		Stats = MeasureKernel([&Inputs](int32 Index)
+			{
+				const int32 Other = (Index + 1) & (NumInputs - 1);
+				const float DistanceRatio = FUxtMathKernels::GetDistanceToBody(Inputs.Positions[Index], FVector::ZeroVector) / 100.0f;
+				const FVector Location = FUxtMathKernels::ManipulationMove(FTransform(Inputs.Rotations[Index], Inputs.Positions[Index]), Inputs.Rotations[Other],
+					Inputs.Scales[Index], (Index & 1) != 0, DistanceRatio, Inputs.Directions[Index], Inputs.Directions[Other], Inputs.Positions[Other]);
+				return Location.X;
+			}, Iterations, Sink);
+	}
+	else if (Parameters == TEXT("TwoHandRotate"))
+	{
+		const FQuat Rotated = FUxtMathKernels::TwoHandRotate(FVector::ForwardVector, FVector::RightVector, FQuat::Identity);
+		TestTrue("Handle bar rotation is applied", (Rotated * FVector::ForwardVector).Equals(FVector::RightVector, KINDA_SMALL_NUMBER));
+
+		Stats = MeasureKernel([&Inputs](int32 Index)
+			{
+				const int32 Other = (Index + 1) & (NumInputs - 1);
+				return FUxtMathKernels::TwoHandRotate(Inputs.Directions[Index], Inputs.Directions[Other], Inputs.Rotations[Index]).W;
+			}, Iterations, Sink);
+	}
+	else if (Parameters == TEXT("MinDistanceBetweenPoints"))
+	{
+		const FVector Points[] = {FVector(0, 0, 0), FVector(10, 0, 0), FVector(0, 3, 0)};
+		TestEqual("Closest pair distance", FUxtMathKernels::GetMinDistanceBetweenPoints(MakeArrayView(Points)), 3.0f);
+
+		Stats = MeasureKernel([&Inputs](int32 Index)
+			{
+				// Two hands, as in two hand scaling
+				const TArrayView<const FVector> Points(&Inputs.Positions[Index & ~1], 2);
+				return FUxtMathKernels::GetMinDistanceBetweenPoints(Points);
+			}, Iterations, Sink);
+	}
+	else if (Parameters == TEXT("ComputeModifiedBounds"))
+	{
+		const FBox InitialBounds(FVector(-1), FVector(1));
+		FBox Bounds;
+		FQuat DeltaRotation;
+		FUxtMathKernels::ComputeModifiedBounds(EUxtBoundingBoxAffordanceAction::Translate, FVector::ZeroVector, FMatrix::Identity, FTransform::Identity,
+			InitialBounds, FVector::ZeroVector, FVector(2, 0, 0), Bounds, DeltaRotation);
+		TestTrue("Translated bounds", Bounds == InitialBounds.ShiftBy(FVector(2, 0, 0)));
+
+		static const EUxtBoundingBoxAffordanceAction Actions[] = {EUxtBoundingBoxAffordanceAction::Resize, EUxtBoundingBoxAffordanceAction::Translate,
+			EUxtBoundingBoxAffordanceAction::Scale, EUxtBoundingBoxAffordanceAction::Rotate};
+
+		Stats = MeasureKernel([&Inputs, &InitialBounds](int32 Index)
+			{
+				FBox Bounds;
+				FQuat DeltaRotation;
+				FUxtMathKernels::ComputeModifiedBounds(Actions[Index & 3], Inputs.Directions[Index], FMatrix::Identity,
+					FTransform(Inputs.Rotations[Index], Inputs.Positions[Index]), InitialBounds, Inputs.Directions[Index], Inputs.Positions[Index], Bounds,
+					DeltaRotation);
+				return Bounds.Max.X + DeltaRotation.W;
+			}, Iterations, Sink);
+	}
+	else if (Parameters == TEXT("FrontFacePoke"))
+	{
+		const FVector Extents(5, 10, 10);
+		TestFalse("Pointer in front is not behind", FUxtMathKernels::IsBehindFrontFace(FTransform::Identity, Extents, FVector(-10, 0, 0), 1));
+		TestTrue("Pointer inside is behind", FUxtMathKernels::IsBehindFrontFace(FTransform::Identity, Extents, FVector(-5, 0, 0), 1));
+		TestTrue("Pointer beyond depth ends poke", FUxtMathKernels::IsFrontFacePokeEnded(FTransform::Identity, Extents, FVector(20, 0, 0), 1, 10));
+
+		Stats = MeasureKernel([&Inputs, &Extents](int32 Index)
+			{
+				const FTransform Transform(Inputs.Rotations[Index]);
+				const bool bBehind = FUxtMathKernels::IsBehindFrontFace(Transform, Extents, Inputs.Positions[Index] * 0.1f, 1);
+				const bool bEnded = FUxtMathKernels::IsFrontFacePokeEnded(Transform, Extents, Inputs.Positions[Index] * 0.1f, 1, 10);
+				return (bBehind ? 1.0f : 0.0f) + (bEnded ? 2.0f : 0.0f);
+			}, Iterations, Sink);
+	}
+	else
+	{
+		AddError(FString::Printf(TEXT("Unknown kernel %s"), *Parameters));
+		return false;
+	}
+
+	AddInfo(FString::Printf(TEXT("%s: mean %.2f ns, stddev %.2f ns, min %.2f ns, median %.2f ns per call (%d samples of %d calls, sink %g)"), *Parameters,
+		Stats.MeanNs, Stats.StdDevNs, Stats.MinNs, Stats.MedianNs, NumSamples, Iterations, Sink));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,387 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#include "Input/UxtNearInteractionCore.h"
+#include "Utils/UxtMathKernels.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Simulated box targets, each target has a single primitive with the same ID. */
+	struct FSimulatedScene : public IUxtPokeGeometry
+	{
+		struct FBoxTarget
+		{
+			FVector Center;
+			FVector Extents;
+			bool bFrontFace;
+			bool bRemoved;
+		};
+
+		FSimulatedScene(FRandomStream& Stream, int32 NumTargets)
+		{
+			for (int32 Index = 0; Index < NumTargets; ++Index)
+			{
+				FBoxTarget Box;
+				Box.Center = Stream.GetUnitVector() * Stream.FRandRange(0, 50);
+				Box.Extents = FVector(Stream.FRandRange(1, 5), Stream.FRandRange(2, 10), Stream.FRandRange(2, 10));
+				Box.bFrontFace = Stream.FRand() < 0.5f;
+				Box.bRemoved = false;
+				Boxes.Add(Box);
+			}
+		}
+
+		const FBoxTarget& GetBox(FUxtTargetId Id) const
+		{
+			check(Id > 0 && Id <= static_cast<FUxtTargetId>(Boxes.Num()));
+			return Boxes[Id - 1];
+		}
+
+		/** Closest box whose surface is within the radius, 0 if none. */
+		FUxtTargetId FindClosest(const FVector& Location, float Radius, FVector& OutClosestPoint) const
+		{
+			FUxtTargetId Closest = 0;
+			float MinDistSqr = FMath::Square(Radius);
+			for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+			{
+				const FBoxTarget& Box = Boxes[Index];
+				if (Box.bRemoved)
+				{
+					continue;
+				}
+
+				const FVector Point = FBox(Box.Center - Box.Extents, Box.Center + Box.Extents).GetClosestPointTo(Location);
+				const float DistSqr = FVector::DistSquared(Point, Location);
+				if (DistSqr <= MinDistSqr)
+				{
+					MinDistSqr = DistSqr;
+					Closest = Index + 1;
+					OutClosestPoint = Point;
+				}
+			}
+			return Closest;
+		}
+
+		virtual bool IsFrontFacePokable(FUxtTargetId Target) const override
+		{
+			return GetBox(Target).bFrontFace;
+		}
+
+		virtual bool IsBehindFrontFace(FUxtTargetId Primitive, const FVector& Location, float Radius) const override
+		{
+			const FBoxTarget& Box = GetBox(Primitive);
+			return FUxtMathKernels::IsBehindFrontFace(FTransform(Box.Center), Box.Extents, Location, Radius);
+		}
+
+		virtual bool IsFrontFacePokeEnded(FUxtTargetId Primitive, const FVector& Location, float Radius, float Depth) const override
+		{
+			const FBoxTarget& Box = GetBox(Primitive);
+			return FUxtMathKernels::IsFrontFacePokeEnded(FTransform(Box.Center), Box.Extents, Location, Radius, Depth);
+		}
+
+		virtual bool IsOverlapping(FUxtTargetId Primitive, const FVector& Location, float Radius) const override
+		{
+			const FBoxTarget& Box = GetBox(Primitive);
+			return FBox(Box.Center - Box.Extents, Box.Center + Box.Extents).ComputeSquaredDistanceToPoint(Location) <= FMath::Square(Radius);
+		}
+
+		virtual FUxtTargetId Sweep(const FVector& Start, const FVector& End, float Radius) const override
+		{
+			// Sampled sweep, good enough for the state machine
+			const int32 NumSamples = 8;
+			for (int32 Sample = 0; Sample <= NumSamples; ++Sample)
+			{
+				const FVector Location = FMath::Lerp(Start, End, static_cast<float>(Sample) / NumSamples);
+				for (int32 Index = 0; Index < Boxes.Num(); ++Index)
+				{
+					if (!Boxes[Index].bRemoved && IsOverlapping(Index + 1, Location, Radius))
+					{
+						return Index + 1;
+					}
+				}
+			}
+			return 0;
+		}
+
+		TArray<FBoxTarget> Boxes;
+	};
+
+	/** Checks that the transitions reported by the cores are consistent. */
+	struct FInvariantChecker : public IUxtFocusListener, public IUxtPokeListener
+	{
+		FInvariantChecker(FAutomationTestBase& InTest, const FUxtFocusCore& InFocus)
+			: Test(InTest), Focus(InFocus)
+		{
+		}
+
+		void Check(bool bCondition, const TCHAR* What)
+		{
+			if (!bCondition)
+			{
+				++NumErrors;
+				// Only report the first few errors, the simulation runs for many steps
+				if (NumErrors <= 10)
+				{
+					Test.AddError(FString::Printf(TEXT("Step %d: %s"), Step, What));
+				}
+			}
+		}
+
+		virtual void OnEnterFocus(FUxtTargetId Target) override
+		{
+			Check(EnteredTarget == 0, TEXT("Focus entered without exiting the previous target"));
+			Check(Focus.GetTarget() == Target, TEXT("Focus entered before the focus state changed"));
+			EnteredTarget = Target;
+			++NumEvents;
+		}
+
+		virtual void OnExitFocus(FUxtTargetId Target) override
+		{
+			Check(EnteredTarget == Target, TEXT("Focus exited on a target that was not entered"));
+			Check(Focus.GetTarget() == Target, TEXT("Focus exited after the focus state changed"));
+			EnteredTarget = 0;
+			++NumEvents;
+		}
+
+		virtual void OnBeginGrab(FUxtTargetId Target) override
+		{
+			Check(GrabbedTarget == 0, TEXT("Grab started twice"));
+			Check(Target == EnteredTarget, TEXT("Grab started on a target that is not focused"));
+			GrabbedTarget = Target;
+			++NumEvents;
+		}
+
+		virtual void OnEndGrab(FUxtTargetId Target) override
+		{
+			Check(GrabbedTarget == Target, TEXT("Grab ended on a target that was not grabbed"));
+			GrabbedTarget = 0;
+			++NumEvents;
+		}
+
+		virtual void OnBeginPoke(FUxtTargetId Target) override
+		{
+			Check(PokedTarget == 0, TEXT("Poke started twice"));
+			Check(Target == PokeFocusTarget, TEXT("Poke started on a target that is not focused"));
+			PokedTarget = Target;
+			++NumEvents;
+		}
+
+		virtual void OnUpdatePoke(FUxtTargetId Target) override
+		{
+			Check(PokedTarget != 0 && PokedTarget == Target, TEXT("Poke updated on a target that is not poked"));
+		}
+
+		virtual void OnEndPoke(FUxtTargetId Target) override
+		{
+			Check(PokedTarget != 0 && PokedTarget == Target, TEXT("Poke ended on a target that is not poked"));
+			PokedTarget = 0;
+			++NumEvents;
+		}
+
+		virtual void OnPokeTargetLost(FUxtTargetId Target) override
+		{
+			Check(PokedTarget != 0, TEXT("Poke target lost while not poking"));
+			PokedTarget = 0;
+			++NumEvents;
+		}
+
+		FAutomationTestBase& Test;
+		const FUxtFocusCore& Focus;
+
+		int32 Step = 0;
+		int32 NumErrors = 0;
+		int32 NumEvents = 0;
+
+		FUxtTargetId EnteredTarget = 0;
+		FUxtTargetId GrabbedTarget = 0;
+		FUxtTargetId PokedTarget = 0;
+		FUxtTargetId PokeFocusTarget = 0;
+	};
+}
+
+BEGIN_DEFINE_SPEC(NearInteractionCoreSpec, "UXTools.NearInteractionCore", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+END_DEFINE_SPEC(NearInteractionCoreSpec)
+
+void NearInteractionCoreSpec::Define()
+{
+	Describe("Focus core", [this]
+		{
+			It("should only update the closest point if focus is unchanged", [this]
+				{
+					FUxtFocusCore Focus;
+					FInvariantChecker Checker(*this, Focus);
+
+					Focus.SetFocus(1, 1, FVector(1, 0, 0), Checker);
+					Focus.SetFocus(1, 1, FVector(2, 0, 0), Checker);
+					TestEqual("Events", Checker.NumEvents, 1);
+					TestEqual("Closest point", Focus.GetClosestPoint(), FVector(2, 0, 0));
+
+					Focus.SetFocus(2, 2, FVector::ZeroVector, Checker);
+					TestEqual("Events", Checker.NumEvents, 3);
+					TestTrue("Second target entered", Checker.EnteredTarget == 2);
+				});
+
+			It("should not exit forgotten targets", [this]
+				{
+					FUxtFocusCore Focus;
+					FInvariantChecker Checker(*this, Focus);
+
+					Focus.SetFocus(1, 1, FVector::ZeroVector, Checker);
+					Focus.ForgetTarget();
+					Checker.EnteredTarget = 0;
+
+					Focus.ClearFocus(Checker);
+					TestEqual("Events", Checker.NumEvents, 1);
+				});
+		});
+
+	Describe("Simulated interactions", [this]
+		{
+			It("should keep transitions consistent along random trajectories", [this]
+				{
+					FRandomStream Stream(0x0048);
+					FSimulatedScene Scene(Stream, 16);
+
+					FUxtFocusCore GrabFocus;
+					FUxtFocusCore PokeFocus;
+					FUxtPokeCore Poke;
+					FInvariantChecker GrabChecker(*this, GrabFocus);
+					FInvariantChecker PokeChecker(*this, PokeFocus);
+
+					const int32 NumSteps = 200000;
+					const float ProximityRadius = 10.0f;
+					const float PokeRadius = 0.75f;
+					const float PokeDepth = 5.0f;
+
+					FVector Location = FVector::ZeroVector;
+					FVector Velocity = FVector::ZeroVector;
+					int32 NumPokes = 0;
+					int32 NumGrabs = 0;
+
+					const double StartTime = FPlatformTime::Seconds();
+					for (int32 Step = 0; Step < NumSteps; ++Step)
+					{
+						GrabChecker.Step = Step;
+						PokeChecker.Step = Step;
+
+						// Smooth random walk around the targets
+						Velocity = Velocity * 0.9f + Stream.GetUnitVector() * Stream.FRandRange(0, 0.5f);
+						Location = (Location + Velocity).BoundToCube(60.0f);
+
+						// Occasionally remove the poked or grabbed target, or bring back all targets
+						if (Stream.FRand() < 0.001f)
+						{
+							const FUxtTargetId Removed = Stream.FRand() < 0.5f ? PokeFocus.GetTarget() : GrabFocus.GetTarget();
+							if (Removed)
+							{
+								Scene.Boxes[Removed - 1].bRemoved = true;
+							}
+						}
+						else if (Stream.FRand() < 0.001f)
+						{
+							for (FSimulatedScene::FBoxTarget& Box : Scene.Boxes)
+							{
+								Box.bRemoved = false;
+							}
+						}
+
+						// Removed targets are dropped without events, as destroyed objects are by the near pointer
+						for (FUxtFocusCore* Focus : { &GrabFocus, &PokeFocus })
+						{
+							if (Focus->GetTarget() && Scene.GetBox(Focus->GetTarget()).bRemoved)
+							{
+								FInvariantChecker& Checker = Focus == &GrabFocus ? GrabChecker : PokeChecker;
+								Checker.EnteredTarget = 0;
+								Checker.GrabbedTarget = 0;
+								Focus->ForgetTarget();
+								Focus->ForgetPrimitive();
+							}
+						}
+
+						// Focus does not change while grabbing, as the grab target locks focus
+						if (!GrabFocus.IsGrabbing())
+						{
+							FVector ClosestPoint;
+							const FUxtTargetId Closest = Scene.FindClosest(Location, ProximityRadius, ClosestPoint);
+							if (Closest)
+							{
+								GrabFocus.SetFocus(Closest, Closest, ClosestPoint, GrabChecker);
+							}
+							else
+							{
+								GrabFocus.ClearFocus(GrabChecker);
+							}
+						}
+						// Poke targets lock focus while they are poked
+						if (!Poke.IsPoking())
+						{
+							FVector ClosestPoint;
+							const FUxtTargetId Closest = Scene.FindClosest(Location, ProximityRadius, ClosestPoint);
+							if (Closest)
+							{
+								PokeFocus.SetFocus(Closest, Closest, ClosestPoint, PokeChecker);
+							}
+							else
+							{
+								PokeFocus.ClearFocus(PokeChecker);
+							}
+						}
+
+						FUxtPokeCore::FInput Input;
+						Input.Target = PokeFocus.GetTarget();
+						Input.Primitive = PokeFocus.GetPrimitive();
+						Input.Location = Location;
+						Input.Radius = PokeRadius;
+						Input.Depth = PokeDepth;
+						PokeChecker.PokeFocusTarget = Input.Target;
+
+						const bool bWasPoking = Poke.IsPoking();
+						Poke.Update(Input, Scene, PokeChecker);
+						NumPokes += (!bWasPoking && Poke.IsPoking()) ? 1 : 0;
+
+						// Random grab gestures, only changes of the hand state are passed to the core
+						const bool bHandIsGrabbing = (Step / 50) % 3 == 0 ? Stream.FRand() < 0.9f : Stream.FRand() < 0.1f;
+						if (bHandIsGrabbing != GrabFocus.IsGrabbing())
+						{
+							if (bHandIsGrabbing)
+							{
+								GrabFocus.BeginGrab(GrabChecker);
+								NumGrabs += GrabFocus.GetTarget() ? 1 : 0;
+							}
+							else
+							{
+								GrabFocus.EndGrab(GrabChecker);
+							}
+						}
+
+						GrabChecker.Check(GrabFocus.GetTarget() != 0 || GrabChecker.GrabbedTarget == 0, TEXT("Grabbed target is not focused"));
+						PokeChecker.Check(Poke.IsPoking() == (PokeChecker.PokedTarget != 0), TEXT("Poke state does not match events"));
+					}
+					const double WallSeconds = FPlatformTime::Seconds() - StartTime;
+
+					if (GrabFocus.IsGrabbing())
+					{
+						GrabFocus.EndGrab(GrabChecker);
+					}
+					GrabFocus.ClearFocus(GrabChecker);
+					PokeFocus.ClearFocus(PokeChecker);
+
+					TestEqual("Errors", GrabChecker.NumErrors + PokeChecker.NumErrors, 0);
+					TestTrue("Focus is balanced", GrabChecker.EnteredTarget == 0 && PokeChecker.EnteredTarget == 0);
+					TestTrue("Grab is balanced", GrabChecker.GrabbedTarget == 0);
+					TestTrue("Targets were poked", NumPokes > 0);
+					TestTrue("Targets were grabbed", NumGrabs > 0);
+
+					AddInfo(FString::Printf(TEXT("Simulated %d steps with %d pokes and %d grabs in %.1f ms, %.0f steps per second"),
+						NumSteps, NumPokes, NumGrabs, WallSeconds * 1000.0, NumSteps / FMath::Max(WallSeconds, 1.0e-6)));
+				});
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
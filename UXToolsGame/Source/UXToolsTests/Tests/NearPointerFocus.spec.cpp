@@ -9,6 +9,7 @@
 #include "EngineUtils.h"
 
 #include "PointerTestSequence.h"
+#include "UxtFixedStepWorld.h"
 #include "UxtTestHandTracker.h"
 #include "UxtTestUtils.h"
 
@@ -18,6 +19,7 @@ using namespace UxtPointerTests;
 
 BEGIN_DEFINE_SPEC(NearPointerFocusSpec, "UXTools.NearPointer", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
 
+	FUxtFixedStepWorld StepWorld;
 	PointerTestSequence Sequence;
 
 	const int NumPointers = 2;
@@ -32,40 +34,29 @@ void NearPointerFocusSpec::Define()
 		{
 			BeforeEach([this]
 				{
-					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
-
-					UWorld* World = UxtTestUtils::GetTestWorld();
-
-					UxtTestUtils::EnableTestHandTracker();
+					UWorld* World = StepWorld.Create();
 
 					Sequence.Init(World, NumPointers);
-
-					// Register all new components.
-					World->UpdateWorldComponents(false, false);
 				});
 
 			AfterEach([this]
 				{
-					UxtTestUtils::DisableTestHandTracker();
-
 					Sequence.Reset();
 
-					// Force GC so that destroyed actors are removed from the world.
-					// Running multiple tests will otherwise cause errors when creating duplicate actors.
-					GEngine->ForceGarbageCollection();
+					StepWorld.Destroy();
 				});
 
-			LatentIt("should have no focus without targets", [this](const FDoneDelegate& Done)
+			It("should have no focus without targets", [this]
 				{
 					Sequence.AddMovementKeyframe(pStart);
 					Sequence.ExpectFocusTargetNone();
 
-					Sequence.EnqueueFrames(this, Done);
+					Sequence.Run(this, StepWorld);
 				});
 
-			LatentIt("should focus single target", [this](const FDoneDelegate& Done)
+			It("should focus single target", [this]
 				{
-					UWorld* World = UxtTestUtils::GetTestWorld();
+					UWorld* World = StepWorld.GetWorld();
 					FVector p1(120, -20, -5);
 					Sequence.AddTarget(World, p1);
 
@@ -76,12 +67,12 @@ void NearPointerFocusSpec::Define()
 					Sequence.AddMovementKeyframe(pEnd);
 					Sequence.ExpectFocusTargetNone();
 
-					Sequence.EnqueueFrames(this, Done);
+					Sequence.Run(this, StepWorld);
 				});
 
-			LatentIt("should focus two separate targets", [this](const FDoneDelegate& Done)
+			It("should focus two separate targets", [this]
 				{
-					UWorld* World = UxtTestUtils::GetTestWorld();
+					UWorld* World = StepWorld.GetWorld();
 					FVector p1(120, -40, -5);
 					FVector p2(100, 30, 15);
 					Sequence.AddTarget(World, p1);
@@ -96,12 +87,12 @@ void NearPointerFocusSpec::Define()
 					Sequence.AddMovementKeyframe(pEnd);
 					Sequence.ExpectFocusTargetNone();
 
-					Sequence.EnqueueFrames(this, Done);
+					Sequence.Run(this, StepWorld);
 				});
 
-			LatentIt("should focus two overlapping targets", [this](const FDoneDelegate& Done)
+			It("should focus two overlapping targets", [this]
 				{
-					UWorld* World = UxtTestUtils::GetTestWorld();
+					UWorld* World = StepWorld.GetWorld();
 					FVector p1(110, 4, -5);
 					FVector p2(115, 12, -2);
 					Sequence.AddTarget(World, p1);
@@ -116,7 +107,7 @@ void NearPointerFocusSpec::Define()
 					Sequence.AddMovementKeyframe(pEnd);
 					Sequence.ExpectFocusTargetNone();
 
-					Sequence.EnqueueFrames(this, Done);
+					Sequence.Run(this, StepWorld);
 				});
 		});
 }
@@ -11,6 +11,7 @@
 #include "Input/UxtHandInteractionActor.h"
 #include "Input/UxtNearPointerComponent.h"
 #include "PointerTestSequence.h"
+#include "UxtFixedStepWorld.h"
 #include "UxtTestHandTracker.h"
 #include "UxtTestUtils.h"
 
@@ -20,6 +21,7 @@ using namespace UxtPointerTests;
 
 BEGIN_DEFINE_SPEC(NearPointerGrabSpec, "UXTools.NearPointer", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
 
+	FUxtFixedStepWorld StepWorld;
 	PointerTestSequence Sequence;
 
 	const int NumPointers = 2;
@@ -27,6 +29,8 @@ BEGIN_DEFINE_SPEC(NearPointerGrabSpec, "UXTools.NearPointer", EAutomationTestFla
 	const FVector pInside = FVector(113, -24, -8);
 	const FVector pOutside = FVector(150, 40, -40);
 
+	TArray<FTestGrabTargetEvent> EventLog;
+
 END_DEFINE_SPEC(NearPointerGrabSpec)
 
 void NearPointerGrabSpec::Define()
@@ -35,33 +39,22 @@ void NearPointerGrabSpec::Define()
 		{
 			BeforeEach([this]
 				{
-					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
-
-					UWorld* World = UxtTestUtils::GetTestWorld();
-
-					UxtTestUtils::EnableTestHandTracker();
+					UWorld* World = StepWorld.Create();
 
 					Sequence.Init(World, NumPointers);
-
-					// Register all new components.
-					World->UpdateWorldComponents(false, false);
 				});
 
 			AfterEach([this]
 				{
-					UxtTestUtils::DisableTestHandTracker();
-
 					Sequence.Reset();
 
-					// Force GC so that destroyed actors are removed from the world.
-					// Running multiple tests will otherwise cause errors when creating duplicate actors.
-					GEngine->ForceGarbageCollection();
+					StepWorld.Destroy();
 				});
 
 
-			LatentIt("should focus target when overlapping initially", [this](const FDoneDelegate& Done)
+			It("should focus target when overlapping initially", [this]
 				{
-					UWorld* World = UxtTestUtils::GetTestWorld();
+					UWorld* World = StepWorld.GetWorld();
 					Sequence.AddTarget(World, pTarget);
 
 					Sequence.AddMovementKeyframe(pInside);
@@ -71,12 +64,12 @@ void NearPointerGrabSpec::Define()
 
 					Sequence.AddGrabKeyframe(false);
 
-					Sequence.EnqueueFrames(this, Done);
+					Sequence.Run(this, StepWorld);
 				});
 
-			LatentIt("should focus target when entering", [this](const FDoneDelegate& Done)
+			It("should focus target when entering", [this]
 				{
-					UWorld* World = UxtTestUtils::GetTestWorld();
+					UWorld* World = StepWorld.GetWorld();
 					Sequence.AddTarget(World, pTarget);
 
 					Sequence.AddMovementKeyframe(pOutside);
@@ -92,7 +85,64 @@ void NearPointerGrabSpec::Define()
 
 					Sequence.AddGrabKeyframe(false);
 
-					Sequence.EnqueueFrames(this, Done);
+					Sequence.Run(this, StepWorld);
+				});
+
+			It("should raise events in order", [this]
+				{
+					UWorld* World = StepWorld.GetWorld();
+					const FVector p1(120, -40, -5);
+					const FVector p2(100, 30, 15);
+					Sequence.AddTarget(World, p1);
+					Sequence.AddTarget(World, p2);
+
+					EventLog.Empty();
+					for (UTestGrabTarget* Target : Sequence.GetTargets())
+					{
+						Target->EventLog = &EventLog;
+					}
+
+					Sequence.AddMovementKeyframe(p1);
+					Sequence.ExpectFocusTargetIndex(0);
+					Sequence.AddGrabKeyframe(true);
+					Sequence.AddGrabKeyframe(false);
+					Sequence.AddMovementKeyframe(p2);
+					Sequence.ExpectFocusTargetIndex(1);
+					Sequence.AddMovementKeyframe(pOutside);
+					Sequence.ExpectFocusTargetNone();
+
+					Sequence.Run(this, StepWorld);
+
+					// Each pointer exits the old target before entering the new one.
+					// Grab events are raised while the pointer is not grabbing: begin before the grab state is set, end after it is cleared.
+					const UObject* Target0 = Sequence.GetTargets()[0];
+					const UObject* Target1 = Sequence.GetTargets()[1];
+					const TArray<TPair<const UObject*, FName>> Expected = {
+						{ Target0, TEXT("EnterFocus") },
+						{ Target0, TEXT("BeginGrab") },
+						{ Target0, TEXT("EndGrab") },
+						{ Target0, TEXT("ExitFocus") },
+						{ Target1, TEXT("EnterFocus") },
+						{ Target1, TEXT("ExitFocus") },
+					};
+
+					for (const UUxtNearPointerComponent* Pointer : Sequence.GetPointers())
+					{
+						TArray<FTestGrabTargetEvent> PointerEvents = EventLog.FilterByPredicate([Pointer](const FTestGrabTargetEvent& Event) { return Event.Pointer == Pointer; });
+						if (!TestEqual(TEXT("Number of events"), PointerEvents.Num(), Expected.Num()))
+						{
+							continue;
+						}
+
+						for (int i = 0; i < Expected.Num(); ++i)
+						{
+							const FTestGrabTargetEvent& Event = PointerEvents[i];
+							const FString What = FString::Printf(TEXT("Event %d: %s"), i, *Expected[i].Value.ToString());
+							TestTrue(What + TEXT(" target"), Event.Target == Expected[i].Key);
+							TestTrue(What + TEXT(" name"), Event.Name == Expected[i].Value);
+							TestFalse(What + TEXT(" pointer grabbing"), Event.bPointerIsGrabbing);
+						}
+					}
 				});
 		});
 }
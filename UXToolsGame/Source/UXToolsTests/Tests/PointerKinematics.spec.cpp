@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+
+#include "Interactions/UxtPointerKinematics.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(PointerKinematicsSpec, "UXTools.PointerKinematics", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	FUxtPointerKinematics Kinematics;
+
+END_DEFINE_SPEC(PointerKinematicsSpec)
+
+void PointerKinematicsSpec::Define()
+{
+	Describe("Pointer kinematics", [this]
+		{
+			BeforeEach([this]
+				{
+					Kinematics.Reset();
+				});
+
+			It("should not estimate velocity from a single sample", [this]
+				{
+					Kinematics.AddSample(1.0f, FTransform::Identity);
+
+					FVector Velocity;
+					TestFalse(TEXT("Linear velocity valid"), Kinematics.GetLinearVelocity(0.1f, Velocity));
+					TestEqual(TEXT("Linear velocity"), Velocity, FVector::ZeroVector);
+					TestFalse(TEXT("Angular velocity valid"), Kinematics.GetAngularVelocity(0.1f, Velocity));
+				});
+
+			It("should estimate constant linear velocity", [this]
+				{
+					const FVector Velocity(10, -20, 5);
+					for (int i = 0; i < 10; ++i)
+					{
+						const float Time = 100.0f + i / 60.0f;
+						Kinematics.AddSample(Time, FTransform(Velocity * (Time - 100.0f)));
+					}
+
+					FVector Estimate;
+					TestTrue(TEXT("Linear velocity valid"), Kinematics.GetLinearVelocity(0.1f, Estimate));
+					TestTrue(TEXT("Linear velocity"), Estimate.Equals(Velocity, 0.1f));
+				});
+
+			It("should estimate constant angular velocity", [this]
+				{
+					const FVector Axis = FVector(1, 2, 3).GetSafeNormal();
+					const float Speed = 2.0f;
+					for (int i = 0; i < 10; ++i)
+					{
+						const float Time = i / 60.0f;
+						Kinematics.AddSample(Time, FTransform(FQuat(Axis, Speed * Time)));
+					}
+
+					FVector Estimate;
+					TestTrue(TEXT("Angular velocity valid"), Kinematics.GetAngularVelocity(0.1f, Estimate));
+					TestTrue(TEXT("Angular velocity"), Estimate.Equals(Axis * Speed, 0.01f));
+				});
+
+			It("should only use samples inside the time window", [this]
+				{
+					// Fast motion that stops, followed by a resting period longer than the window.
+					for (int i = 0; i < 5; ++i)
+					{
+						Kinematics.AddSample(i / 60.0f, FTransform(FVector(i * 100.0f, 0, 0)));
+					}
+					for (int i = 5; i < 15; ++i)
+					{
+						Kinematics.AddSample(i / 60.0f, FTransform(FVector(400.0f, 0, 0)));
+					}
+
+					FVector Estimate;
+					TestTrue(TEXT("Linear velocity valid"), Kinematics.GetLinearVelocity(0.1f, Estimate));
+					TestTrue(TEXT("Linear velocity"), Estimate.IsNearlyZero(0.01f));
+				});
+
+			It("should keep a fixed number of samples", [this]
+				{
+					for (int i = 0; i < FUxtPointerKinematics::Capacity * 2; ++i)
+					{
+						Kinematics.AddSample(i, FTransform(FVector(i, 0, 0)));
+					}
+
+					TestEqual(TEXT("Number of samples"), Kinematics.Num(), FUxtPointerKinematics::Capacity);
+					TestEqual(TEXT("Latest time"), Kinematics.GetLatestTime(), FUxtPointerKinematics::Capacity * 2.0f - 1.0f);
+				});
+
+			It("should replace samples with the same timestamp", [this]
+				{
+					Kinematics.AddSample(0.0f, FTransform(FVector(0, 0, 0)));
+					Kinematics.AddSample(1.0f, FTransform(FVector(5, 0, 0)));
+					Kinematics.AddSample(1.0f, FTransform(FVector(1, 0, 0)));
+
+					FVector Estimate;
+					TestEqual(TEXT("Number of samples"), Kinematics.Num(), 2);
+					TestTrue(TEXT("Linear velocity valid"), Kinematics.GetLinearVelocity(10.0f, Estimate));
+					TestTrue(TEXT("Linear velocity"), Estimate.Equals(FVector(1, 0, 0), 0.001f));
+				});
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -4,6 +4,7 @@
 #include "PointerTestSequence.h"
 
 #include "Input/UxtNearPointerComponent.h"
+#include "UxtFixedStepWorld.h"
 #include "UxtTestUtils.h"
 #include "UxtTestHandTracker.h"
 
@@ -19,6 +20,7 @@ void UTestGrabTarget::BeginPlay()
 
 void UTestGrabTarget::OnEnterGrabFocus_Implementation(UUxtNearPointerComponent* Pointer)
 {
+	LogEvent(TEXT("EnterFocus"), Pointer);
 	++BeginFocusCount;
 }
 
@@ -28,6 +30,7 @@ void UTestGrabTarget::OnUpdateGrabFocus_Implementation(UUxtNearPointerComponent*
 
 void UTestGrabTarget::OnExitGrabFocus_Implementation(UUxtNearPointerComponent* Pointer)
 {
+	LogEvent(TEXT("ExitFocus"), Pointer);
 	++EndFocusCount;
 }
 
@@ -38,6 +41,7 @@ bool UTestGrabTarget::IsGrabFocusable_Implementation(const UPrimitiveComponent*
 
 void UTestGrabTarget::OnBeginGrab_Implementation(UUxtNearPointerComponent* Pointer)
 {
+	LogEvent(TEXT("BeginGrab"), Pointer);
 	++BeginGrabCount;
 
 	if (bUseFocusLock)
@@ -48,6 +52,7 @@ void UTestGrabTarget::OnBeginGrab_Implementation(UUxtNearPointerComponent* Point
 
 void UTestGrabTarget::OnEndGrab_Implementation(UUxtNearPointerComponent* Pointer)
 {
+	LogEvent(TEXT("EndGrab"), Pointer);
 	++EndGrabCount;
 
 	if (bUseFocusLock)
@@ -56,12 +61,20 @@ void UTestGrabTarget::OnEndGrab_Implementation(UUxtNearPointerComponent* Pointer
 	}
 }
 
+void UTestGrabTarget::LogEvent(FName Name, UUxtNearPointerComponent* Pointer)
+{
+	if (EventLog)
+	{
+		EventLog->Add({ this, Pointer, Name, Pointer->IsGrabbing() });
+	}
+}
+
 namespace UxtPointerTests
 {
 
 	void PointerTestSequence::Init(UWorld* World, int NumPointers)
 	{
-		FrameQueue.Init(World->GetGameInstance()->TimerManager);
+		FrameQueue.Init(&World->GetTimerManager());
 
 		Pointers.SetNum(NumPointers);
 		for (int i = 0; i < NumPointers; ++i)
@@ -261,4 +274,21 @@ namespace UxtPointerTests
 		}
 	}
 
+	void PointerTestSequence::Run(FAutomationTestBase* Test, FUxtFixedStepWorld& StepWorld)
+	{
+		const TArray<TargetEventCountMap> EventCountSequence = ComputeTargetEventCounts();
+
+		for (int iKeyframe = 0; iKeyframe < Keyframes.Num(); ++iKeyframe)
+		{
+			const PointerKeyframe& Keyframe = Keyframes[iKeyframe];
+			StepWorld.GetHandTracker().TestPosition = Keyframe.Location;
+			StepWorld.GetHandTracker().bIsGrabbing = Keyframe.bIsGrabbing;
+
+			// Pointers update overlaps and raise events in the next frame.
+			StepWorld.Step();
+
+			TestKeyframe(Test, EventCountSequence[iKeyframe], iKeyframe);
+		}
+	}
+
 }
@@ -13,8 +13,18 @@
 #include "PointerTestSequence.generated.h"
 
 class UUxtNearPointerComponent;
+class FUxtFixedStepWorld;
 class FUxtTestHandTracker;
 
+/** Event raised on a grab test target, with the grab state of the pointer when it was raised. */
+struct FTestGrabTargetEvent
+{
+	const UObject* Target;
+	const UUxtNearPointerComponent* Pointer;
+	FName Name;
+	bool bPointerIsGrabbing;
+};
+
 /**
  * Target for grab tests that counts grab events.
  */
@@ -47,6 +57,13 @@ public:
 	// If the target should enable focus lock on the pointer while grabbed.
 	bool bUseFocusLock = false;
 
+	// Optional log shared between targets to test the order of events.
+	TArray<FTestGrabTargetEvent>* EventLog = nullptr;
+
+private:
+
+	void LogEvent(FName Name, UUxtNearPointerComponent* Pointer);
+
 };
 
 namespace UxtPointerTests
@@ -104,6 +121,9 @@ namespace UxtPointerTests
 
 		void EnqueueFrames(FAutomationTestBase* Test, const FDoneDelegate& Done);
 
+		/** Run all keyframes synchronously in a fixed step world, testing event counts after each frame. */
+		void Run(FAutomationTestBase* Test, FUxtFixedStepWorld& StepWorld);
+
 	private:
 
 		PointerKeyframe& CreateKeyframe();
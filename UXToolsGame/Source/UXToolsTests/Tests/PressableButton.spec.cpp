@@ -7,6 +7,7 @@
 #include "UxtTestHandTracker.h"
 
 #include "Controls/UxtPressableButtonComponent.h"
+#include "Controls/UxtPressableButtonSubsystem.h"
 #include "Utils/UxtFunctionLibrary.h"
 #include "UxtTestUtils.h"
 #include "Input/UxtNearPointerComponent.h"
@@ -64,6 +65,9 @@ BEGIN_DEFINE_SPEC(PressableButtonSpec, "UXTools.PressableButtonTest", EAutomatio
 	void EnqueuePressReleaseTest(const TTuple<FVector, FVector, FVector> FramePositions, bool bExpectingPress, bool bExpectingRelease);
 	void EnqueueMoveButtonTest(const TTuple<FVector, FVector, FVector> FramePositions, bool bExpectingPress, bool bExpectingRelease);
 	void EnqueueTwoButtonsTest(const FVector StartingPos);
+	void EnqueueSleepTest();
+	void EnqueueCustomPrimitiveDataTest();
+	void EnqueueSampleTimeTest();
 
 	UUxtPressableButtonComponent* Button;
 	UUxtPressableButtonComponent* SecondButton;
@@ -74,6 +78,9 @@ BEGIN_DEFINE_SPEC(PressableButtonSpec, "UXTools.PressableButtonTest", EAutomatio
 
 	const float MoveBy = 10;
 
+	/** Frames to wait at most for a released button to recover and go to sleep. */
+	const int32 MaxRecoveryFrames = 60;
+
 END_DEFINE_SPEC(PressableButtonSpec)
 
 void PressableButtonSpec::Define()
@@ -234,6 +241,24 @@ void PressableButtonSpec::Define()
 
 					FrameQueue.Enqueue([Done] { Done.Execute(); });
 				});
+
+			LatentIt("should only update the button while a pointer interacts with it", [this](const FDoneDelegate& Done)
+				{
+					EnqueueSleepTest();
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			LatentIt("should write the push distance to custom primitive data without moving the visuals", [this](const FDoneDelegate& Done)
+				{
+					EnqueueCustomPrimitiveDataTest();
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
+
+			LatentIt("should time the press between hand samples", [this](const FDoneDelegate& Done)
+				{
+					EnqueueSampleTimeTest();
+					FrameQueue.Enqueue([Done] { Done.Execute(); });
+				});
 		});
 }
 
@@ -417,5 +442,127 @@ void PressableButtonSpec::EnqueueTwoButtonsTest(const FVector StartingPos)
 		});
 }
 
-#endif // WITH_DEV_AUTOMATION_TESTS
+void PressableButtonSpec::EnqueueSleepTest()
+{
+	const FVector FarAway = Center + FVector(0, 1000, 0);
+
+	// move out of reach
+	FrameQueue.Enqueue([this, FarAway]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = FarAway;
+		});
+	FrameQueue.Skip();
+
+	// test idle button is asleep and move in front of the button
+	FrameQueue.Enqueue([this]
+		{
+			UUxtPressableButtonSubsystem* ButtonSet = UxtTestUtils::GetTestWorld()->GetSubsystem<UUxtPressableButtonSubsystem>();
+			TestEqual("Registered buttons", ButtonSet->GetNumButtons(), 1);
+			TestEqual("Awake buttons", ButtonSet->GetNumAwakeButtons(), 0);
+
+			UxtTestUtils::GetTestHandTracker().TestPosition = Center + (FVector::BackwardVector * MoveBy);
+		});
+	// press
+	FrameQueue.Enqueue([this]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = Center;
+		});
+
+	// Skip a frame for poke because of tick ordering issue.
+	FrameQueue.Skip();
+
+	// test button is awake and move out of reach
+	FrameQueue.Enqueue([this, FarAway]
+		{
+			UUxtPressableButtonSubsystem* ButtonSet = UxtTestUtils::GetTestWorld()->GetSubsystem<UUxtPressableButtonSubsystem>();
+			TestTrue("Button is pressed", Button->IsPressed());
+			TestEqual("Awake buttons", ButtonSet->GetNumAwakeButtons(), 1);
+
+			UxtTestUtils::GetTestHandTracker().TestPosition = FarAway;
+		});
+
+	// wait for the button to recover, how many frames that takes depends on the frame rate
+	TSharedRef<int32> FramesUntilAsleep = MakeShared<int32>(INDEX_NONE);
+	for (int32 Frame = 0; Frame < MaxRecoveryFrames; ++Frame)
+	{
+		FrameQueue.Enqueue([this, FramesUntilAsleep, Frame]
+			{
+				UUxtPressableButtonSubsystem* ButtonSet = UxtTestUtils::GetTestWorld()->GetSubsystem<UUxtPressableButtonSubsystem>();
+				if (*FramesUntilAsleep == INDEX_NONE && ButtonSet->GetNumAwakeButtons() == 0)
+				{
+					*FramesUntilAsleep = Frame;
+				}
+			});
+	}
 
+	// test button has recovered and went back to sleep
+	FrameQueue.Enqueue([this, FramesUntilAsleep]
+		{
+			UUxtPressableButtonSubsystem* ButtonSet = UxtTestUtils::GetTestWorld()->GetSubsystem<UUxtPressableButtonSubsystem>();
+			TestFalse("Button is pressed", Button->IsPressed());
+			TestEqual("Released count", EventCaptureObj->ReleasedCount, 1);
+			TestTrue("Button went to sleep", *FramesUntilAsleep != INDEX_NONE);
+			TestEqual("Awake buttons", ButtonSet->GetNumAwakeButtons(), 0);
+		});
+}
+
+void PressableButtonSpec::EnqueueCustomPrimitiveDataTest()
+{
+	Button->PushVisualsMode = EUxtPushVisualsMode::CustomPrimitiveData;
+	Button->PushCustomDataIndex = 1;
+	const FVector VisualsLocation = Button->GetVisuals()->GetComponentLocation();
+
+	// move in front of the button
+	FrameQueue.Enqueue([this]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = Center + (FVector::BackwardVector * MoveBy);
+		});
+	// press
+	FrameQueue.Enqueue([this]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = Center;
+		});
+
+	// Skip a frame for poke because of tick ordering issue.
+	FrameQueue.Skip();
+
+	// test push is in custom data and visuals did not move
+	FrameQueue.Enqueue([this, VisualsLocation]
+		{
+			const UPrimitiveComponent* Visuals = Cast<UPrimitiveComponent>(Button->GetVisuals());
+			const TArray<float>& CustomData = Visuals->GetCustomPrimitiveData().Data;
+
+			TestTrue("Button is pressed", Button->IsPressed());
+			TestTrue("Custom data is set", CustomData.Num() > 1 && CustomData[1] > 0);
+			TestEqual("Visuals location", Visuals->GetComponentLocation(), VisualsLocation);
+		});
+}
+
+void PressableButtonSpec::EnqueueSampleTimeTest()
+{
+	// move in front of the button
+	FrameQueue.Enqueue([this]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = Center + (FVector::BackwardVector * MoveBy);
+			UxtTestUtils::GetTestHandTracker().TestSampleTime = 10.0;
+		});
+	// press
+	FrameQueue.Enqueue([this]
+		{
+			UxtTestUtils::GetTestHandTracker().TestPosition = Center;
+			UxtTestUtils::GetTestHandTracker().TestSampleTime = 10.1;
+		});
+
+	// Skip a frame for poke because of tick ordering issue.
+	FrameQueue.Skip();
+
+	// test press time lies between the two samples
+	FrameQueue.Enqueue([this]
+		{
+			TestTrue("Button is pressed", Button->IsPressed());
+			TestTrue("Press time is after the previous sample", Button->GetLastPressedTime() > 10.0);
+			TestTrue("Press time is before the current sample", Button->GetLastPressedTime() < 10.1);
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
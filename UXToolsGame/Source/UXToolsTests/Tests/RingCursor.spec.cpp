@@ -0,0 +1,132 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#include "Controls/UxtRingCursorComponent.h"
+#include "UxtTestUtils.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	UUxtRingCursorComponent* CreateTestComponent(UWorld* World, bool bUseCustomPrimitiveData)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		UUxtRingCursorComponent* Cursor = NewObject<UUxtRingCursorComponent>(Actor);
+		Cursor->bUseCustomPrimitiveData = bUseCustomPrimitiveData;
+		Actor->SetRootComponent(Cursor);
+		Cursor->RegisterComponent();
+
+		return Cursor;
+	}
+
+	float GetData(const UUxtRingCursorComponent* Cursor, int32 Index)
+	{
+		const TArray<float>& Data = Cursor->GetCustomPrimitiveData().Data;
+		return Data.IsValidIndex(Index) ? Data[Index] : 0.0f;
+	}
+}
+
+BEGIN_DEFINE_SPEC(RingCursorSpec, "UXTools.RingCursor", EAutomationTestFlags::ProductFilter | EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext)
+
+	UUxtRingCursorComponent* Cursor;
+
+END_DEFINE_SPEC(RingCursorSpec)
+
+void RingCursorSpec::Define()
+{
+	Describe("Ring cursor with custom primitive data", [this]
+		{
+			BeforeEach([this]
+				{
+					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+					Cursor = CreateTestComponent(UxtTestUtils::GetTestWorld(), true);
+					Cursor->SetRadius(2.0f);
+				});
+
+			AfterEach([this]
+				{
+					Cursor->GetOwner()->Destroy();
+					Cursor = nullptr;
+
+					// Force GC so that destroyed actors are removed from the world.
+					GEngine->ForceGarbageCollection();
+				});
+
+			It("should not create a material instance", [this]
+				{
+					TestFalse("Material is a dynamic instance", Cursor->GetMaterial(0) && Cursor->GetMaterial(0)->IsA<UMaterialInstanceDynamic>());
+				});
+
+			It("should write all parameters", [this]
+				{
+					TestEqual("Inverse radius", GetData(Cursor, 0), 0.5f);
+					TestEqual("Inner radius", GetData(Cursor, 1), 1.0f - Cursor->GetRingThickness());
+					TestEqual("Border thickness", GetData(Cursor, 2), Cursor->GetBorderThickness());
+
+					const FLinearColor RingColor(Cursor->GetRingColor());
+					TestEqual("Ring color red", GetData(Cursor, 3), RingColor.R);
+					TestEqual("Ring color alpha", GetData(Cursor, 6), RingColor.A);
+
+					const FLinearColor BorderColor(Cursor->GetBorderColor());
+					TestEqual("Border color red", GetData(Cursor, 7), BorderColor.R);
+					TestEqual("Border color alpha", GetData(Cursor, 10), BorderColor.A);
+				});
+
+			It("should update parameters when the radius changes", [this]
+				{
+					Cursor->SetRadius(4.0f);
+					TestEqual("Inverse radius", GetData(Cursor, 0), 0.25f);
+				});
+
+			It("should not write parameters for negligible changes", [this]
+				{
+					Cursor->SetRadius(2.0f * (1.0f + 1.0e-5f));
+					TestEqual("Inverse radius", GetData(Cursor, 0), 0.5f);
+				});
+
+			It("should update absolute thickness parameters with the radius", [this]
+				{
+					Cursor->SetUseAbsoluteThickness(true);
+					Cursor->SetBorderThickness(0.5f);
+					TestEqual("Border thickness", GetData(Cursor, 2), 0.25f);
+
+					Cursor->SetRadius(1.0f);
+					TestEqual("Border thickness", GetData(Cursor, 2), 0.5f);
+				});
+		});
+
+	Describe("Ring cursor with material instance", [this]
+		{
+			BeforeEach([this]
+				{
+					TestTrueExpr(AutomationOpenMap(TEXT("/Game/UXToolsGame/Tests/Maps/TestEmpty")));
+
+					Cursor = CreateTestComponent(UxtTestUtils::GetTestWorld(), false);
+				});
+
+			AfterEach([this]
+				{
+					Cursor->GetOwner()->Destroy();
+					Cursor = nullptr;
+					GEngine->ForceGarbageCollection();
+				});
+
+			It("should not write custom primitive data", [this]
+				{
+					Cursor->SetRadius(2.0f);
+					TestEqual("Custom primitive data", Cursor->GetCustomPrimitiveData().Data.Num(), 0);
+				});
+		});
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
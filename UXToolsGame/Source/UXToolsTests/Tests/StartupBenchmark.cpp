@@ -0,0 +1,152 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "CoreMinimal.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+#include "Controls/UxtFarBeamComponent.h"
+#include "Controls/UxtRingCursorComponent.h"
+#include "Utils/UxtDefaultAssets.h"
+#include "UxtFixedStepWorld.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const int32 NumConstructions = 100;
+
+	double ToMs(uint64 Cycles)
+	{
+		return FPlatformTime::ToMilliseconds64(Cycles);
+	}
+
+	AActor* SpawnCursorActor(UWorld* World, UUxtRingCursorComponent*& OutCursor, UUxtFarBeamComponent*& OutBeam)
+	{
+		AActor* Actor = World->SpawnActor<AActor>();
+
+		OutCursor = NewObject<UUxtRingCursorComponent>(Actor);
+		Actor->SetRootComponent(OutCursor);
+		OutCursor->RegisterComponent();
+
+		OutBeam = NewObject<UUxtFarBeamComponent>(Actor);
+		OutBeam->SetupAttachment(OutCursor);
+		OutBeam->RegisterComponent();
+
+		return Actor;
+	}
+}
+
+/**
+ * Measures the startup cost of components with default assets:
+ * - Module preload: the load started by the UXTools module after engine initialization, as recorded by the default assets.
+ * - Construction: component constructors, which run for the class default objects at module load.
+ * - Preload: starting the asynchronous load of the default assets, and waiting for it to complete.
+ * - First spawn: spawning the first cursor and beam, and the frames until their mesh is set.
+ *
+ * The default assets are released and garbage is collected first, so construction and preload are measured from a cold state.
+ * Default assets are often kept in memory by the editor anyway, run in a game process for load times, e.g.:
+ *   UE4Editor UXToolsGame.uproject -game -nullrhi -unattended -ExecCmds="Automation RunTests UXTools.Benchmark.Startup; Quit"
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FStartupBenchmark, "UXTools.Benchmark.Startup",
+	EAutomationTestFlags::EditorContext |
+	EAutomationTestFlags::ClientContext |
+	EAutomationTestFlags::PerfFilter)
+
+bool FStartupBenchmark::RunTest(const FString& Parameters)
+{
+	FUxtDefaultAssets& DefaultAssets = FUxtDefaultAssets::Get();
+
+	// The module starts the preload after engine initialization, it has completed by the time tests run
+	TestTrue("Default assets loaded by the module", DefaultAssets.IsLoaded());
+	const double ModulePreloadMs = DefaultAssets.GetLoadTimeMs();
+
+	// Release the assets, they stay in memory only if something else references them
+	DefaultAssets.Reset();
+	CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+	const bool bIsCold = !DefaultAssets.GetRingCursorMesh() && !DefaultAssets.GetBeamMesh();
+
+	uint64 StartCycles = FPlatformTime::Cycles64();
+	for (int32 Index = 0; Index < NumConstructions; ++Index)
+	{
+		NewObject<UUxtRingCursorComponent>(GetTransientPackage());
+		NewObject<UUxtFarBeamComponent>(GetTransientPackage());
+	}
+	const double ConstructionMs = ToMs(FPlatformTime::Cycles64() - StartCycles) / NumConstructions;
+
+	// Constructors must not load assets
+	TestFalse("Default assets loaded after construction", DefaultAssets.IsLoaded());
+	if (bIsCold)
+	{
+		TestNull("Ring cursor mesh after construction", DefaultAssets.GetRingCursorMesh());
+		TestNull("Beam mesh after construction", DefaultAssets.GetBeamMesh());
+	}
+
+	StartCycles = FPlatformTime::Cycles64();
+	DefaultAssets.Preload();
+	const double PreloadMs = ToMs(FPlatformTime::Cycles64() - StartCycles);
+
+	StartCycles = FPlatformTime::Cycles64();
+	DefaultAssets.WaitUntilLoaded();
+	const double WaitMs = ToMs(FPlatformTime::Cycles64() - StartCycles);
+
+	const double LoadMs = DefaultAssets.GetLoadTimeMs();
+
+	TestTrue("Default assets loaded", DefaultAssets.IsLoaded());
+	TestNotNull("Ring cursor mesh", DefaultAssets.GetRingCursorMesh());
+	TestNotNull("Beam mesh", DefaultAssets.GetBeamMesh());
+
+	FUxtFixedStepWorld StepWorld;
+	UWorld* World = StepWorld.Create();
+
+	UUxtRingCursorComponent* Cursor = nullptr;
+	UUxtFarBeamComponent* Beam = nullptr;
+	StartCycles = FPlatformTime::Cycles64();
+	AActor* Actor = SpawnCursorActor(World, Cursor, Beam);
+	const double FirstSpawnMs = ToMs(FPlatformTime::Cycles64() - StartCycles);
+
+	// Meshes are set on register once the default assets are loaded
+	int32 FramesUntilReady = 0;
+	while (!(Cursor->GetStaticMesh() && Beam->GetStaticMesh()) && FramesUntilReady < 60)
+	{
+		StepWorld.Step();
+		++FramesUntilReady;
+	}
+	TestEqual("Frames until meshes are set", FramesUntilReady, 0);
+	TestTrue("Cursor has the default mesh", Cursor->GetStaticMesh() == DefaultAssets.GetRingCursorMesh());
+	TestTrue("Beam has the default mesh", Beam->GetStaticMesh() == DefaultAssets.GetBeamMesh());
+
+	StartCycles = FPlatformTime::Cycles64();
+	AActor* SecondActor = SpawnCursorActor(World, Cursor, Beam);
+	const double SecondSpawnMs = ToMs(FPlatformTime::Cycles64() - StartCycles);
+
+	Actor->Destroy();
+	SecondActor->Destroy();
+	StepWorld.Destroy();
+
+	// Callbacks pending when the assets are released run after the next load, which also leaves the assets loaded for other tests
+	bool bCallbackCalled = false;
+	DefaultAssets.Reset();
+	DefaultAssets.CallWhenLoaded(GetTransientPackage(), [&bCallbackCalled] { bCallbackCalled = true; });
+	DefaultAssets.Reset();
+	DefaultAssets.Preload();
+	DefaultAssets.WaitUntilLoaded();
+	TestTrue("Default assets loaded at the end", DefaultAssets.IsLoaded());
+	TestTrue("Pending callback called after reset", bCallbackCalled);
+
+	AddInfo(FString::Printf(TEXT("Assets %s after release"), bIsCold ? TEXT("not in memory") : TEXT("still in memory")));
+	AddInfo(FString::Printf(TEXT("Construction: %.4f ms per cursor and beam"), ConstructionMs));
+	AddInfo(FString::Printf(TEXT("Preload: %.3f ms to start, %.3f ms waiting, %.3f ms until loaded"), PreloadMs, WaitMs, LoadMs));
+	AddInfo(FString::Printf(TEXT("Module preload: %.3f ms until loaded, %+.3f ms compared to the cold preload"),
+		ModulePreloadMs, ModulePreloadMs - LoadMs));
+	AddInfo(FString::Printf(TEXT("Spawn: %.3f ms first, %.3f ms second"), FirstSpawnMs, SecondSpawnMs));
+
+	return true;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,157 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "UxtBenchmarkRecorder.h"
+
+#include "CoreGlobals.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RenderCore.h"
+#include "Utils/UxtStats.h"
+
+namespace
+{
+	uint64 GetUsedMemory()
+	{
+		return FPlatformMemory::GetStats().UsedPhysical;
+	}
+
+	uint64 GetSceneQueries()
+	{
+		return FUxtCounterTotals::SceneQueries.Load();
+	}
+}
+
+void FUxtBenchmarkRecorder::Begin(const FString& InScenario)
+{
+	Scenario = InScenario;
+	Frames.Reset();
+
+	StartUsedMemory = GetUsedMemory();
+	FrameStartUsedMemory = StartUsedMemory;
+	FrameStartSceneQueries = GetSceneQueries();
+}
+
+void FUxtBenchmarkRecorder::RecordFrame()
+{
+	const uint64 UsedMemory = GetUsedMemory();
+	const uint64 SceneQueries = GetSceneQueries();
+
+	FUxtBenchmarkFrame& Frame = Frames.AddDefaulted_GetRef();
+	Frame.GameThreadMs = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Frame.UsedMemoryDelta = static_cast<int64>(UsedMemory) - static_cast<int64>(FrameStartUsedMemory);
+	Frame.NumSceneQueries = SceneQueries - FrameStartSceneQueries;
+
+	FrameStartUsedMemory = UsedMemory;
+	FrameStartSceneQueries = SceneQueries;
+}
+
+void FUxtBenchmarkRecorder::End()
+{
+	WriteResults();
+	Parameters.Reset();
+}
+
+double FUxtBenchmarkRecorder::GetAverageGameThreadMs() const
+{
+	double Sum = 0;
+	for (const FUxtBenchmarkFrame& Frame : Frames)
+	{
+		Sum += Frame.GameThreadMs;
+	}
+	return Frames.Num() > 0 ? Sum / Frames.Num() : 0;
+}
+
+double FUxtBenchmarkRecorder::GetMaxGameThreadMs() const
+{
+	double Max = 0;
+	for (const FUxtBenchmarkFrame& Frame : Frames)
+	{
+		Max = FMath::Max(Max, Frame.GameThreadMs);
+	}
+	return Max;
+}
+
+double FUxtBenchmarkRecorder::GetAverageUsedMemoryDelta() const
+{
+	double Sum = 0;
+	for (const FUxtBenchmarkFrame& Frame : Frames)
+	{
+		Sum += Frame.UsedMemoryDelta;
+	}
+	return Frames.Num() > 0 ? Sum / Frames.Num() : 0;
+}
+
+double FUxtBenchmarkRecorder::GetAverageSceneQueries() const
+{
+	double Sum = 0;
+	for (const FUxtBenchmarkFrame& Frame : Frames)
+	{
+		Sum += Frame.NumSceneQueries;
+	}
+	return Frames.Num() > 0 ? Sum / Frames.Num() : 0;
+}
+
+int64 FUxtBenchmarkRecorder::GetUsedMemoryGrowth() const
+{
+	return static_cast<int64>(FrameStartUsedMemory) - static_cast<int64>(StartUsedMemory);
+}
+
+void FUxtBenchmarkRecorder::SetParameter(const FString& Name, int32 Value)
+{
+	Parameters.Emplace(Name, Value);
+}
+
+void FUxtBenchmarkRecorder::CheckBudget(FAutomationTestBase& Test, double BaselineMs, double BudgetMs) const
+{
+	const float BudgetScale = GetBudgetScale();
+
+	const double AverageMs = GetAverageGameThreadMs();
+	const double CostMs = AverageMs - BaselineMs;
+	Test.AddInfo(FString::Printf(TEXT("%s: %.3f ms game thread (%.3f ms over baseline, max %.3f ms), %.1f scene queries per frame, %.1f KB process used physical memory delta (not only UXT allocations)"),
+		*Scenario, AverageMs, CostMs, GetMaxGameThreadMs(), GetAverageSceneQueries(), GetUsedMemoryGrowth() / 1024.0));
+
+	if (CostMs > BudgetMs * BudgetScale)
+	{
+		Test.AddError(FString::Printf(TEXT("%s exceeds its budget: %.3f ms over baseline, budget is %.3f ms"), *Scenario, CostMs, BudgetMs * BudgetScale));
+	}
+}
+
+float FUxtBenchmarkRecorder::GetCountScale()
+{
+	float CountScale = 1.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("UxtBenchmarkCountScale="), CountScale);
+	return FMath::Max(CountScale, 0.0f);
+}
+
+float FUxtBenchmarkRecorder::GetBudgetScale()
+{
+	float BudgetScale = 1.0f;
+	FParse::Value(FCommandLine::Get(), TEXT("UxtBenchmarkBudgetScale="), BudgetScale);
+	return BudgetScale;
+}
+
+void FUxtBenchmarkRecorder::WriteResults() const
+{
+	const FString BaseFilename = FPaths::Combine(FPaths::AutomationDir(), TEXT("UXTools"), TEXT("Benchmarks"), Scenario);
+
+	FString Csv = TEXT("Frame,GameThreadMs,ProcessUsedPhysicalDelta,SceneQueries\n");
+	for (int32 Index = 0; Index < Frames.Num(); ++Index)
+	{
+		const FUxtBenchmarkFrame& Frame = Frames[Index];
+		Csv += FString::Printf(TEXT("%d,%.4f,%lld,%llu\n"), Index, Frame.GameThreadMs, Frame.UsedMemoryDelta, Frame.NumSceneQueries);
+	}
+	FFileHelper::SaveStringToFile(Csv, *(BaseFilename + TEXT(".csv")));
+
+	FString Json = FString::Printf(TEXT("{\n\t\"Scenario\": \"%s\",\n"), *Scenario);
+	for (const TPair<FString, int32>& Parameter : Parameters)
+	{
+		Json += FString::Printf(TEXT("\t\"%s\": %d,\n"), *Parameter.Key, Parameter.Value);
+	}
+	Json += FString::Printf(TEXT("\t\"Frames\": %d,\n\t\"AverageGameThreadMs\": %.4f,\n\t\"MaxGameThreadMs\": %.4f,\n\t\"AverageSceneQueries\": %.2f,\n\t\"ProcessUsedPhysicalDelta\": %lld\n}\n"),
+		Frames.Num(), GetAverageGameThreadMs(), GetMaxGameThreadMs(), GetAverageSceneQueries(), GetUsedMemoryGrowth());
+	FFileHelper::SaveStringToFile(Json, *(BaseFilename + TEXT(".json")));
+}
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FAutomationTestBase;
+
+/** Measurements of a single benchmark frame. */
+struct FUxtBenchmarkFrame
+{
+	/** Game thread time of the frame in milliseconds. */
+	double GameThreadMs = 0;
+
+	/** Change of used physical memory of the process during the frame in bytes. */
+	int64 UsedMemoryDelta = 0;
+
+	/** Scene queries issued by UX Tools during the frame, see STAT_UxtSceneQueries. */
+	uint64 NumSceneQueries = 0;
+};
+
+/**
+ * Records per frame measurements of a benchmark scenario and writes them to
+ * Saved/Automation/UXTools/Benchmarks/<Scenario>.csv, with a summary in <Scenario>.json.
+ *
+ * Memory is the UsedPhysical delta of the process from the platform memory stats. It includes allocations of all threads,
+ * the engine and the OS, so it is not a measure of UXT allocations and is reported as ProcessUsedPhysicalDelta.
+ */
+class FUxtBenchmarkRecorder
+{
+public:
+
+	/** Start recording a scenario, discarding previous frames. Parameters set before are kept. */
+	void Begin(const FString& InScenario);
+
+	/** Record the frame that has just finished. Call once per frame while recording. */
+	void RecordFrame();
+
+	/** Stop recording, write the results and clear the parameters. */
+	void End();
+
+	int32 GetNumFrames() const { return Frames.Num(); }
+	double GetAverageGameThreadMs() const;
+	double GetMaxGameThreadMs() const;
+	double GetAverageUsedMemoryDelta() const;
+	double GetAverageSceneQueries() const;
+
+	/** Change of used physical memory from the start of the recording to the last recorded frame in bytes. */
+	int64 GetUsedMemoryGrowth() const;
+
+	/** Set a value describing the scenario, e.g. the number of spawned objects, to be written to the summary. */
+	void SetParameter(const FString& Name, int32 Value);
+
+	/**
+	 * Fail the test if the average game thread time exceeds the baseline time by more than the budget.
+	 * Budgets can be scaled with -UxtBenchmarkBudgetScale=<Scale> on the command line.
+	 */
+	void CheckBudget(FAutomationTestBase& Test, double BaselineMs, double BudgetMs) const;
+
+	/** Scale for the number of spawned objects, set with -UxtBenchmarkCountScale=<Scale> on the command line. */
+	static float GetCountScale();
+
+	/** Scale for budgets, set with -UxtBenchmarkBudgetScale=<Scale> on the command line. */
+	static float GetBudgetScale();
+
+private:
+
+	void WriteResults() const;
+
+	FString Scenario;
+	TArray<FUxtBenchmarkFrame> Frames;
+	TArray<TPair<FString, int32>> Parameters;
+
+	/** Used physical memory at the start of the recording and of the current frame. */
+	uint64 StartUsedMemory = 0;
+	uint64 FrameStartUsedMemory = 0;
+
+	/** Scene query total at the start of the current frame. */
+	uint64 FrameStartSceneQueries = 0;
+};
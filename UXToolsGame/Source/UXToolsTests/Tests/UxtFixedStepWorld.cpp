@@ -0,0 +1,127 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#include "UxtFixedStepWorld.h"
+
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/WorldSettings.h"
+#include "Misc/App.h"
+
+FUxtFixedStepWorld* FUxtFixedStepWorld::SteppingWorld = nullptr;
+
+FUxtFixedStepWorld::~FUxtFixedStepWorld()
+{
+	Destroy();
+}
+
+UWorld* FUxtFixedStepWorld::Create(float InDeltaSeconds)
+{
+	Destroy();
+
+	check(InDeltaSeconds > 0.0f);
+	DeltaSeconds = InDeltaSeconds;
+	FrameCount = 0;
+	HandTracker = FUxtTestHandTracker();
+
+	// Scene queries need a physics scene, everything else that is not needed by interactions is left out.
+	UWorld::InitializationValues IVS;
+	IVS.InitializeScenes(true)
+		.CreatePhysicsScene(true)
+		.ShouldSimulatePhysics(false)
+		.EnableTraceCollision(true)
+		.AllowAudioPlayback(false)
+		.RequiresHitProxies(false)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.CreateFXSystem(false)
+		.SetTransactional(false);
+
+	// Not informing the engine keeps the world out of the engine loop, it is only ticked by Step().
+	World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("UxtFixedStepWorld"), nullptr, true, ERHIFeatureLevel::Num, &IVS);
+
+	// Nothing else references the world, keep it alive while tests collect garbage.
+	World->AddToRoot();
+
+#if WITH_DEV_AUTOMATION_TESTS
+	FUxtHandTrackerScope HandTrackerScope(&HandTracker);
+#endif
+
+	FURL URL;
+	World->InitializeActorsForPlay(URL);
+	World->BeginPlay();
+
+	// There is no game mode to start the match, begin play on actors directly.
+	// Actors spawned after this begin play when spawned.
+	World->GetWorldSettings()->NotifyBeginPlay();
+
+	return World;
+}
+
+void FUxtFixedStepWorld::Destroy()
+{
+	if (!World)
+	{
+		return;
+	}
+
+#if WITH_DEV_AUTOMATION_TESTS
+	FUxtHandTrackerScope HandTrackerScope(&HandTracker);
+#endif
+
+	World->BeginTearingDown();
+
+	for (FActorIterator It(World); It; ++It)
+	{
+		It->RouteEndPlay(EEndPlayReason::Destroyed);
+	}
+
+	World->DestroyWorld(false);
+	World->RemoveFromRoot();
+	World = nullptr;
+}
+
+void FUxtFixedStepWorld::Step(int32 NumFrames)
+{
+	check(World);
+	check(IsInGameThread());
+	checkf(SteppingWorld == nullptr, TEXT("Fixed step worlds can not be stepped from within another world's step"));
+	SteppingWorld = this;
+
+	const double SavedCurrentTime = FApp::GetCurrentTime();
+	const double SavedDeltaTime = FApp::GetDeltaTime();
+
+#if WITH_DEV_AUTOMATION_TESTS
+	FUxtHandTrackerScope HandTrackerScope(&HandTracker);
+#endif
+
+	for (int32 Frame = 0; Frame < NumFrames; ++Frame)
+	{
+		// Tick functions and timers run at most once per engine frame.
+		++GFrameCounter;
+		++FrameCount;
+
+		FApp::SetDeltaTime(DeltaSeconds);
+		FApp::SetCurrentTime(FrameCount * static_cast<double>(DeltaSeconds));
+
+		World->Tick(LEVELTICK_All, DeltaSeconds);
+	}
+
+	FApp::SetCurrentTime(SavedCurrentTime);
+	FApp::SetDeltaTime(SavedDeltaTime);
+
+	SteppingWorld = nullptr;
+}
+
+bool FUxtFixedStepWorld::StepUntil(TFunctionRef<bool()> Condition, int32 MaxFrames)
+{
+	for (int32 Frame = 0; Frame < MaxFrames; ++Frame)
+	{
+		if (Condition())
+		{
+			return true;
+		}
+		Step();
+	}
+	return Condition();
+}
@@ -0,0 +1,74 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "UxtTestHandTracker.h"
+
+class UWorld;
+
+/**
+ * Isolated game world for tests, ticked manually with a fixed time step.
+ *
+ * The world is not registered with the engine, so it is never ticked or rendered by the engine loop.
+ * Frames run back to back as fast as possible instead of waiting for the editor frame rate,
+ * and every frame advances time by the same amount, so test results do not depend on frame timing.
+ *
+ * Each world has its own hand tracker, which is used instead of the registered hand tracker while the world is stepped.
+ * Worlds don't share state, so independent tests can step their worlds interleaved in the same process.
+ * Code that queries hands outside of Step() needs an FUxtHandTrackerScope with the world's hand tracker.
+ *
+ * Stepping changes the global frame counter and application time, so only one world can be stepped at a time, on the game thread.
+ * The world is rooted, so it is not garbage collected until it is destroyed.
+ *
+ * Usage:
+ *   FUxtFixedStepWorld StepWorld;
+ *   UWorld* World = StepWorld.Create();
+ *   // Spawn actors ...
+ *   StepWorld.Step(10);
+ *   // Test results ...
+ *   StepWorld.Destroy();
+ */
+class FUxtFixedStepWorld
+{
+public:
+
+	~FUxtFixedStepWorld();
+
+	/** Create a new world and begin play. Destroys the previous world. */
+	UWorld* Create(float InDeltaSeconds = 1.0f / 60.0f);
+
+	/** End play and destroy the world. Actors are garbage collected with the next collection. */
+	void Destroy();
+
+	/**
+	 * Tick the world for the given number of frames.
+	 * Application time is set to the simulated time while stepping, so hand sample times advance with the fixed step.
+	 */
+	void Step(int32 NumFrames = 1);
+
+	/** Tick the world until the condition is true, at most MaxFrames times. Returns true if the condition was met. */
+	bool StepUntil(TFunctionRef<bool()> Condition, int32 MaxFrames);
+
+	UWorld* GetWorld() const { return World; }
+
+	/** Hand tracker of this world, only used while the world is stepped. */
+	FUxtTestHandTracker& GetHandTracker() { return HandTracker; }
+
+	float GetDeltaSeconds() const { return DeltaSeconds; }
+
+	/** Number of frames stepped since the world was created. */
+	int64 GetFrameCount() const { return FrameCount; }
+
+private:
+
+	UWorld* World = nullptr;
+	FUxtTestHandTracker HandTracker;
+	float DeltaSeconds = 1.0f / 60.0f;
+	int64 FrameCount = 0;
+
+	/** World that is currently being stepped, stepping modifies global state and must not overlap. */
+	static FUxtFixedStepWorld* SteppingWorld;
+};
@@ -49,3 +49,14 @@ bool FUxtTestHandTracker::GetIsSelectPressed(EControllerHand Hand, bool& OutIsSe
 
 	return false;
 }
+
+bool FUxtTestHandTracker::GetSampleTime(EControllerHand Hand, double& OutTime) const
+{
+	if (bIsTracked && TestSampleTime >= 0.0)
+	{
+		OutTime = TestSampleTime;
+		return true;
+	}
+
+	return false;
+}
@@ -17,6 +17,7 @@ public:
 	virtual bool GetPointerPose(EControllerHand Hand, FQuat& OutOrientation, FVector& OutPosition) const override;
 	virtual bool GetIsGrabbing(EControllerHand Hand, bool& OutIsGrabbing) const override;
 	virtual bool GetIsSelectPressed(EControllerHand Hand, bool& OutIsSelectPressed) const override;
+	virtual bool GetSampleTime(EControllerHand Hand, double& OutTime) const override;
 
 	/** Enable hand tracking. */
 	bool bIsTracked = true;
@@ -34,5 +35,8 @@ public:
 
 	/** Enable select state. */
 	bool bIsSelectPressed = false;
+
+	/** Time stamp of the current sample, frame time is used instead if negative. */
+	double TestSampleTime = -1.0;
 };
 
@@ -13,12 +13,25 @@ public class UXToolsTests : ModuleRules
         bEnableUndefinedIdentifierWarnings = false;
 	
 		
-		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "LiveLinkInterface", "UXTools" });
+		PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "HeadMountedDisplay", "LiveLinkInterface", "RenderCore", "UXTools" });
 
 		if (Target.bBuildEditor)
         {
             PrivateDependencyModuleNames.Add("UnrealEd");
         }
+
+		// Input simulation and the UX Tools editor module are only available in the Windows editor.
+		if (Target.Platform == UnrealTargetPlatform.Win64 && Target.bBuildEditor == true)
+		{
+			PrivateDependencyModuleNames.AddRange(new string[] { "UXToolsEditor", "UXToolsInputSimulation" });
+			PrivateDefinitions.Add("WITH_INPUT_SIMULATION=1");
+			PrivateDefinitions.Add("WITH_UXTOOLS_EDITOR=1");
+		}
+		else
+		{
+			PrivateDefinitions.Add("WITH_INPUT_SIMULATION=0");
+			PrivateDefinitions.Add("WITH_UXTOOLS_EDITOR=0");
+		}
 	}
 }
 